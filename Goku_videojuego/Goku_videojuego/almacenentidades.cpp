@@ -0,0 +1,563 @@
+#include "almacenentidades.h"
+#include "mundocolisiones.h"
+#include "perfilador.h"
+#include <limits>
+#include <stdexcept>  // Excepciones estándar
+
+#if defined(__AVX2__)
+#include <immintrin.h>   // Integración de 8 entradas por vuelta
+#elif defined(__SSE2__)
+#include <emmintrin.h>   // Integración de 4 entradas por vuelta
+#endif
+
+/**
+@brief Constructor privado de un almacén.
+
+Elige la fase del bucle según la clase (las explosiones se mueven con los proyectiles, el resto
+con el escenario) y reserva espacio para que las altas normalmente no pidan memoria.
+
+@param clase Clase de entidad que guardará el almacén.
+*/
+AlmacenEntidades::AlmacenEntidades(Clase clase)
+    : fase(clase == ClaseProyectil ? BucleJuego::FaseProyectiles : BucleJuego::FaseEscenario),
+    nombre(clase == ClaseObstaculo ? "avanzarObstaculos"
+           : clase == ClaseProyectil ? "avanzarProyectiles" : "avanzarPociones")
+{
+    const std::size_t reserva = 256;
+    xs.reserve(reserva);
+    ys.reserve(reserva);
+    vxs.reserve(reserva);
+    vys.reserve(reserva);
+    ays.reserve(reserva);
+    limIzq.reserve(reserva);
+    limDer.reserve(reserva);
+    limAbajo.reserve(reserva);
+    acumMov.reserve(reserva);
+    periodoMov.reserve(reserva);
+    acumAnim.reserve(reserva);
+    periodoAnim.reserve(reserva);
+    indicesFrame.reserve(reserva);
+    totalFrames.reserve(reserva);
+    moviendo.reserve(reserva);
+    animando.reserve(reserva);
+    ciclicas.reserve(reserva);
+    cambios.reserve(reserva);
+    representantes.reserve(reserva);
+    hojas.reserve(reserva);
+    cuerpos.reserve(reserva);
+    alMoverse.reserve(reserva);
+    alSalir.reserve(reserva);
+    libres.reserve(reserva);
+}
+
+/**
+@brief Destructor. Quita del bucle la tarea del almacén si llegó a crearse.
+*/
+AlmacenEntidades::~AlmacenEntidades()
+{
+    delete tarea;
+    tarea = nullptr;
+}
+
+/**
+@brief Devuelve el almacén de una clase de entidad.
+
+@param clase Clase pedida.
+@return Puntero al almacén único de esa clase.
+
+@throw std::invalid_argument Si la clase no es válida.
+*/
+AlmacenEntidades* AlmacenEntidades::de(Clase clase)
+{
+    static AlmacenEntidades obstaculos(ClaseObstaculo);
+    static AlmacenEntidades proyectiles(ClaseProyectil);
+    static AlmacenEntidades pociones(ClasePocion);
+
+    switch (clase) {
+    case ClaseObstaculo: return &obstaculos;
+    case ClaseProyectil: return &proyectiles;
+    case ClasePocion:    return &pociones;
+    default: break;
+    }
+    throw std::invalid_argument("AlmacenEntidades::de - clase de entidad no válida.");
+}
+
+/**
+@brief Registra una entidad en el almacén.
+
+La entrada nace detenida en la posición actual del representante, sin límites. La primera
+alta crea la tarea del almacén en el bucle central.
+
+@param representante Item de la escena que muestra la entidad. No puede ser nulo.
+@param frames Imágenes de la animación (las del dueño de la entidad); puede ser nulo si no se anima.
+@param cuerpo Cuerpo en el `MundoColisiones` que se actualiza al sincronizar, o -1 si no tiene.
+@return Identificador de la entrada, a usar en el resto de los métodos.
+
+@throw std::invalid_argument Si el representante es nulo.
+*/
+int AlmacenEntidades::agregar(QGraphicsPixmapItem* representante, const QVector<QPixmap>* frames, int cuerpo)
+{
+    if (!representante)
+        throw std::invalid_argument("AlmacenEntidades::agregar - el representante no puede ser nulo.");
+
+    if (!tarea) {
+        tarea = new TareaBucle(fase, [this]() { avanzar(BucleJuego::pasoMs); }, nullptr, nombre);
+        tarea->iniciar(BucleJuego::pasoMs);
+    }
+
+    const float infinito = std::numeric_limits<float>::infinity();
+    int id;
+    if (!libres.empty()) {
+        id = libres.back();
+        libres.pop_back();
+    } else {
+        id = static_cast<int>(xs.size());
+        xs.emplace_back();
+        ys.emplace_back();
+        vxs.emplace_back();
+        vys.emplace_back();
+        ays.emplace_back();
+        limIzq.emplace_back();
+        limDer.emplace_back();
+        limAbajo.emplace_back();
+        acumMov.emplace_back();
+        periodoMov.emplace_back();
+        acumAnim.emplace_back();
+        periodoAnim.emplace_back();
+        indicesFrame.emplace_back();
+        totalFrames.emplace_back();
+        moviendo.emplace_back();
+        animando.emplace_back();
+        ciclicas.emplace_back();
+        cambios.emplace_back();
+        representantes.emplace_back();
+        hojas.emplace_back();
+        cuerpos.emplace_back();
+        alMoverse.emplace_back();
+        alSalir.emplace_back();
+    }
+
+    xs[id] = static_cast<float>(representante->x());
+    ys[id] = static_cast<float>(representante->y());
+    vxs[id] = vys[id] = ays[id] = 0;
+    limIzq[id] = -infinito;
+    limDer[id] = infinito;
+    limAbajo[id] = infinito;
+    acumMov[id] = acumAnim[id] = 0;
+    periodoMov[id] = periodoAnim[id] = BucleJuego::pasoMs;
+    indicesFrame[id] = totalFrames[id] = 0;
+    moviendo[id] = animando[id] = ciclicas[id] = cambios[id] = 0;
+    representantes[id] = representante;
+    hojas[id] = frames;
+    cuerpos[id] = cuerpo;
+    alMoverse[id] = nullptr;
+    alSalir[id] = nullptr;
+
+    ++activas;
+    return id;
+}
+
+/**
+@brief Quita una entrada del almacén. Su identificador queda libre para reutilizarse.
+
+Se puede llamar desde un aviso: la entrada deja de recorrerse en el mismo paso.
+
+@param entrada Identificador devuelto por `agregar()`. Los valores negativos se ignoran.
+*/
+void AlmacenEntidades::quitar(int entrada)
+{
+    if (entrada < 0 || entrada >= static_cast<int>(xs.size()) || !representantes[entrada]) return;
+
+    moviendo[entrada] = animando[entrada] = cambios[entrada] = 0;
+    representantes[entrada] = nullptr;
+    hojas[entrada] = nullptr;
+    alMoverse[entrada] = nullptr;
+    alSalir[entrada] = nullptr;
+
+    libres.push_back(entrada);
+    --activas;
+}
+
+/**
+@brief Define qué hacer cada vez que la entrada se mueve.
+
+Se llama después de sincronizar al representante, por lo que puede consultar colisiones con él.
+
+@param entrada Entrada del almacén.
+@param accion Callback; vacío para no avisar.
+*/
+void AlmacenEntidades::setAlMoverse(int entrada, std::function<void()> accion)
+{
+    comprobar(entrada);
+    alMoverse[entrada] = std::move(accion);
+}
+
+/**
+@brief Define qué hacer cuando la entrada sale de sus límites.
+
+Si el callback no la detiene ni la recoloca, se vuelve a llamar en el siguiente tick. Sin
+callback, la entrada se detiene y su representante se oculta.
+
+@param entrada Entrada del almacén.
+@param accion Callback; vacío para el comportamiento por omisión.
+*/
+void AlmacenEntidades::setAlSalir(int entrada, std::function<void()> accion)
+{
+    comprobar(entrada);
+    alSalir[entrada] = std::move(accion);
+}
+
+/**
+@brief Coloca la entrada en una posición, sin esperar al siguiente paso.
+
+El representante y su cuerpo de colisión se actualizan en el momento.
+
+@param entrada Entrada del almacén.
+@param x Coordenada X en la escena.
+@param y Coordenada Y en la escena.
+*/
+void AlmacenEntidades::colocar(int entrada, qreal x, qreal y)
+{
+    comprobar(entrada);
+    xs[entrada] = static_cast<float>(x);
+    ys[entrada] = static_cast<float>(y);
+
+    representantes[entrada]->setPos(xs[entrada], ys[entrada]);
+    MundoColisiones::instancia()->actualizar(cuerpos[entrada]);
+}
+
+/**
+@brief Pone la entrada en movimiento.
+
+Cada `periodoMs` la posición avanza `velocidad` y después la velocidad vertical aumenta
+`aceleracionY` (la gravedad de las trayectorias parabólicas). El reloj de la entrada empieza
+de cero, como al iniciar una `TareaBucle`.
+
+@param entrada Entrada del almacén.
+@param velocidad Desplazamiento por tick, en píxeles.
+@param aceleracionY Cambio de la velocidad vertical por tick; 0 para movimiento uniforme.
+@param periodoMs Milisegundos entre ticks; como mínimo un paso del bucle.
+*/
+void AlmacenEntidades::mover(int entrada, QPointF velocidad, qreal aceleracionY, int periodoMs)
+{
+    comprobar(entrada);
+    vxs[entrada] = static_cast<float>(velocidad.x());
+    vys[entrada] = static_cast<float>(velocidad.y());
+    ays[entrada] = static_cast<float>(aceleracionY);
+    periodoMov[entrada] = qMax(periodoMs, BucleJuego::pasoMs);
+    acumMov[entrada] = 0;
+    moviendo[entrada] = 1;
+}
+
+/**
+@brief Empieza a animar la entrada desde el primer frame.
+
+@param entrada Entrada del almacén.
+@param periodoMs Milisegundos entre frames; como mínimo un paso del bucle.
+@param ciclica `true` para volver al primer frame al terminar; `false` para quedarse en el último.
+
+@note Sin frames (hoja nula o vacía) no hace nada.
+*/
+void AlmacenEntidades::animar(int entrada, int periodoMs, bool ciclica)
+{
+    comprobar(entrada);
+    const QVector<QPixmap>* hoja = hojas[entrada];
+    if (!hoja || hoja->isEmpty()) return;
+
+    indicesFrame[entrada] = 0;
+    totalFrames[entrada] = static_cast<qint16>(qMin<int>(hoja->size(), std::numeric_limits<qint16>::max()));
+    periodoAnim[entrada] = qMax(periodoMs, BucleJuego::pasoMs);
+    acumAnim[entrada] = 0;
+    ciclicas[entrada] = ciclica ? 1 : 0;
+    animando[entrada] = 1;
+}
+
+/**
+@brief Define la zona dentro de la cual puede moverse la entrada.
+
+La entrada sale cuando su esquina superior izquierda queda a la izquierda de `izquierda`, a la
+derecha de `derecha` o a la altura de `abajo` o más abajo. Los límites solo se revisan en los ticks
+en que se mueve.
+
+@param entrada Entrada del almacén.
+@param izquierda Menor X permitida.
+@param derecha Mayor X permitida.
+@param abajo Y a partir de la cual la entrada sale.
+*/
+void AlmacenEntidades::setLimites(int entrada, qreal izquierda, qreal derecha, qreal abajo)
+{
+    comprobar(entrada);
+    limIzq[entrada] = static_cast<float>(izquierda);
+    limDer[entrada] = static_cast<float>(derecha);
+    limAbajo[entrada] = static_cast<float>(abajo);
+}
+
+/**
+@brief Detiene el movimiento y la animación de la entrada. El representante no cambia.
+
+@param entrada Entrada del almacén.
+*/
+void AlmacenEntidades::detener(int entrada)
+{
+    comprobar(entrada);
+    moviendo[entrada] = animando[entrada] = 0;
+    acumMov[entrada] = acumAnim[entrada] = 0;
+}
+
+/**
+@brief Indica si la entrada está en movimiento.
+
+@param entrada Entrada del almacén.
+@return `true` desde `mover()` hasta que se detiene.
+*/
+bool AlmacenEntidades::enMovimiento(int entrada) const
+{
+    comprobar(entrada);
+    return moviendo[entrada] != 0;
+}
+
+/**
+@brief Devuelve la posición de la entrada según el almacén.
+
+@param entrada Entrada del almacén.
+@return Esquina superior izquierda en coordenadas de escena.
+*/
+QPointF AlmacenEntidades::posicion(int entrada) const
+{
+    comprobar(entrada);
+    return QPointF(xs[entrada], ys[entrada]);
+}
+
+/**
+@brief Ejecuta un paso del almacén. Lo llama su tarea del bucle cada `BucleJuego::pasoMs`.
+
+Cada entrada lleva sus propios relojes, así que los ticks ocurren en los mismos pasos que con una
+tarea por entidad:
+
+1. Movimiento y límites: `integrar()` recorre todas las entradas en bloques SIMD.
+2. Animación: avanza el frame de las que se animan y tienen tick.
+3. Sincronización de los representantes que cambiaron (`sincronizar()`).
+4. Avisos a los dueños (`avisar()`).
+
+@param ms Milisegundos simulados del paso.
+*/
+void AlmacenEntidades::avanzar(int ms)
+{
+    ZONA_PERFIL("AlmacenEntidades::avanzar");
+    const std::size_t n = xs.size();
+    if (n == 0) return;
+
+    quint8* cambio = cambios.data();
+
+    // 1. Movimiento y límites
+    integrar(ms, n);
+
+    // 2. Animación
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!animando[i]) continue;
+
+        acumAnim[i] += ms;
+        if (acumAnim[i] < periodoAnim[i]) continue;
+        acumAnim[i] -= periodoAnim[i];
+
+        if (indicesFrame[i] + 1 < totalFrames[i]) {
+            ++indicesFrame[i];
+            cambio[i] |= CambioFrame;
+        } else if (ciclicas[i]) {
+            indicesFrame[i] = 0;
+            cambio[i] |= CambioFrame;
+        } else {
+            animando[i] = 0;   // Se queda en el último frame
+        }
+    }
+
+    sincronizar(n);
+    avisar(n);
+}
+
+/**
+@brief Integra el movimiento de todas las entradas y rechaza las que salieron de sus límites.
+
+En un solo recorrido, para cada entrada: suma `ms` a su reloj si está en movimiento; si el reloj
+alcanzó el periodo, avanza la posición con su velocidad, suma la aceleración a la velocidad
+vertical (parabólico; en MRU es 0) y compara la posición nueva con sus límites. Escribe en
+`cambios` `CambioPosicion` y, si salió, `CambioSalida`.
+
+No hay ramas por entrada: las que no tienen tick suman cero. Se procesan 8 entradas por vuelta
+con AVX2, 4 con SSE2 (siempre disponible en x86-64) y el resto, o todo en otras arquitecturas,
+con el mismo cálculo escalar. Las tres versiones hacen las mismas sumas en el mismo orden (sin
+multiplicaciones), así que el resultado no depende de cuál se compiló y las repeticiones siguen
+siendo deterministas.
+
+@param ms Milisegundos simulados del paso.
+@param n Cantidad de entradas a recorrer.
+*/
+void AlmacenEntidades::integrar(int ms, std::size_t n)
+{
+    float* x = xs.data();
+    float* y = ys.data();
+    float* vy = vys.data();
+    const float* vx = vxs.data();
+    const float* ay = ays.data();
+    const float* izq = limIzq.data();
+    const float* der = limDer.data();
+    const float* abajo = limAbajo.data();
+    qint32* acum = acumMov.data();
+    const qint32* periodo = periodoMov.data();
+    const qint32* activa = moviendo.data();
+    quint8* cambio = cambios.data();
+
+    std::size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i paso8 = _mm256_set1_epi32(ms);
+    for (; i + 8 <= n; i += 8) {
+        // Reloj: activa vale 0 o 1, así que 0 - activa es la máscara de las que suman
+        const __m256i mov = _mm256_sub_epi32(_mm256_setzero_si256(), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(activa + i)));
+        const __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(periodo + i));
+        __m256i a = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(acum + i)), _mm256_and_si256(mov, paso8));
+        const __m256i toca = _mm256_xor_si256(_mm256_cmpgt_epi32(p, a), _mm256_set1_epi32(-1));   // a >= p
+        a = _mm256_sub_epi32(a, _mm256_and_si256(toca, p));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(acum + i), a);
+
+        // Integración
+        const __m256 k = _mm256_castsi256_ps(toca);
+        __m256 px = _mm256_loadu_ps(x + i);
+        __m256 py = _mm256_loadu_ps(y + i);
+        __m256 pvy = _mm256_loadu_ps(vy + i);
+        px = _mm256_add_ps(px, _mm256_and_ps(k, _mm256_loadu_ps(vx + i)));
+        py = _mm256_add_ps(py, _mm256_and_ps(k, pvy));
+        pvy = _mm256_add_ps(pvy, _mm256_and_ps(k, _mm256_loadu_ps(ay + i)));
+        _mm256_storeu_ps(x + i, px);
+        _mm256_storeu_ps(y + i, py);
+        _mm256_storeu_ps(vy + i, pvy);
+
+        // Rechazo por límites
+        const __m256 fuera = _mm256_or_ps(_mm256_or_ps(_mm256_cmp_ps(px, _mm256_loadu_ps(izq + i), _CMP_LT_OQ),
+                                                       _mm256_cmp_ps(px, _mm256_loadu_ps(der + i), _CMP_GT_OQ)),
+                                          _mm256_cmp_ps(py, _mm256_loadu_ps(abajo + i), _CMP_GE_OQ));
+
+        const int movidas = _mm256_movemask_ps(k);
+        const int salidas = _mm256_movemask_ps(_mm256_and_ps(k, fuera));
+        for (int j = 0; j < 8; ++j)
+            cambio[i + j] = static_cast<quint8>(((movidas >> j) & 1) * CambioPosicion | ((salidas >> j) & 1) * CambioSalida);
+    }
+#endif
+
+#if defined(__SSE2__)
+    const __m128i paso4 = _mm_set1_epi32(ms);
+    for (; i + 4 <= n; i += 4) {
+        const __m128i mov = _mm_sub_epi32(_mm_setzero_si128(), _mm_loadu_si128(reinterpret_cast<const __m128i*>(activa + i)));
+        const __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(periodo + i));
+        __m128i a = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(acum + i)), _mm_and_si128(mov, paso4));
+        const __m128i toca = _mm_xor_si128(_mm_cmplt_epi32(a, p), _mm_set1_epi32(-1));   // a >= p
+        a = _mm_sub_epi32(a, _mm_and_si128(toca, p));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(acum + i), a);
+
+        const __m128 k = _mm_castsi128_ps(toca);
+        __m128 px = _mm_loadu_ps(x + i);
+        __m128 py = _mm_loadu_ps(y + i);
+        __m128 pvy = _mm_loadu_ps(vy + i);
+        px = _mm_add_ps(px, _mm_and_ps(k, _mm_loadu_ps(vx + i)));
+        py = _mm_add_ps(py, _mm_and_ps(k, pvy));
+        pvy = _mm_add_ps(pvy, _mm_and_ps(k, _mm_loadu_ps(ay + i)));
+        _mm_storeu_ps(x + i, px);
+        _mm_storeu_ps(y + i, py);
+        _mm_storeu_ps(vy + i, pvy);
+
+        const __m128 fuera = _mm_or_ps(_mm_or_ps(_mm_cmplt_ps(px, _mm_loadu_ps(izq + i)),
+                                                 _mm_cmpgt_ps(px, _mm_loadu_ps(der + i))),
+                                       _mm_cmpge_ps(py, _mm_loadu_ps(abajo + i)));
+
+        const int movidas = _mm_movemask_ps(k);
+        const int salidas = _mm_movemask_ps(_mm_and_ps(k, fuera));
+        for (int j = 0; j < 4; ++j)
+            cambio[i + j] = static_cast<quint8>(((movidas >> j) & 1) * CambioPosicion | ((salidas >> j) & 1) * CambioSalida);
+    }
+#endif
+
+    // Resto de las entradas (o todas, sin SIMD)
+    for (; i < n; ++i) {
+        acum[i] += activa[i] ? ms : 0;
+        const bool toca = acum[i] >= periodo[i];
+        acum[i] -= toca ? periodo[i] : 0;
+
+        x[i] += toca ? vx[i] : 0.0f;
+        y[i] += toca ? vy[i] : 0.0f;
+        vy[i] += toca ? ay[i] : 0.0f;
+
+        const bool fuera = x[i] < izq[i] || x[i] > der[i] || y[i] >= abajo[i];
+        cambio[i] = static_cast<quint8>((toca ? CambioPosicion : 0) | (toca && fuera ? CambioSalida : 0));
+    }
+}
+
+/**
+@brief Copia a los representantes la posición y el frame de las entradas que cambiaron.
+
+También actualiza sus cuerpos en el `MundoColisiones`, para que las consultas de colisión del
+resto del paso vean la caja nueva.
+
+@param n Cantidad de entradas al comenzar el paso.
+*/
+void AlmacenEntidades::sincronizar(std::size_t n)
+{
+    MundoColisiones* mundo = MundoColisiones::instancia();
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const quint8 cambio = cambios[i];
+        if (!(cambio & (CambioPosicion | CambioFrame))) continue;
+
+        QGraphicsPixmapItem* representante = representantes[i];
+        if (cambio & CambioPosicion)
+            representante->setPos(xs[i], ys[i]);
+        if (cambio & CambioFrame)
+            representante->setPixmap((*hojas[i])[indicesFrame[i]]);
+
+        mundo->actualizar(cuerpos[i]);
+    }
+}
+
+/**
+@brief Llama a los avisos de las entradas que se movieron o salieron en este paso.
+
+Los callbacks pueden detener, recolocar, agregar o quitar entradas, incluso otras que todavía no
+se avisaron: por eso cada aviso se copia antes de llamarlo y se vuelve a mirar si la entrada sigue
+en movimiento.
+
+@param n Cantidad de entradas al comenzar el paso.
+*/
+void AlmacenEntidades::avisar(std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        const quint8 cambio = cambios[i];
+        if (!(cambio & (CambioPosicion | CambioSalida))) continue;
+
+        if ((cambio & CambioPosicion) && moviendo[i] && alMoverse[i]) {
+            const std::function<void()> accion = alMoverse[i];
+            accion();
+        }
+
+        if (!(cambio & CambioSalida) || !moviendo[i]) continue;
+
+        if (alSalir[i]) {
+            const std::function<void()> accion = alSalir[i];
+            accion();
+        } else {
+            detener(static_cast<int>(i));
+            representantes[i]->hide();
+        }
+    }
+}
+
+/**
+@brief Verifica que el identificador corresponda a una entrada en uso.
+
+@param entrada Identificador a revisar.
+
+@throw std::out_of_range Si no es una entrada válida.
+*/
+void AlmacenEntidades::comprobar(int entrada) const
+{
+    if (entrada < 0 || entrada >= static_cast<int>(xs.size()) || !representantes[entrada])
+        throw std::out_of_range("AlmacenEntidades - entrada fuera de rango.");
+}
@@ -0,0 +1,95 @@
+#ifndef ALMACENENTIDADES_H
+#define ALMACENENTIDADES_H
+
+#include <QGraphicsPixmapItem>
+#include <QPixmap>
+#include <QPointF>
+#include <QVector>
+#include <QtGlobal>
+#include <functional>
+#include <vector>
+#include "buclejuego.h"
+
+/**
+ * Almacén orientado a datos de las entidades que solo se desplazan y se animan: obstáculos,
+ * explosiones y pociones.
+ * Hay un almacén por clase de entidad. Posiciones, velocidades, relojes y frames se guardan
+ * en arreglos contiguos (estructura de arreglos) y una sola tarea del bucle los recorre en cada
+ * paso. Los items de la escena quedan como representantes: reciben setPos()/setPixmap() en un
+ * único recorrido al final del paso, y solo los que cambiaron.
+ */
+class AlmacenEntidades
+{
+public:
+    enum Clase {
+        ClaseObstaculo,     // Aves, montañas y rocas (FaseEscenario)
+        ClaseProyectil,     // Explosiones (FaseProyectiles)
+        ClasePocion,        // Pociones del nivel 2 (FaseEscenario)
+        NumClases
+    };
+
+    static AlmacenEntidades* de(Clase clase);
+
+    // frames: imágenes de la animación; deben vivir mientras exista la entrada (puede ser nulo)
+    int agregar(QGraphicsPixmapItem* representante, const QVector<QPixmap>* frames, int cuerpo = -1);
+    void quitar(int entrada);
+    void setAlMoverse(int entrada, std::function<void()> accion);   // Después de cada tick de movimiento
+    void setAlSalir(int entrada, std::function<void()> accion);     // Al cruzar los límites
+
+    void colocar(int entrada, qreal x, qreal y);                    // Inmediato, también en el representante
+    void mover(int entrada, QPointF velocidad, qreal aceleracionY, int periodoMs);   // Por tick
+    void animar(int entrada, int periodoMs, bool ciclica);          // Empieza desde el frame 0
+    void setLimites(int entrada, qreal izquierda, qreal derecha, qreal abajo);
+    void detener(int entrada);                                      // Deja de moverse y de animarse
+
+    bool enMovimiento(int entrada) const;
+    QPointF posicion(int entrada) const;
+    int cantidad() const { return activas; }
+
+    void avanzar(int ms);   // Un paso: movimiento, animación, límites, sincronización y avisos
+
+private:
+    explicit AlmacenEntidades(Clase clase);
+    ~AlmacenEntidades();
+
+    enum Cambio : quint8 {
+        CambioPosicion = 1,
+        CambioFrame = 2,
+        CambioSalida = 4
+    };
+
+    void comprobar(int entrada) const;
+    void integrar(int ms, std::size_t n);     // Movimiento y límites de todas las entradas, en SIMD
+    void sincronizar(std::size_t n);
+    void avisar(std::size_t n);
+
+    BucleJuego::Fase fase;
+    const char* nombre;
+    TareaBucle* tarea = nullptr;              // Se crea con la primera entrada
+
+    // Datos que se recorren en cada paso, una posición por entrada
+    std::vector<float> xs, ys;
+    std::vector<float> vxs, vys, ays;         // Velocidad y aceleración vertical por tick
+    std::vector<float> limIzq, limDer, limAbajo;
+    std::vector<qint32> acumMov, periodoMov;
+    std::vector<qint32> acumAnim, periodoAnim;
+    std::vector<qint16> indicesFrame, totalFrames;
+    std::vector<qint32> moviendo;             // 0 o 1; del ancho de los relojes para integrar en SIMD
+    std::vector<quint8> animando, ciclicas, cambios;
+
+    // Datos que solo se tocan al sincronizar o al avisar
+    std::vector<QGraphicsPixmapItem*> representantes;
+    std::vector<const QVector<QPixmap>*> hojas;
+    std::vector<int> cuerpos;
+    std::vector<std::function<void()>> alMoverse;
+    std::vector<std::function<void()>> alSalir;
+
+    std::vector<int> libres;                  // Entradas reutilizables
+    int activas = 0;
+
+    // Bloqueamos copia y asignación
+    AlmacenEntidades(const AlmacenEntidades&) = delete;
+    AlmacenEntidades& operator=(const AlmacenEntidades&) = delete;
+};
+
+#endif // ALMACENENTIDADES_H
@@ -0,0 +1,160 @@
+#include "arenanivel.h"
+#include <QLoggingCategory>
+#include <new>
+
+// Cierre y liberación de cada arena; se ven con QT_LOGGING_RULES="goku.arena.debug=true"
+Q_LOGGING_CATEGORY(registroArena, "goku.arena", QtInfoMsg)
+
+// Arena del nivel en curso (nullptr fuera de los niveles)
+ArenaNivel* ArenaNivel::abierta = nullptr;
+// Bloques libres que reutilizará la próxima arena
+std::vector<char*> ArenaNivel::reciclados;
+
+namespace {
+
+// Cabecera delante de cada objeto: indica a qué arena pertenece (nullptr: montículo)
+struct alignas(16) Cabecera {
+    ArenaNivel* arena;
+};
+
+const std::size_t alineacion = 16;
+
+std::size_t redondear(std::size_t tamano)
+{
+    return (tamano + alineacion - 1) & ~(alineacion - 1);
+}
+
+} // namespace
+
+/**
+@brief Abre la arena del nivel que se va a construir.
+
+Si quedaba una arena abierta (un nivel que no se cerró), se cierra primero.
+*/
+void ArenaNivel::abrir()
+{
+    if (abierta) cerrar();
+    abierta = new ArenaNivel();
+}
+
+/**
+@brief Cierra la arena del nivel actual.
+
+Las reservas siguientes vuelven al montículo. Si todos los objetos del nivel ya se destruyeron,
+la arena se libera ahora; si alguno sigue vivo (por ejemplo, con un `deleteLater` pendiente),
+se libera cuando se destruya el último.
+*/
+void ArenaNivel::cerrar()
+{
+    ArenaNivel* arena = abierta;
+    abierta = nullptr;
+    if (!arena) return;
+
+    arena->cerrada = true;
+    if (arena->vivos == 0)
+        delete arena;
+    else
+        qCDebug(registroArena) << "ArenaNivel: quedan" << arena->vivos << "objetos; se libera al destruirse el último";
+}
+
+/**
+@brief Reserva memoria para una entidad del nivel.
+
+@param tamano Bytes pedidos por `operator new`.
+@return Memoria alineada a 16 bytes, dentro de la arena abierta o del montículo.
+
+@throw std::bad_alloc Si no hay memoria.
+*/
+void* ArenaNivel::reservar(std::size_t tamano)
+{
+    Cabecera* cabecera = nullptr;
+    if (abierta) {
+        cabecera = static_cast<Cabecera*>(abierta->tomar(sizeof(Cabecera) + tamano));
+        ++abierta->vivos;
+    } else {
+        cabecera = static_cast<Cabecera*>(::operator new(sizeof(Cabecera) + tamano));
+    }
+
+    cabecera->arena = abierta;
+    return cabecera + 1;
+}
+
+/**
+@brief Devuelve la memoria de una entidad destruida.
+
+Dentro de una arena solo descuenta un objeto vivo; la memoria se recupera toda junta cuando la
+arena se cierra.
+
+@param bloque Puntero devuelto por `reservar`, o `nullptr`.
+*/
+void ArenaNivel::devolver(void* bloque)
+{
+    if (!bloque) return;
+
+    Cabecera* cabecera = static_cast<Cabecera*>(bloque) - 1;
+    ArenaNivel* arena = cabecera->arena;
+    if (!arena) {
+        ::operator delete(cabecera);
+        return;
+    }
+
+    if (--arena->vivos == 0 && arena->cerrada)
+        delete arena;
+}
+
+/**
+@brief Avanza el puntero de la arena, pidiendo un bloque nuevo si el actual no alcanza.
+
+Las reservas de más de un cuarto de bloque van a un bloque propio, para no desperdiciar el resto
+del bloque en curso.
+
+@param tamano Bytes a reservar (incluida la cabecera).
+@return Memoria alineada a 16 bytes.
+*/
+void* ArenaNivel::tomar(std::size_t tamano)
+{
+    tamano = redondear(tamano);
+    bytesUsados += tamano;
+
+    if (tamano > tamBloque / 4) {
+        char* grande = static_cast<char*>(::operator new(tamano));
+        grandes.push_back(grande);
+        return grande;
+    }
+
+    if (!cursor || static_cast<std::size_t>(fin - cursor) < tamano) {
+        char* bloque = nullptr;
+        if (!reciclados.empty()) {
+            bloque = reciclados.back();
+            reciclados.pop_back();
+        } else {
+            bloque = static_cast<char*>(::operator new(tamBloque));
+        }
+        bloques.push_back(bloque);
+        cursor = bloque;
+        fin = bloque + tamBloque;
+    }
+
+    void* resultado = cursor;
+    cursor += tamano;
+    return resultado;
+}
+
+/**
+@brief Libera la arena completa: los bloques normales se reciclan y los grandes vuelven al montículo.
+*/
+ArenaNivel::~ArenaNivel()
+{
+    qCDebug(registroArena) << "ArenaNivel: liberando" << bytesUsados / 1024 << "KB en" << bloques.size()
+                           << "bloques y" << grandes.size() << "reservas grandes";
+
+    for (char* bloque : bloques) {
+        if (static_cast<int>(reciclados.size()) < maxReciclados)
+            reciclados.push_back(bloque);
+        else
+            ::operator delete(bloque);
+    }
+
+    for (char* grande : grandes)
+        ::operator delete(grande);
+}
@@ -0,0 +1,69 @@
+#ifndef ARENANIVEL_H
+#define ARENANIVEL_H
+
+#include <QGraphicsPixmapItem>
+#include <cstddef>
+#include <vector>
+
+/**
+ * Arena de memoria de un nivel.
+ * Las entidades del nivel (obstáculos, carro, explosiones, robot, pociones, Goku y los items de
+ * nubes, fondos y sprites) se reservan avanzando un puntero dentro de bloques de `tamBloque`
+ * bytes. Su `delete` no devuelve nada al montículo: solo descuenta un objeto vivo. Cuando el
+ * nivel se cierra y ya no queda ningún objeto vivo, todos los bloques se liberan de una vez
+ * y se reciclan para el nivel siguiente, sin fragmentar el montículo entre partidas.
+ *
+ * Los destructores se siguen ejecutando (Qt necesita quitar items de la escena y tareas del
+ * bucle); lo que se vuelve constante es la liberación de la memoria.
+ */
+class ArenaNivel
+{
+public:
+    static const std::size_t tamBloque = 64 * 1024;
+    static const int maxReciclados = 64;        // Bloques que se guardan entre niveles (4 MB)
+
+    static void abrir();                        // Arena nueva para el nivel que se va a construir
+    static void cerrar();                       // El nivel terminó; se libera al morir su último objeto
+
+    static void* reservar(std::size_t tamano);  // Sin arena abierta, usa el montículo
+    static void devolver(void* bloque);
+
+private:
+    ArenaNivel() = default;
+    ~ArenaNivel();
+
+    void* tomar(std::size_t tamano);
+
+    std::vector<char*> bloques;                 // Bloques de tamBloque
+    std::vector<char*> grandes;                 // Reservas que no entran en un bloque
+    char* cursor = nullptr;
+    char* fin = nullptr;
+    int vivos = 0;
+    std::size_t bytesUsados = 0;
+    bool cerrada = false;
+
+    static ArenaNivel* abierta;
+    static std::vector<char*> reciclados;
+
+    // Bloqueamos copia y asignación
+    ArenaNivel(const ArenaNivel&) = delete;
+    ArenaNivel& operator=(const ArenaNivel&) = delete;
+};
+
+// Hace que una clase (y sus derivadas) se reserve en la arena del nivel abierto
+#define ENTIDAD_DE_NIVEL \
+    static void* operator new(std::size_t tamano) { return ArenaNivel::reservar(tamano); } \
+    static void operator delete(void* bloque) { ArenaNivel::devolver(bloque); }
+
+/**
+ * QGraphicsPixmapItem reservado en la arena del nivel, para nubes, fondos y sprites de las
+ * entidades. Se puede borrar con delete o con QGraphicsScene::clear() como cualquier item.
+ */
+class PixmapNivel : public QGraphicsPixmapItem
+{
+public:
+    using QGraphicsPixmapItem::QGraphicsPixmapItem;
+    ENTIDAD_DE_NIVEL
+};
+
+#endif // ARENANIVEL_H
@@ -0,0 +1,55 @@
+#include "azarjuego.h"
+#include <QDebug>
+#include <QLoggingCategory>
+
+// Semillas de cada nivel; se ven con QT_LOGGING_RULES="goku.azar.debug=true"
+Q_LOGGING_CATEGORY(registroAzar, "goku.azar", QtInfoMsg)
+
+// Semilla con la que arranca el juego si nadie llama a sembrar()
+quint32 AzarJuego::semilla = QRandomGenerator::global()->generate();
+QRandomGenerator AzarJuego::azar(AzarJuego::semilla);
+
+/**
+@brief Devuelve el generador del nivel en curso.
+
+@return Puntero al generador sembrado; es válido durante toda la ejecución.
+*/
+QRandomGenerator* AzarJuego::generador()
+{
+    return &azar;
+}
+
+/**
+@brief Reinicia el generador con una semilla concreta.
+
+Se llama al comenzar cada nivel, antes de construirlo, para que la generación del nivel dependa
+solo de la semilla y de las teclas recibidas.
+
+@param nuevaSemilla Semilla del nivel.
+*/
+void AzarJuego::sembrar(quint32 nuevaSemilla)
+{
+    semilla = nuevaSemilla;
+    azar.seed(nuevaSemilla);
+    qCDebug(registroAzar) << "AzarJuego: semilla" << nuevaSemilla;
+}
+
+/**
+@brief Obtiene una semilla imprevisible para una partida normal.
+
+@return Semilla tomada del generador global del sistema.
+*/
+quint32 AzarJuego::semillaNueva()
+{
+    return QRandomGenerator::global()->generate();
+}
+
+/**
+@brief Devuelve la última semilla con la que se sembró el generador.
+
+@return Semilla actual.
+*/
+quint32 AzarJuego::getSemilla()
+{
+    return semilla;
+}
@@ -0,0 +1,29 @@
+#ifndef AZARJUEGO_H
+#define AZARJUEGO_H
+
+#include <QRandomGenerator>
+#include <QtGlobal>
+
+/**
+ * Generador de números aleatorios de la partida.
+ * Todo lo que sortea el nivel (obstáculos, pociones, robots, nubes) sale de aquí en lugar de
+ * QRandomGenerator::global(). Al sembrarlo con la misma semilla al inicio de un nivel, el nivel
+ * se genera igual; junto con las teclas grabadas permite repetir una partida paso a paso.
+ */
+class AzarJuego
+{
+public:
+    static QRandomGenerator* generador();    // Generador sembrado del nivel en curso
+
+    static void sembrar(quint32 semilla);    // Reinicia la secuencia
+    static quint32 semillaNueva();           // Semilla aleatoria de verdad (no reproducible)
+    static quint32 getSemilla();             // Última semilla usada
+
+private:
+    static QRandomGenerator azar;
+    static quint32 semilla;
+
+    AzarJuego() = delete;
+};
+
+#endif // AZARJUEGO_H
@@ -0,0 +1,21 @@
+# Mediciones de los caminos calientes del juego con Google Benchmark.
+# Los resultados en JSON se comparan entre commits para detectar regresiones de costo por frame:
+#   ./benchmarks --benchmark_out=antes.json --benchmark_out_format=json
+#   compare.py benchmarks antes.json despues.json   (tools/compare.py de Google Benchmark)
+
+TARGET = benchmarks
+TEMPLATE = app
+
+CONFIG += console
+CONFIG -= app_bundle
+
+include(../nucleo.pri)
+
+LIBS += -lbenchmark -lpthread
+
+SOURCES += \
+    colisiones.cpp \
+    escenario.cpp \
+    main.cpp \
+    niveles.cpp \
+    sprites.cpp
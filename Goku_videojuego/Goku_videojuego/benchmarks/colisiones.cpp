@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+
+#include "mundocolisiones.h"
+#include "tipoentidad.h"
+#include <QGraphicsRectItem>
+#include <QGraphicsScene>
+#include <QRandomGenerator>
+#include <vector>
+
+/*
+ * Detección de colisiones con N entidades repartidas en la escena del nivel 1.
+ * "CollidingItems" es el camino original: collidingItems() sobre la escena y filtro por la
+ * etiqueta del item. "Mundo" es la consulta a MundoColisiones que usan hoy Goku1 y Goku2.
+ */
+
+namespace {
+
+const int claveTipo = 0;   // data() del item con su TipoEntidad, como las etiquetas originales
+
+// Escena de 1536*4 x 784 con N cajas del tamaño de un obstáculo, en posiciones fijas
+struct EscenaPrueba {
+    QGraphicsScene escena;
+    QGraphicsRectItem* sonda = nullptr;
+    std::vector<QGraphicsRectItem*> items;
+
+    explicit EscenaPrueba(int cantidad)
+    {
+        escena.setSceneRect(0, 0, 1536 * 4, 784);
+        QRandomGenerator azar(1234);
+
+        for (int i = 0; i < cantidad; ++i) {
+            auto* item = escena.addRect(0, 0, 80, 80);
+            item->setPos(azar.bounded(0, 1536 * 4 - 80), azar.bounded(0, 784 - 80));
+            item->setData(claveTipo, static_cast<uint>(i % 2 == 0 ? EntidadObstaculo : EntidadPocion));
+            items.push_back(item);
+        }
+
+        // Goku en la zona donde más se juega
+        sonda = escena.addRect(0, 0, 100, 120);
+        sonda->setPos(700, 400);
+    }
+};
+
+} // namespace
+
+static void BM_CollidingItems(benchmark::State& estado)
+{
+    EscenaPrueba prueba(static_cast<int>(estado.range(0)));
+
+    for (auto _ : estado) {
+        int choques = 0;
+        for (QGraphicsItem* item : prueba.sonda->collidingItems()) {
+            if (item->data(claveTipo).toUInt() == EntidadObstaculo)
+                ++choques;
+        }
+        benchmark::DoNotOptimize(choques);
+    }
+    estado.SetComplexityN(estado.range(0));
+}
+BENCHMARK(BM_CollidingItems)->RangeMultiplier(10)->Range(10, 10000)->Complexity();
+
+static void BM_MundoColisiones(benchmark::State& estado)
+{
+    EscenaPrueba prueba(static_cast<int>(estado.range(0)));
+    MundoColisiones* mundo = MundoColisiones::instancia();
+
+    std::vector<int> cuerpos;
+    cuerpos.reserve(prueba.items.size());
+    for (QGraphicsRectItem* item : prueba.items)
+        cuerpos.push_back(mundo->agregar(item, item->data(claveTipo).toUInt(), EntidadNinguna));
+    const int cuerpoSonda = mundo->agregar(prueba.sonda, EntidadJugador, EntidadObstaculo);
+
+    for (auto _ : estado) {
+        int choques = 0;
+        mundo->consultar(prueba.sonda->sceneBoundingRect(), mundo->mascara(cuerpoSonda), [&](int id) {
+            if (prueba.sonda->collidesWithItem(mundo->item(id)))
+                ++choques;
+            return true;
+        }, cuerpoSonda);
+        benchmark::DoNotOptimize(choques);
+    }
+    estado.SetComplexityN(estado.range(0));
+
+    mundo->quitar(cuerpoSonda);
+    for (int cuerpo : cuerpos)
+        mundo->quitar(cuerpo);
+}
+BENCHMARK(BM_MundoColisiones)->RangeMultiplier(10)->Range(10, 10000)->Complexity();
@@ -0,0 +1,163 @@
+#include <benchmark/benchmark.h>
+
+#include "arenanivel.h"
+#include "buclejuego.h"
+#include "capanubes.h"
+#include "explosion.h"
+#include "obstaculo.h"
+#include "pocion.h"
+#include "spritecache.h"
+#include <QCoreApplication>
+#include <QGraphicsScene>
+#include <QRandomGenerator>
+#include <vector>
+
+/*
+ * Movimiento del escenario con N elementos.
+ * Las nubes se miden con CapaNubes::avanzar, que es todo lo que hace Nivel::moverNubes en cada
+ * tick. Las pociones y las aves se miden con el bucle central, que recorre sus almacenes de
+ * entidades: 20 pasos de 5 ms son un tick de 100 ms de cada poción (caída y frame) y 12 pasos
+ * son un tick de 60 ms de cada ave. Las explosiones (mitad parabólicas, mitad MRU) se miden con
+ * 6 pasos, un tick de 30 ms del integrador de proyectiles.
+ */
+
+static void BM_MoverNubes(benchmark::State& estado)
+{
+    const int cantidad = static_cast<int>(estado.range(0));
+    SpriteCache* cache = SpriteCache::instancia();
+    const QPixmap nube = cache->hoja(":/images/nube.png");
+
+    QVector<QPixmap> escalas;
+    for (int j = 1; j <= 3; ++j)
+        escalas.append(cache->escalado(nube, nube.width() * j * 0.05f, nube.height() * j * 0.05f));
+
+    QGraphicsScene escena;
+    escena.setSceneRect(0, 0, 1536 * 4, 784);
+
+    CapaNubes* capa = new CapaNubes(escalas, escena.width());
+    escena.addItem(capa);
+
+    QRandomGenerator azar(1234);
+    for (int i = 0; i < cantidad; ++i)
+        capa->agregar(azar.bounded(0, 1536 * 4 - 200), azar.bounded(0, 80), i % 3);
+
+    for (auto _ : estado)
+        capa->avanzar(2);
+
+    estado.SetItemsProcessed(estado.iterations() * cantidad);
+    estado.SetComplexityN(cantidad);
+    // La escena elimina la capa al destruirse
+}
+BENCHMARK(BM_MoverNubes)->RangeMultiplier(4)->Range(16, 16384)->Complexity();
+
+static void BM_MoverPociones(benchmark::State& estado)
+{
+    const int cantidad = static_cast<int>(estado.range(0));
+    const QVector<QPixmap> frames = SpriteCache::instancia()->frames(":/images/pocion.png", 65, 64, 6);
+    BucleJuego* bucle = BucleJuego::instancia();
+
+    QGraphicsScene escena;
+    escena.setSceneRect(0, 0, 1536, 784);
+
+    ArenaNivel::abrir();
+    std::vector<Pocion*> pociones;
+    pociones.reserve(cantidad);
+    for (int i = 0; i < cantidad; ++i) {
+        Pocion* pocion = new Pocion(frames, i / 7, i % 7, 7);   // Misma grilla que Nivel2
+        escena.addItem(pocion);
+        pociones.push_back(pocion);
+    }
+
+    const int pasosPorTick = 100 / BucleJuego::pasoMs;
+    for (auto _ : estado)
+        bucle->avanzar(pasosPorTick);
+
+    estado.SetItemsProcessed(estado.iterations() * cantidad);
+    estado.SetComplexityN(cantidad);
+
+    for (Pocion* pocion : pociones) {
+        escena.removeItem(pocion);
+        delete pocion;
+    }
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    ArenaNivel::cerrar();
+}
+BENCHMARK(BM_MoverPociones)->RangeMultiplier(4)->Range(16, 4096)->Complexity();
+
+static void BM_MoverAves(benchmark::State& estado)
+{
+    const int cantidad = static_cast<int>(estado.range(0));
+    BucleJuego* bucle = BucleJuego::instancia();
+
+    QGraphicsScene escena;
+    escena.setSceneRect(0, 0, 1536, 784);
+
+    ArenaNivel::abrir();
+    std::vector<obstaculo*> aves;
+    aves.reserve(cantidad);
+    for (int i = 0; i < cantidad; ++i) {
+        obstaculo* ave = new obstaculo(&escena, obstaculo::Ave, 10);
+        ave->iniciar(1536 + i % 1000, 100 + i % 450);   // Tardan en salir por la izquierda
+        aves.push_back(ave);
+    }
+
+    const int pasosPorTick = 60 / BucleJuego::pasoMs;
+    for (auto _ : estado) {
+        bucle->avanzar(pasosPorTick);
+
+        estado.PauseTiming();
+        for (int i = 0; i < cantidad; ++i) {
+            if (!aves[i]->estaActivo())
+                aves[i]->iniciar(1536 + i % 1000, 100 + i % 450);
+        }
+        estado.ResumeTiming();
+    }
+
+    estado.SetItemsProcessed(estado.iterations() * cantidad);
+    estado.SetComplexityN(cantidad);
+
+    for (obstaculo* ave : aves)
+        delete ave;
+    ArenaNivel::cerrar();
+}
+BENCHMARK(BM_MoverAves)->RangeMultiplier(4)->Range(16, 4096)->Complexity();
+
+static void BM_MoverExplosiones(benchmark::State& estado)
+{
+    const int cantidad = static_cast<int>(estado.range(0));
+    BucleJuego* bucle = BucleJuego::instancia();
+
+    QGraphicsScene escena;
+    escena.setSceneRect(0, 0, 1536, 784);
+
+    ArenaNivel::abrir();
+    std::vector<Explosion*> explosiones;
+    explosiones.reserve(cantidad);
+    for (int i = 0; i < cantidad; ++i) {
+        Explosion* explosion = new Explosion(&escena);
+        explosion->setTipoMovimiento(i % 2 == 0 ? Explosion::Parabolico : Explosion::MRU);
+        explosion->setPosicionInicial(QPointF(600 + i % 900, 200 + i % 200));   // Lejos del jugador
+        explosion->lanzar();
+        explosiones.push_back(explosion);
+    }
+
+    const int pasosPorTick = 30 / BucleJuego::pasoMs;
+    for (auto _ : estado) {
+        bucle->avanzar(pasosPorTick);
+
+        estado.PauseTiming();
+        for (Explosion* explosion : explosiones) {
+            if (!explosion->getSprite()->isVisible())
+                explosion->lanzar();
+        }
+        estado.ResumeTiming();
+    }
+
+    estado.SetItemsProcessed(estado.iterations() * cantidad);
+    estado.SetComplexityN(cantidad);
+
+    for (Explosion* explosion : explosiones)
+        delete explosion;
+    ArenaNivel::cerrar();
+}
+BENCHMARK(BM_MoverExplosiones)->RangeMultiplier(4)->Range(16, 4096)->Complexity();
@@ -0,0 +1,34 @@
+#include <benchmark/benchmark.h>
+
+#include <QApplication>
+#include <QTextStream>
+
+// Los qDebug del juego (constructores, destructores) ensucian la salida y cuestan tiempo medido
+static void filtrarMensajes(QtMsgType tipo, const QMessageLogContext& contexto, const QString& mensaje)
+{
+    Q_UNUSED(contexto);
+    if (tipo == QtDebugMsg || tipo == QtInfoMsg)
+        return;
+
+    QTextStream(stderr) << mensaje << Qt::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    // Sin pantalla: QPixmap y la escena funcionan igual con la plataforma offscreen
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QApplication app(argc, argv);
+    QApplication::setApplicationName("benchmarks");
+    qInstallMessageHandler(filtrarMensajes);
+
+    // Opciones propias de Google Benchmark: --benchmark_filter, --benchmark_out, --benchmark_out_format=json, ...
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,45 @@
+#include <benchmark/benchmark.h>
+
+#include "arenanivel.h"
+#include "azarjuego.h"
+#include "nivel1.h"
+#include "nivel2.h"
+#include <QCoreApplication>
+#include <QGraphicsScene>
+
+/*
+ * Construcción y destrucción de un nivel completo sin vista, como en juego::cambiarNivel y
+ * juego::cerrarNivel: arena abierta, escena del tamaño del nivel, iniciarNivel() y limpieza.
+ * Con semilla fija, cada iteración genera el mismo nivel.
+ */
+
+template <typename NivelPrueba>
+static void medirNivel(benchmark::State& estado, qreal anchoEscena)
+{
+    for (auto _ : estado) {
+        QGraphicsScene escena;
+        escena.setSceneRect(0, 0, anchoEscena, 784);
+        AzarJuego::sembrar(1234);
+
+        ArenaNivel::abrir();
+        Nivel* nivel = new NivelPrueba(&escena, nullptr);
+        nivel->iniciarNivel();
+
+        delete nivel;
+        escena.clear();
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+        ArenaNivel::cerrar();
+    }
+}
+
+static void BM_Nivel1(benchmark::State& estado)
+{
+    medirNivel<Nivel1>(estado, 1536 * 4);
+}
+BENCHMARK(BM_Nivel1)->Unit(benchmark::kMillisecond);
+
+static void BM_Nivel2(benchmark::State& estado)
+{
+    medirNivel<Nivel2>(estado, 1536);
+}
+BENCHMARK(BM_Nivel2)->Unit(benchmark::kMillisecond);
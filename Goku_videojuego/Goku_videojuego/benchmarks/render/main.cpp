@@ -0,0 +1,108 @@
+#include "medicionrender.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QJsonDocument>
+#include <QTextStream>
+#include <QDebug>
+#include <stdexcept>
+
+// Los qDebug del juego no interesan al medir y cuestan tiempo
+static void filtrarMensajes(QtMsgType tipo, const QMessageLogContext& contexto, const QString& mensaje)
+{
+    Q_UNUSED(contexto);
+    if (tipo == QtDebugMsg || tipo == QtInfoMsg)
+        return;
+
+    QTextStream(stderr) << mensaje << Qt::endl;
+}
+
+// "si"/"no" para forzar un ajuste; sin la opción se deja el del modo (-1)
+static int leerSiNo(const QCommandLineParser& parser, const QString& opcion)
+{
+    if (!parser.isSet(opcion)) return -1;
+
+    const QString valor = parser.value(opcion).trimmed().toLower();
+    if (valor == "si") return 1;
+    if (valor == "no") return 0;
+    throw std::invalid_argument(("--" + opcion + " espera 'si' o 'no'.").toStdString());
+}
+
+int main(int argc, char *argv[])
+{
+    // Sin pantalla: la vista se muestra y se pinta igual con la plataforma offscreen
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QApplication app(argc, argv);
+    QApplication::setApplicationName("render");
+    qInstallMessageHandler(filtrarMensajes);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Mide la duración de los frames al pintar un nivel real de Goku Adventure sin pantalla.");
+    parser.addHelpOption();
+    parser.addOption({"nivel", "Nivel a pintar (1 o 2).", "n", "1"});
+    parser.addOption({"frames", "Frames medidos.", "n", "600"});
+    parser.addOption({"calentamiento", "Frames previos que no se cuentan.", "n", "60"});
+    parser.addOption({"paneo", "Píxeles que avanza la cámara por frame.", "n", "12"});
+    parser.addOption({"semilla", "Semilla para generar el nivel.", "n", "1234"});
+    parser.addOption({"metodo", "escena (QGraphicsScene::render a un QImage) o vista (repintado de la vista).", "metodo", "escena"});
+    parser.addOption({"modo", "Modo de render de partida: completo, parches o rectangulo.", "modo", "parches"});
+    parser.addOption({"antialias", "Fuerza el antialiasing: si o no.", "si|no"});
+    parser.addOption({"suavizado", "Fuerza SmoothPixmapTransform: si o no.", "si|no"});
+    parser.addOption({"actualizacion", "Modo de actualización de la vista: completa, minima, inteligente, rectangulo o ninguna.", "modo"});
+    parser.addOption({"cache", "Caché de los items: ninguna, item o dispositivo.", "modo", "ninguna"});
+    parser.addOption({"json", "Guarda la configuración, el resumen y cada frame en JSON.", "ruta"});
+    parser.addOption({"captura", "Guarda el último frame como imagen (método escena).", "ruta"});
+    parser.process(app);
+
+    QTextStream salida(stdout);
+
+    try {
+        ConfigRender config;
+        config.nivel = parser.value("nivel").toInt();
+        config.frames = parser.value("frames").toInt();
+        config.calentamiento = qMax(0, parser.value("calentamiento").toInt());
+        config.paneo = qMax(0, parser.value("paneo").toInt());
+        config.semilla = parser.value("semilla").toUInt();
+        config.modo = VistaJuego::modoRender(parser.value("modo"));
+        config.antialias = leerSiNo(parser, "antialias");
+        config.suavizado = leerSiNo(parser, "suavizado");
+        config.cache = MedicionRender::modoCache(parser.value("cache"));
+        config.captura = parser.value("captura");
+
+        const QString metodo = parser.value("metodo").trimmed().toLower();
+        if (metodo != "escena" && metodo != "vista")
+            throw std::invalid_argument("--metodo espera 'escena' o 'vista'.");
+        config.usarVista = (metodo == "vista");
+
+        if (parser.isSet("actualizacion"))
+            config.actualizacion = MedicionRender::modoActualizacion(parser.value("actualizacion"));
+
+        MedicionRender medicion(config);
+        const ResultadoRender r = medicion.ejecutar();
+
+        const double ms = r.promedio();
+        salida << "nivel " << config.nivel << " (" << metodo << ", " << r.msFrames.size() << " frames, "
+               << r.items << " items): promedio=" << ms << "ms"
+               << " p50=" << r.percentil(50) << "ms"
+               << " p95=" << r.percentil(95) << "ms"
+               << " p99=" << r.percentil(99) << "ms"
+               << " max=" << r.percentil(100) << "ms"
+               << " fps=" << (ms > 0 ? 1000.0 / ms : 0.0) << Qt::endl;
+
+        if (parser.isSet("json")) {
+            QFile archivo(parser.value("json"));
+            if (!archivo.open(QIODevice::WriteOnly | QIODevice::Truncate))
+                throw std::runtime_error(("no se pudo escribir " + archivo.fileName()).toStdString());
+            archivo.write(QJsonDocument(r.json(config)).toJson());
+        }
+
+    } catch (const std::exception& e) {
+        qCritical() << "Error en la medición de render:" << e.what();
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,338 @@
+#include "medicionrender.h"
+#include "arenanivel.h"
+#include "azarjuego.h"
+#include "buclejuego.h"
+#include "capahud.h"
+#include "fondoparalaje.h"
+#include "nivel1.h"
+#include "nivel2.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QGraphicsScene>
+#include <QJsonArray>
+#include <QPainter>
+#include <QDebug>
+#include <algorithm>
+#include <stdexcept>  // Excepciones estándar
+
+/**
+@brief Promedio de la duración de los frames medidos.
+
+@return Milisegundos por frame, o 0 si no hay frames.
+*/
+double ResultadoRender::promedio() const
+{
+    if (msFrames.isEmpty()) return 0;
+
+    double suma = 0;
+    for (double ms : msFrames)
+        suma += ms;
+    return suma / msFrames.size();
+}
+
+/**
+@brief Percentil de la duración de los frames (por el rango más cercano).
+
+@param p Percentil entre 0 y 100.
+@return Milisegundos del frame en ese percentil, o 0 si no hay frames.
+*/
+double ResultadoRender::percentil(double p) const
+{
+    if (msFrames.isEmpty()) return 0;
+
+    QVector<double> ordenados = msFrames;
+    std::sort(ordenados.begin(), ordenados.end());
+
+    const int indice = qBound(0, static_cast<int>(p / 100.0 * ordenados.size() + 0.5) - 1,
+                              static_cast<int>(ordenados.size()) - 1);
+    return ordenados[indice];
+}
+
+/**
+@brief Resultado y configuración en JSON, para comparar corridas entre commits.
+
+@param config Configuración con la que se midió.
+@return Objeto con la configuración, el resumen (promedio, percentiles, fps) y cada frame.
+*/
+QJsonObject ResultadoRender::json(const ConfigRender& config) const
+{
+    QJsonObject configuracion;
+    configuracion["nivel"] = config.nivel;
+    configuracion["frames"] = config.frames;
+    configuracion["calentamiento"] = config.calentamiento;
+    configuracion["paneo"] = config.paneo;
+    configuracion["semilla"] = static_cast<qint64>(config.semilla);
+    configuracion["ancho"] = config.tamano.width();
+    configuracion["alto"] = config.tamano.height();
+    configuracion["metodo"] = config.usarVista ? "vista" : "escena";
+    configuracion["modo"] = static_cast<int>(config.modo);
+    configuracion["antialias"] = config.antialias;
+    configuracion["suavizado"] = config.suavizado;
+    configuracion["actualizacion"] = config.actualizacion;
+    configuracion["cache"] = static_cast<int>(config.cache);
+
+    const double ms = promedio();
+    QJsonObject resumen;
+    resumen["promedio_ms"] = ms;
+    resumen["min_ms"] = percentil(0);
+    resumen["p50_ms"] = percentil(50);
+    resumen["p90_ms"] = percentil(90);
+    resumen["p95_ms"] = percentil(95);
+    resumen["p99_ms"] = percentil(99);
+    resumen["max_ms"] = percentil(100);
+    resumen["fps"] = ms > 0 ? 1000.0 / ms : 0.0;
+    resumen["items"] = items;
+
+    QJsonArray frames;
+    for (double f : msFrames)
+        frames.append(f);
+
+    QJsonObject raiz;
+    raiz["configuracion"] = configuracion;
+    raiz["resumen"] = resumen;
+    raiz["frames_ms"] = frames;
+    return raiz;
+}
+
+/**
+@brief Constructor de la medición.
+
+@param config Nivel, cantidad de frames y ajustes de render a medir.
+
+@throw std::invalid_argument Si el nivel no es 1 ni 2, o si no hay frames o tamaño que medir.
+*/
+MedicionRender::MedicionRender(const ConfigRender& config)
+    : config(config)
+{
+    if (config.nivel != 1 && config.nivel != 2)
+        throw std::invalid_argument("MedicionRender: el nivel debe ser 1 o 2.");
+    if (config.frames <= 0 || config.tamano.isEmpty())
+        throw std::invalid_argument("MedicionRender: hace falta al menos un frame y un tamaño válido.");
+}
+
+/**
+@brief Construye el nivel, recorre su escena con la cámara y mide cada frame.
+
+Por frame, sin medir: avanza la simulación `frameMs` (como un frame del juego), desplaza la
+cámara `paneo` píxeles (rebotando en los bordes de la escena) y aplica la caché de items a los
+items nuevos. Medido: el pintado del frame.
+
+- Método escena: fondo por capas, `QGraphicsScene::render` y HUD sobre un `QImage`, con las
+  mismas sugerencias de render que tendría la vista.
+- Método vista: la vista del juego se muestra en la plataforma offscreen y se mide el
+  repintado que hace al atender los eventos, respetando su modo de actualización.
+
+@return Duración de cada frame medido.
+
+@note El reloj de frames del bucle debe estar detenido: la simulación avanza a mano.
+*/
+ResultadoRender MedicionRender::ejecutar()
+{
+    ResultadoRender resultado;
+    resultado.msFrames.reserve(config.frames);
+
+    BucleJuego* bucle = BucleJuego::instancia();
+    if (bucle->estaActivo())
+        bucle->detener();
+
+    // Mismo tamaño de escena que juego::cambiarNivel
+    QGraphicsScene escena;
+    escena.setSceneRect(0, 0, config.nivel == 1 ? 1536 * 4 : 1536, 784);
+
+    VistaJuego vista;
+    vista.setScene(&escena);
+    vista.setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    vista.setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    vista.setFrameShape(QFrame::NoFrame);
+    vista.setFixedSize(config.tamano);
+    configurarVista(vista);
+
+    // En el método escena la vista solo hace de cámara: se muestra para que tenga su tamaño real,
+    // pero no se repinta
+    if (!config.usarVista)
+        vista.setViewportUpdateMode(QGraphicsView::NoViewportUpdate);
+    vista.show();
+
+    AzarJuego::sembrar(config.semilla);
+    ArenaNivel::abrir();
+
+    // La vista es la del nivel: el fondo por capas toma de ella la posición de la cámara
+    Nivel* nivel = nullptr;
+    if (config.nivel == 1)
+        nivel = new Nivel1(&escena, &vista);
+    else
+        nivel = new Nivel2(&escena, &vista);
+    nivel->iniciarNivel();
+
+    imagen = QImage(config.tamano, QImage::Format_ARGB32_Premultiplied);
+
+    const qreal maxX = qMax<qreal>(0, escena.width() - config.tamano.width());
+    qreal x = 0;
+    int direccion = 1;
+    const int pasosPorFrame = BucleJuego::frameMs / BucleJuego::pasoMs;
+
+    QElapsedTimer reloj;
+    for (int i = 0; i < config.calentamiento + config.frames; ++i) {
+        bucle->avanzar(pasosPorFrame);
+
+        x += direccion * config.paneo;
+        if (x >= maxX) { x = maxX; direccion = -1; }
+        if (x <= 0)    { x = 0;    direccion = 1; }
+        const QRectF zona(x, 0, config.tamano.width(), config.tamano.height());
+        vista.centerOn(zona.center());
+
+        aplicarCache(escena);
+
+        if (config.usarVista) {
+            pedirRepintado(vista);
+            reloj.start();
+            QCoreApplication::processEvents();
+        } else {
+            QCoreApplication::processEvents();
+            reloj.start();
+            pintarEscena(escena, vista, zona);
+        }
+        const double ms = reloj.nsecsElapsed() / 1.0e6;
+
+        if (i >= config.calentamiento)
+            resultado.msFrames.append(ms);
+
+        // Los deleteLater() del nivel se atienden fuera de la medición
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    }
+
+    resultado.items = escena.items().size();
+
+    if (!config.usarVista && !config.captura.isEmpty() && !imagen.save(config.captura))
+        qWarning() << "MedicionRender: no se pudo guardar la captura en" << config.captura;
+
+    delete nivel;
+    escena.clear();
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    ArenaNivel::cerrar();
+
+    return resultado;
+}
+
+/**
+@brief Convierte un nombre de modo de actualización de la vista en su valor.
+
+@param nombre "completa", "minima", "inteligente", "rectangulo" o "ninguna".
+@return Valor de `QGraphicsView::ViewportUpdateMode`.
+
+@throw std::invalid_argument Si el nombre no corresponde a ningún modo.
+*/
+int MedicionRender::modoActualizacion(const QString& nombre)
+{
+    const QString n = nombre.trimmed().toLower();
+    if (n == "completa")    return QGraphicsView::FullViewportUpdate;
+    if (n == "minima")      return QGraphicsView::MinimalViewportUpdate;
+    if (n == "inteligente") return QGraphicsView::SmartViewportUpdate;
+    if (n == "rectangulo")  return QGraphicsView::BoundingRectViewportUpdate;
+    if (n == "ninguna")     return QGraphicsView::NoViewportUpdate;
+
+    throw std::invalid_argument("MedicionRender: modo de actualización desconocido "
+                                "(completa, minima, inteligente, rectangulo o ninguna).");
+}
+
+/**
+@brief Convierte un nombre de caché de items en su valor.
+
+@param nombre "ninguna", "item" o "dispositivo".
+@return Valor de `QGraphicsItem::CacheMode`.
+
+@throw std::invalid_argument Si el nombre no corresponde a ningún modo.
+*/
+QGraphicsItem::CacheMode MedicionRender::modoCache(const QString& nombre)
+{
+    const QString n = nombre.trimmed().toLower();
+    if (n == "ninguna")     return QGraphicsItem::NoCache;
+    if (n == "item")        return QGraphicsItem::ItemCoordinateCache;
+    if (n == "dispositivo") return QGraphicsItem::DeviceCoordinateCache;
+
+    throw std::invalid_argument("MedicionRender: caché desconocida (ninguna, item o dispositivo).");
+}
+
+/**
+@brief Aplica el modo de render de partida y luego los ajustes forzados por la configuración.
+
+@param vista Vista del nivel.
+*/
+void MedicionRender::configurarVista(VistaJuego& vista) const
+{
+    vista.setModoRender(config.modo);
+
+    if (config.antialias >= 0)
+        vista.setRenderHint(QPainter::Antialiasing, config.antialias > 0);
+    if (config.suavizado >= 0)
+        vista.setRenderHint(QPainter::SmoothPixmapTransform, config.suavizado > 0);
+    if (config.actualizacion >= 0)
+        vista.setViewportUpdateMode(static_cast<QGraphicsView::ViewportUpdateMode>(config.actualizacion));
+}
+
+/**
+@brief Pone la caché configurada en los items que todavía no la tienen.
+
+Los niveles crean items mientras se juega (explosiones, robots), así que se revisa en cada frame.
+
+@param escena Escena del nivel.
+*/
+void MedicionRender::aplicarCache(QGraphicsScene& escena) const
+{
+    for (QGraphicsItem* item : escena.items()) {
+        if (item->cacheMode() != config.cache)
+            item->setCacheMode(config.cache);
+    }
+}
+
+/**
+@brief Pinta un frame completo en `imagen`, como lo haría la vista del juego.
+
+Fondo por capas (en coordenadas de escena), los items con `QGraphicsScene::render` y el HUD
+encima (en coordenadas de la imagen).
+
+@param escena Escena del nivel.
+@param vista Vista del nivel; de ella salen las sugerencias de render.
+@param zona Zona de la escena que muestra la cámara.
+*/
+void MedicionRender::pintarEscena(QGraphicsScene& escena, const QGraphicsView& vista, const QRectF& zona)
+{
+    QPainter painter(&imagen);
+    painter.setRenderHints(vista.renderHints());
+
+    if (FondoParalaje* fondo = FondoParalaje::deEscena(&escena)) {
+        painter.save();
+        painter.translate(-zona.topLeft());
+        fondo->dibujar(&painter, zona);
+        painter.restore();
+    } else {
+        painter.fillRect(imagen.rect(), escena.backgroundBrush());
+    }
+
+    escena.render(&painter, QRectF(imagen.rect()), zona, Qt::IgnoreAspectRatio);
+
+    if (CapaHud* hud = CapaHud::deEscena(&escena))
+        hud->dibujar(&painter);
+}
+
+/**
+@brief Pide el repintado del frame igual que el bucle central.
+
+Con `NoViewportUpdate` la vista no se repinta sola y se pide el viewport completo; en los otros
+modos se agrega la zona del HUD que cambió.
+
+@param vista Vista del nivel.
+*/
+void MedicionRender::pedirRepintado(QGraphicsView& vista) const
+{
+    if (vista.viewportUpdateMode() == QGraphicsView::NoViewportUpdate) {
+        vista.viewport()->update();
+        return;
+    }
+
+    if (CapaHud* hud = CapaHud::deEscena(vista.scene())) {
+        const QRegion sucia = hud->zonaSucia();
+        if (!sucia.isEmpty())
+            vista.viewport()->update(sucia);
+    }
+}
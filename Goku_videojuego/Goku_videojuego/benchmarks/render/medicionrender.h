@@ -0,0 +1,70 @@
+#ifndef MEDICIONRENDER_H
+#define MEDICIONRENDER_H
+
+#include <QGraphicsItem>
+#include <QGraphicsView>
+#include <QImage>
+#include <QJsonObject>
+#include <QSize>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+#include "vistajuego.h"
+
+class QGraphicsScene;
+
+// Cómo se mide un frame
+struct ConfigRender {
+    int nivel = 1;
+    int frames = 600;                  // Frames medidos
+    int calentamiento = 60;            // Frames previos que no se cuentan
+    int paneo = 12;                    // Píxeles que avanza la cámara por frame (ida y vuelta)
+    quint32 semilla = 1234;
+    QSize tamano = QSize(1536, 784);
+    bool usarVista = false;            // false: QGraphicsScene::render a un QImage; true: repintado de la vista
+
+    VistaJuego::ModoRender modo = VistaJuego::RenderParches;   // Punto de partida de la vista
+    int antialias = -1;                // -1 deja lo que define el modo; 0/1 lo fuerza
+    int suavizado = -1;                // SmoothPixmapTransform, igual que antialias
+    int actualizacion = -1;            // QGraphicsView::ViewportUpdateMode, o -1 para el del modo
+    QGraphicsItem::CacheMode cache = QGraphicsItem::NoCache;   // Se aplica a todos los items
+
+    QString captura;                   // Si no está vacío, guarda ahí el último frame (método escena)
+};
+
+// Duración de cada frame medido y su resumen
+struct ResultadoRender {
+    QVector<double> msFrames;
+    qint64 items = 0;                  // Items de la escena al terminar
+
+    double promedio() const;
+    double percentil(double p) const;  // p entre 0 y 100
+    QJsonObject json(const ConfigRender& config) const;
+};
+
+/**
+ * Recorre un nivel real con la cámara y mide cuánto cuesta pintar cada frame sin pantalla.
+ * Entre frame y frame avanza la simulación lo mismo que un frame del juego, así que las nubes,
+ * los obstáculos, los robots y las pociones se mueven como al jugar.
+ */
+class MedicionRender
+{
+public:
+    explicit MedicionRender(const ConfigRender& config);
+
+    ResultadoRender ejecutar();
+
+    static int modoActualizacion(const QString& nombre);                // "completa", "minima", ...
+    static QGraphicsItem::CacheMode modoCache(const QString& nombre);   // "ninguna", "item", "dispositivo"
+
+private:
+    void configurarVista(VistaJuego& vista) const;
+    void aplicarCache(QGraphicsScene& escena) const;
+    void pintarEscena(QGraphicsScene& escena, const QGraphicsView& vista, const QRectF& zona);
+    void pedirRepintado(QGraphicsView& vista) const;
+
+    ConfigRender config;
+    QImage imagen;                     // Destino del método escena, reutilizado en cada frame
+};
+
+#endif // MEDICIONRENDER_H
@@ -0,0 +1,23 @@
+# Medición de render de escenas reales: construye el nivel 1 o 2 completo, recorre el nivel con
+# la cámara y mide cuánto tarda cada frame en pintarse con la plataforma offscreen.
+#   ./render --nivel 1 --metodo escena --json nivel1.json
+
+TARGET = render
+TEMPLATE = app
+
+CONFIG += console
+CONFIG -= app_bundle
+
+include(../../nucleo.pri)
+
+# La vista del juego (fondo por capas, HUD y modos de render) no es parte del núcleo
+INCLUDEPATH += ../..
+
+SOURCES += \
+    ../../vistajuego.cpp \
+    main.cpp \
+    medicionrender.cpp
+
+HEADERS += \
+    ../../vistajuego.h \
+    medicionrender.h
@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+
+#include "spritecache.h"
+#include <QPixmap>
+#include <QVector>
+
+/*
+ * Recorte de hojas de sprites.
+ * "Cortar" repite lo que hacían Robot::cargarImagen y el constructor de Explosion antes de la
+ * caché (un copy() por frame sobre la hoja ya decodificada); "Cache" es lo que hacen hoy, una
+ * búsqueda en SpriteCache que devuelve frames compartidos.
+ */
+
+// Robot del nivel 1: 6 frames de 50x56 a partir del frame indicado
+static void BM_CortarRobot(benchmark::State& estado)
+{
+    const QPixmap hoja = SpriteCache::instancia()->hoja(":/images/robots1.png");
+    const int ancho = 50, alto = 56, cantidad = 6;
+    const int frameInicial = static_cast<int>(estado.range(0)) * cantidad;
+
+    for (auto _ : estado) {
+        QVector<QPixmap> frames;
+        frames.reserve(cantidad);
+        for (int i = 0; i < cantidad; ++i)
+            frames.append(hoja.copy((frameInicial + i) * ancho, 0, ancho, alto));
+        benchmark::DoNotOptimize(frames);
+    }
+    estado.SetItemsProcessed(estado.iterations() * cantidad);
+}
+BENCHMARK(BM_CortarRobot)->DenseRange(0, 3);
+
+// Explosión: 6 frames de 100x72
+static void BM_CortarExplosion(benchmark::State& estado)
+{
+    const QPixmap hoja = SpriteCache::instancia()->hoja(":/images/explosion.png");
+    const int ancho = 100, alto = 72, cantidad = 6;
+
+    for (auto _ : estado) {
+        QVector<QPixmap> frames;
+        frames.reserve(cantidad);
+        for (int i = 0; i < cantidad; ++i)
+            frames.append(hoja.copy(i * ancho, 0, ancho, alto));
+        benchmark::DoNotOptimize(frames);
+    }
+    estado.SetItemsProcessed(estado.iterations() * cantidad);
+}
+BENCHMARK(BM_CortarExplosion);
+
+static void BM_CacheRobot(benchmark::State& estado)
+{
+    SpriteCache* cache = SpriteCache::instancia();
+    const int frameInicial = static_cast<int>(estado.range(0)) * 6;
+
+    for (auto _ : estado)
+        benchmark::DoNotOptimize(cache->frames(":/images/robots1.png", 50, 56, 6, frameInicial));
+}
+BENCHMARK(BM_CacheRobot)->DenseRange(0, 3);
+
+static void BM_CacheExplosion(benchmark::State& estado)
+{
+    SpriteCache* cache = SpriteCache::instancia();
+
+    for (auto _ : estado)
+        benchmark::DoNotOptimize(cache->frames(":/images/explosion.png", 100, 72, 6));
+}
+BENCHMARK(BM_CacheExplosion);
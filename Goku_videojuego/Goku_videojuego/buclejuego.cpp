@@ -0,0 +1,428 @@
+#include "buclejuego.h"
+#include "perfilador.h"
+#include "trazaeventos.h"
+#include "rastreomemoria.h"
+#include "capahud.h"
+#include <QCoreApplication>
+#include <stdexcept>  // Para lanzar excepciones estándar
+
+// Instancia única del bucle (se crea bajo demanda)
+BucleJuego* BucleJuego::unico = nullptr;
+
+/**
+@brief Constructor privado del bucle central del juego.
+
+Crea el único temporizador de frames de la aplicación y lo configura con precisión alta para que
+los frames no se desfasen entre sí. El reloj no arranca hasta que se llama a `iniciar()`.
+
+@param parent Objeto padre en la jerarquía de Qt (normalmente la aplicación).
+*/
+BucleJuego::BucleJuego(QObject* parent)
+    : QObject(parent), timerFrame(new QTimer(this))
+{
+    timerFrame->setTimerType(Qt::PreciseTimer);
+    connect(timerFrame, &QTimer::timeout, this, &BucleJuego::procesarFrame);
+}
+
+/**
+@brief Destructor del bucle central.
+
+Detiene el reloj de frames y desvincula las tareas que aún sigan registradas, de modo que sus
+destructores no intenten quitarse de un bucle que ya no existe.
+*/
+BucleJuego::~BucleJuego()
+{
+    detener();
+
+    for (auto& lista : tareas) {
+        for (TareaBucle* tarea : lista) {
+            if (tarea) tarea->indice = -1;
+        }
+        lista.clear();
+    }
+
+    if (unico == this)
+        unico = nullptr;
+}
+
+/**
+@brief Devuelve la instancia única del bucle, creándola la primera vez.
+
+El bucle queda como hijo de la aplicación para que se destruya junto con ella.
+
+@return Puntero al bucle central del juego.
+
+@throw std::runtime_error Si se invoca antes de crear la aplicación de Qt.
+*/
+BucleJuego* BucleJuego::instancia()
+{
+    if (!unico) {
+        if (!QCoreApplication::instance())
+            throw std::runtime_error("BucleJuego: la aplicación de Qt no ha sido creada.");
+        unico = new BucleJuego(QCoreApplication::instance());
+    }
+    return unico;
+}
+
+/**
+@brief Indica si el bucle central ya fue creado y sigue vivo.
+
+@return `true` si existe la instancia única, `false` en caso contrario.
+*/
+bool BucleJuego::existe()
+{
+    return unico != nullptr;
+}
+
+/**
+@brief Arranca el reloj de frames.
+
+Reinicia la medición del tiempo real, el tiempo acumulado y la historia del perfilador, de modo
+que el primer frame no intente recuperar (ni medir) el tiempo que el bucle estuvo detenido. Si ya estaba activo no hace nada.
+*/
+void BucleJuego::iniciar()
+{
+    if (timerFrame->isActive()) return;
+
+    reloj.start();
+    ultimoInstante = 0;
+    acumulado = 0;
+    Perfilador::instancia()->reiniciar();
+    timerFrame->start(frameMs);
+}
+
+/**
+@brief Detiene el reloj de frames. Las tareas registradas conservan su estado.
+*/
+void BucleJuego::detener()
+{
+    if (timerFrame->isActive())
+        timerFrame->stop();
+}
+
+/**
+@brief Indica si el reloj de frames está corriendo.
+
+@return `true` si el bucle está activo.
+*/
+bool BucleJuego::estaActivo() const
+{
+    return timerFrame->isActive();
+}
+
+/**
+@brief Asocia la vista que se debe repintar al final de cada frame.
+
+@param vista Vista del juego; puede ser `nullptr` para no repintar nada.
+*/
+void BucleJuego::setVista(QGraphicsView* vista)
+{
+    this->vista = vista;
+}
+
+/**
+@brief Devuelve la cantidad de pasos de simulación ejecutados desde que se creó el bucle.
+
+@return Número total de pasos fijos ejecutados.
+*/
+qint64 BucleJuego::getPasosTotales() const
+{
+    return pasosTotales;
+}
+
+/**
+@brief Devuelve cuánto del próximo paso ya transcurrió en tiempo real.
+
+Después de los pasos de un frame queda un resto de tiempo menor que `pasoMs` sin simular. Lo que
+se dibuja puede interpolarse entre los dos últimos estados con esta fracción, para que el
+movimiento no avance a saltos de un paso. En `avanzar()` no hay resto y vale 0.
+
+@return Valor entre 0 (justo en el último paso) y 1 (a punto de dar el siguiente).
+*/
+double BucleJuego::getAlfa() const
+{
+    return qBound(0.0, static_cast<double>(acumulado) / pasoMs, 1.0);
+}
+
+/**
+@brief Ejecuta de inmediato la cantidad de pasos fijos indicada.
+
+No mide tiempo real ni repinta la vista: es la forma de mover el juego a la velocidad que permita
+la CPU (por ejemplo, en el simulador sin vista). No debe usarse mientras el reloj de frames está activo.
+
+@param pasos Cantidad de pasos de `pasoMs` a ejecutar.
+*/
+void BucleJuego::avanzar(int pasos)
+{
+    for (int i = 0; i < pasos; ++i)
+        ejecutarPaso();
+}
+
+/**
+@brief Programa una acción única después de un retardo medido en tiempo simulado.
+
+Reemplaza a `QTimer::singleShot` en la lógica del juego, de modo que los retardos avanzan al mismo
+ritmo que la simulación (en tiempo real con el reloj de frames, o tan rápido como se llame a
+`avanzar()`). La tarea creada se destruye sola después de ejecutarse.
+
+@param retardoMs Retardo en milisegundos simulados.
+@param contexto Objeto dueño de la tarea; si se destruye antes, la acción no se ejecuta. No puede ser nulo.
+@param accion Acción a ejecutar.
+@param fase Fase del bucle en la que se ejecutará la acción.
+@return La tarea creada, por si se necesita detenerla antes de tiempo.
+
+@throw std::invalid_argument Si el contexto es nulo.
+*/
+TareaBucle* BucleJuego::programar(int retardoMs, QObject* contexto, std::function<void()> accion, Fase fase)
+{
+    if (!contexto)
+        throw std::invalid_argument("BucleJuego::programar - el contexto no puede ser nulo.");
+
+    TareaBucle* tarea = new TareaBucle(fase, nullptr, contexto, "programar");
+    tarea->accion = [tarea, accion = std::move(accion)]() {
+        // Se copia la acción porque puede destruir al contexto (y con él a la tarea)
+        std::function<void()> ejecutar = accion;
+        tarea->deleteLater();
+        ejecutar();
+    };
+    tarea->setUnaVez(true);
+    tarea->iniciar(retardoMs);
+    return tarea;
+}
+
+/**
+@brief Atiende un frame del reloj central.
+
+Suma el tiempo real transcurrido desde el frame anterior y ejecuta tantos pasos fijos de
+`pasoMs` como quepan en él. Si el juego se bloqueó (por ejemplo, al cargar un nivel) se limita
+la cantidad de pasos a `maxPasosPorFrame` y se descarta el resto, para no congelar el frame
+intentando ponerse al día. Después emite `antesDePintar()` (la cámara coloca ahí la vista con
+la posición interpolada), solicita un único repintado, emite `frameTerminado()` y cierra el frame
+en el `Perfilador` y en el `RastreoMemoria`.
+*/
+void BucleJuego::procesarFrame()
+{
+    TRAZA_EVENTO("BucleJuego::procesarFrame", "frame");
+    qint64 ahora = reloj.elapsed();
+    acumulado += ahora - ultimoInstante;
+    ultimoInstante = ahora;
+
+    int pasos = 0;
+    {
+        ZONA_PERFIL("simulacion");
+        while (acumulado >= pasoMs && pasos < maxPasosPorFrame) {
+            ejecutarPaso();
+            acumulado -= pasoMs;
+            ++pasos;
+        }
+    }
+
+    if (pasos == maxPasosPorFrame)
+        acumulado = 0;   // Se descarta el atraso
+
+    emit antesDePintar();
+    renderizar();
+    emit frameTerminado();
+
+    // El pintado que pidió renderizar() ocurre después: cuenta para el frame siguiente
+    Perfilador::instancia()->cerrarFrame();
+    RastreoMemoria::cerrarFrame();
+}
+
+/**
+@brief Ejecuta un paso fijo de simulación sobre todas las tareas activas.
+
+Recorre las fases en el orden definido por `Fase` y, dentro de cada fase, las tareas en el orden
+en que se registraron. Cada tarea acumula `pasoMs` y se invoca cada vez que alcanza su periodo.
+
+Una tarea puede destruir otras (o a sí misma) durante su callback: el bucle deja un hueco en la
+lista y compacta al terminar el paso. Las tareas creadas durante el paso empiezan en el siguiente.
+*/
+void BucleJuego::ejecutarPaso()
+{
+    TRAZA_EVENTO("BucleJuego::paso", "frame");
+
+    for (int f = 0; f < NumFases; ++f) {
+        std::vector<TareaBucle*>& lista = tareas[f];
+        const size_t cantidad = lista.size();
+
+        for (size_t i = 0; i < cantidad; ++i) {
+            TareaBucle* tarea = lista[i];
+            if (!tarea || !tarea->activa) continue;
+
+            tarea->acumulado += pasoMs;
+            while (lista[i] == tarea && tarea->activa && tarea->acumulado >= tarea->periodo) {
+                tarea->acumulado -= tarea->periodo;
+                if (tarea->unaVez) tarea->activa = false;
+                ejecutarTarea(tarea);
+            }
+        }
+    }
+
+    ++pasosTotales;
+
+    if (hayHuecos)
+        compactar();
+}
+
+/**
+@brief Invoca el callback de una tarea, registrándolo en la traza de eventos si está activa.
+
+En la traza, la tarea aparece como `Clase::nombre`, donde la clase es la de su objeto dueño
+(por ejemplo `Nivel1::actualizarNivel`).
+
+@param tarea Tarea a ejecutar; puede destruirse durante su propio callback.
+*/
+void BucleJuego::ejecutarTarea(TareaBucle* tarea)
+{
+    TrazaEventos* traza = TrazaEventos::instancia();
+    if (!traza->estaActiva()) {
+        tarea->accion();
+        return;
+    }
+
+    // Se leen antes de la llamada: la tarea puede no existir al volver
+    const char* nombre = tarea->nombre ? tarea->nombre : "tarea";
+    const char* clase = tarea->parent() ? tarea->parent()->metaObject()->className() : nullptr;
+
+    traza->comenzar(nombre, "tarea", clase);
+    tarea->accion();
+    traza->terminar(nombre, "tarea", clase);
+}
+
+/**
+@brief Elimina de las listas los huecos dejados por tareas destruidas y actualiza sus índices.
+*/
+void BucleJuego::compactar()
+{
+    for (auto& lista : tareas) {
+        size_t destino = 0;
+        for (size_t i = 0; i < lista.size(); ++i) {
+            if (!lista[i]) continue;
+            lista[destino] = lista[i];
+            lista[destino]->indice = static_cast<int>(destino);
+            ++destino;
+        }
+        lista.resize(destino);
+    }
+    hayHuecos = false;
+}
+
+/**
+@brief Solicita el repintado de la vista asociada.
+
+Toda la simulación del frame ya terminó, así que basta con un único `update()` del viewport.
+Solo se fuerza cuando la vista está en modo `NoViewportUpdate`; en cualquier otro modo la escena
+ya acumuló las regiones sucias del frame y las pinta en una sola pasada. El HUD no es parte de
+la escena: en esos modos se agrega a mano la zona de los elementos del HUD que cambiaron.
+*/
+void BucleJuego::renderizar()
+{
+    if (!vista) return;
+
+    if (vista->viewportUpdateMode() == QGraphicsView::NoViewportUpdate) {
+        vista->viewport()->update();
+        return;
+    }
+
+    if (CapaHud* hud = CapaHud::deEscena(vista->scene())) {
+        const QRegion sucia = hud->zonaSucia();
+        if (!sucia.isEmpty())
+            vista->viewport()->update(sucia);
+    }
+}
+
+/**
+@brief Agrega una tarea al final de la lista de su fase.
+
+@param tarea Tarea a registrar.
+*/
+void BucleJuego::registrar(TareaBucle* tarea)
+{
+    std::vector<TareaBucle*>& lista = tareas[tarea->fase];
+    tarea->indice = static_cast<int>(lista.size());
+    lista.push_back(tarea);
+}
+
+/**
+@brief Quita una tarea del bucle en tiempo constante dejando un hueco en su posición.
+
+@param tarea Tarea a quitar.
+*/
+void BucleJuego::quitar(TareaBucle* tarea)
+{
+    if (tarea->indice < 0) return;
+
+    tareas[tarea->fase][tarea->indice] = nullptr;
+    tarea->indice = -1;
+    hayHuecos = true;
+}
+
+/**
+@brief Constructor de una tarea del bucle.
+
+Registra la tarea en el bucle central dentro de la fase indicada. La tarea queda inactiva hasta
+que se llame a `iniciar()`.
+
+@param fase Fase del bucle en la que se ejecutará la tarea.
+@param accion Callback a invocar en cada periodo.
+@param parent Objeto dueño; al destruirse destruye también la tarea.
+@param nombre Nombre de la tarea en la traza de eventos (un literal), o `nullptr`.
+*/
+TareaBucle::TareaBucle(BucleJuego::Fase fase, std::function<void()> accion, QObject* parent,
+                       const char* nombre)
+    : QObject(parent), fase(fase), accion(std::move(accion)), nombre(nombre)
+{
+    BucleJuego::instancia()->registrar(this);
+}
+
+/**
+@brief Destructor de la tarea. La quita del bucle si este sigue existiendo.
+*/
+TareaBucle::~TareaBucle()
+{
+    if (BucleJuego::existe())
+        BucleJuego::instancia()->quitar(this);
+}
+
+/**
+@brief Activa la tarea con el periodo indicado, reiniciando su tiempo acumulado.
+
+Igual que `QTimer::start`, si ya estaba activa vuelve a empezar a contar desde cero.
+
+@param periodoMs Periodo en milisegundos de tiempo simulado; se ajusta a un mínimo de un paso.
+*/
+void TareaBucle::iniciar(int periodoMs)
+{
+    periodo = qMax(periodoMs, BucleJuego::pasoMs);
+    acumulado = 0;
+    activa = true;
+}
+
+/**
+@brief Desactiva la tarea sin quitarla del bucle.
+*/
+void TareaBucle::detener()
+{
+    activa = false;
+}
+
+/**
+@brief Indica si la tarea está activa.
+
+@return `true` si el bucle la está ejecutando.
+*/
+bool TareaBucle::estaActiva() const
+{
+    return activa;
+}
+
+/**
+@brief Configura la tarea para ejecutarse una sola vez por cada llamada a `iniciar()`.
+
+@param valor `true` para modo de disparo único.
+*/
+void TareaBucle::setUnaVez(bool valor)
+{
+    unaVez = valor;
+}
@@ -0,0 +1,129 @@
+#ifndef BUCLEJUEGO_H
+#define BUCLEJUEGO_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QGraphicsView>
+#include <functional>
+#include <vector>
+
+class TareaBucle;
+
+/**
+ * Reloj central del juego.
+ * Un único temporizador marca los frames; en cada frame se ejecutan pasos de simulación
+ * de duración fija sobre todas las tareas registradas, recorriendo las fases en orden,
+ * y al terminar se solicita un único repintado de la vista.
+ */
+class BucleJuego : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Orden en el que se actualizan las entidades dentro de cada paso
+    enum Fase {
+        FaseEntrada,        // Teclas repetidas desde una grabación, antes de mover a nadie
+        FaseJugador,
+        FaseEnemigos,
+        FaseProyectiles,
+        FaseEscenario,
+        FaseNivel,
+        FaseCamara,
+        FaseHud,
+        NumFases
+    };
+
+    static constexpr int pasoMs = 5;             // Duración fija de un paso de simulación
+    static constexpr int frameMs = 16;           // Intervalo del reloj de frames (~60 FPS)
+    static constexpr int maxPasosPorFrame = 20;  // Evita acumular atraso tras un bloqueo
+
+    static BucleJuego* instancia();
+    static bool existe();
+
+    void iniciar();
+    void detener();
+    bool estaActivo() const;
+
+    void setVista(QGraphicsView* vista);
+    qint64 getPasosTotales() const;
+    double getAlfa() const;                  // Fracción de paso sin simular, para interpolar al pintar
+
+    // Ejecuta pasos fijos de inmediato, sin reloj real ni repintado (simulación sin vista)
+    void avanzar(int pasos);
+
+    // Equivalente a QTimer::singleShot pero en tiempo simulado; se cancela si muere el contexto
+    TareaBucle* programar(int retardoMs, QObject* contexto, std::function<void()> accion,
+                          Fase fase = FaseNivel);
+
+signals:
+    void antesDePintar();    // Después de la simulación del frame y antes de pedir el repintado
+    void frameTerminado();   // Se emite una vez por frame, después de la simulación
+
+private slots:
+    void procesarFrame();
+
+private:
+    explicit BucleJuego(QObject* parent = nullptr);
+    ~BucleJuego();
+
+    friend class TareaBucle;
+    void registrar(TareaBucle* tarea);
+    void quitar(TareaBucle* tarea);
+    void ejecutarPaso();
+    void ejecutarTarea(TareaBucle* tarea);
+    void compactar();
+    void renderizar();
+
+    static BucleJuego* unico;
+
+    QTimer* timerFrame;
+    QElapsedTimer reloj;
+    qint64 ultimoInstante = 0;
+    qint64 acumulado = 0;
+    qint64 pasosTotales = 0;
+    bool hayHuecos = false;
+
+    std::vector<TareaBucle*> tareas[NumFases];
+    QPointer<QGraphicsView> vista;
+
+    // Bloqueamos copia y asignación
+    BucleJuego(const BucleJuego&) = delete;
+    BucleJuego& operator=(const BucleJuego&) = delete;
+};
+
+/**
+ * Callback periódico registrado en el BucleJuego.
+ * Reemplaza a los QTimer propios de cada entidad: se inicia con un periodo en milisegundos
+ * y el bucle lo invoca desde su fase cada vez que el tiempo simulado acumulado lo alcanza.
+ * Se elimina junto con su objeto padre y en ese momento se quita del bucle.
+ */
+class TareaBucle : public QObject
+{
+    Q_OBJECT
+
+public:
+    TareaBucle(BucleJuego::Fase fase, std::function<void()> accion, QObject* parent,
+               const char* nombre = nullptr);   // nombre: literal que identifica la tarea en la traza
+    ~TareaBucle();
+
+    void iniciar(int periodoMs);
+    void detener();
+    bool estaActiva() const;
+    void setUnaVez(bool valor);   // Equivalente a QTimer::setSingleShot
+
+private:
+    friend class BucleJuego;
+
+    BucleJuego::Fase fase;
+    std::function<void()> accion;
+    const char* nombre = nullptr;
+    int periodo = 0;
+    int acumulado = 0;
+    int indice = -1;              // Posición dentro de la lista de su fase
+    bool activa = false;
+    bool unaVez = false;
+};
+
+#endif // BUCLEJUEGO_H
@@ -1,4 +1,7 @@
 #include "camaralogica.h"
+#include <QtMath>
+#include <stdexcept>  // Para lanzar excepciones estándar
+#include <QDebug>
 
 // Inicialización del contador
 int camaraLogica::contador = 0;
@@ -6,22 +9,23 @@ int camaraLogica::contador = 0;
 /**
 @brief Constructor de la clase camaraLogica.
 Inicializa el sistema de cámara que sigue al personaje principal (Goku) durante el juego.
-Configura un temporizador interno para actualizar la posición de la vista de forma fluida,
-permitiendo que la cámara se desplace automáticamente y mantenga a Goku en un punto específico
-de la pantalla mientras se mueve por el nivel.
-@param vista Puntero a la QGraphicsView donde se renderiza el juego. No puede ser nulo.
+Registra una tarea en el bucle central (fase `FaseCamara`) que avanza la posición de la cámara
+en cada paso de simulación, y se conecta a `BucleJuego::antesDePintar` para colocar la vista una
+vez por frame con la posición interpolada entre los dos últimos pasos.
+@param vista Puntero a la QGraphicsView donde se renderiza el juego, o `nullptr` para simular sin vista.
 @param parent Objeto padre en la jerarquía de Qt. Si no se especifica, se asume nullptr.
 */
 camaraLogica::camaraLogica(QGraphicsView *vista, QObject *parent)
     : QObject(parent), view(vista)
 {
-    timer = new QTimer(this);
-    connect(timer, &QTimer::timeout, this, &camaraLogica::moverVista);
+    tarea = new TareaBucle(BucleJuego::FaseCamara, [this]() { actualizar(); }, this, "camara");
+
+    connect(BucleJuego::instancia(), &BucleJuego::antesDePintar, this, &camaraLogica::aplicarVista);
 }
 
 /**
 @brief Destructor de la clase camaraLogica.
-Detiene el temporizador interno que controla el seguimiento de la cámara para evitar que
+Detiene la tarea que controla el seguimiento de la cámara para evitar que
 la vista continúe actualizándose después de que el objeto haya sido destruido.
 Este método asegura una liberación segura de recursos y previene accesos no válidos
 a la vista del juego una vez que el nivel ha terminado o se está cerrando.
@@ -33,68 +37,252 @@ camaraLogica::~camaraLogica()
 
 /**
 @brief Activa el seguimiento automático de la cámara hacia el personaje objetivo.
-Inicia el temporizador interno que actualiza la posición de la vista aproximadamente
-60 veces por segundo (cada 16 ms), creando un movimiento suave y continuo de la cámara.
-Si el temporizador ya está activo, no realiza ninguna acción para evitar duplicaciones.
+Activa la tarea del bucle central que actualiza la posición de la cámara en cada paso de
+simulación (`BucleJuego::pasoMs`). La primera actualización coloca la cámara directamente
+sobre Goku, sin recorrido suave desde la posición anterior.
+Si la tarea ya está activa, no realiza ninguna acción para evitar duplicaciones.
 Este método debe ser llamado después de asociar un personaje mediante seguirAGoku()
 para que el efecto de cámara lateral comience a funcionar en el nivel.
 */
 void camaraLogica::iniciarMovimiento()
 {
-    if (!timer->isActive())
-        timer->start(16);   // ~60 FPS
+    if (!tarea->estaActiva()) {
+        colocarEnObjetivo();
+        tarea->iniciar(BucleJuego::pasoMs);
+    }
 }
 
 /**
 @brief Detiene el seguimiento automático de la cámara.
-Interrumpe el temporizador interno que actualiza la posición de la vista, deteniendo
-así cualquier movimiento adicional de la cámara. Si el temporizador ya está inactivo,
+Desactiva la tarea que actualiza la posición de la vista, deteniendo
+así cualquier movimiento adicional de la cámara. Si la tarea ya está inactiva,
 no realiza ninguna acción. Este método se utiliza para pausar o finalizar el efecto
 de seguimiento al cambiar de nivel o al cerrar el juego.
 */
 void camaraLogica::detenerMovimiento()
 {
-    if (timer->isActive())
-        timer->stop();
+    if (tarea->estaActiva())
+        tarea->detener();
 }
 
 /**
 @brief Asocia al personaje Goku como objetivo de seguimiento de la cámara.
 Establece el puntero al objeto Goku que la cámara debe seguir durante el desplazamiento
-del nivel. Una vez asignado, cualquier llamada a iniciarMovimiento() hará que la vista
-se centre automáticamente en la posición actual de Goku, manteniéndolo siempre visible
-en pantalla mientras avanza por el escenario.
+del nivel. Una vez asignado, cualquier llamada a iniciarMovimiento() hará que la cámara
+lo siga manteniéndolo siempre visible en pantalla mientras avanza por el escenario.
 @param goku Puntero al objeto Goku que se desea seguir. Debe ser válido y no nulo.
 */
 void camaraLogica::seguirAGoku(Goku *goku)
 {
     objetivo = goku;
+    colocarEnObjetivo();
 }
 
 /**
-@brief Actualiza la posición de la vista para seguir al personaje Goku.
-Este método es invocado automáticamente por el temporizador cada ~16 ms mientras el
-seguimiento está activo. Calcula la nueva posición centrada en Goku y aplica un
-desplazamiento lateral equivalente a la mitad del ancho visible, de modo que Goku
-aparezca alineado al borde izquierdo de la pantalla. Si Goku o la vista no están
-disponibles, la función se retorna sin efecto, garantizando estabilidad.
-@note El desplazamiento lateral crea la sensación de desplazamiento lateral continuo
-  del escenario, típico de los “side-scrollers”.
+@brief Coloca la cámara directamente sobre el objetivo, sin recorrido suave.
+Reinicia la anticipación y la interpolación; sin objetivo, la cámara queda sin posición.
 */
-void camaraLogica::moverVista()
+void camaraLogica::colocarEnObjetivo()
 {
-    //qDebug() << "timer camaralogica llamado  "<<contador++;
-    if (!objetivo || !view) return;
+    inicializada = false;
+    hayAplicada = false;
+    if (!objetivo) return;
 
-    // Obtener la posición de Goku
-    qreal xGoku = objetivo->x();
-    qreal yCentro = objetivo->y();
+    xGokuAnterior = objetivo->x();
+    adelanto = adelantoDeseado = 0;
+    actual = limitar(QPointF(objetivo->x() - ancla, objetivo->y() - tamanoZona().height() / 2.0));
+    anterior = actual;
+    inicializada = true;
+}
 
-    // Queremos que Goku esté al borde izquierdo, entonces
-    // centramos la vista en un punto desplazado a la derecha
-    qreal desplazamiento = view->viewport()->width() / 2.0;
+/**
+@brief Define a qué distancia del borde izquierdo se mantiene a Goku.
+@param ancla Distancia en píxeles de escena. No puede ser negativa.
+@throw std::invalid_argument Si `ancla` es negativa.
+*/
+void camaraLogica::setAncla(qreal ancla)
+{
+    if (ancla < 0)
+        throw std::invalid_argument("camaraLogica: el ancla no puede ser negativa.");
+    this->ancla = ancla;
+}
 
-    view->centerOn(xGoku + desplazamiento, yCentro);
+/**
+@brief Define el ancho de la zona muerta.
+Mientras Goku se mueva dentro de esa franja alrededor de su punto de anclaje, la cámara no se
+mueve; así los pequeños avances y retrocesos no hacen temblar el escenario.
+@param ancho Ancho de la franja en píxeles de escena. No puede ser negativo.
+@throw std::invalid_argument Si `ancho` es negativo.
+*/
+void camaraLogica::setZonaMuerta(qreal ancho)
+{
+    if (ancho < 0)
+        throw std::invalid_argument("camaraLogica: la zona muerta no puede ser negativa.");
+    zonaMuerta = ancho;
 }
 
+/**
+@brief Define cuánto se adelanta la cámara en la dirección en la que avanza Goku.
+El adelanto cambia de a poco (unos píxeles por paso) cuando Goku da la vuelta, para que el
+escenario no salte.
+@param distancia Adelanto máximo en píxeles de escena. No puede ser negativo.
+@throw std::invalid_argument Si `distancia` es negativa.
+*/
+void camaraLogica::setAnticipacion(qreal distancia)
+{
+    if (distancia < 0)
+        throw std::invalid_argument("camaraLogica: la anticipación no puede ser negativa.");
+    anticipacion = distancia;
+}
 
+/**
+@brief Define la suavidad del seguimiento.
+@param fraccion Fracción de la distancia al destino que la cámara recorre en cada paso; 1 la
+coloca de inmediato. Debe estar en (0, 1].
+@throw std::invalid_argument Si `fraccion` está fuera de rango.
+*/
+void camaraLogica::setSuavizado(qreal fraccion)
+{
+    if (fraccion <= 0 || fraccion > 1)
+        throw std::invalid_argument("camaraLogica: el suavizado debe estar en (0, 1].");
+    suavizado = fraccion;
+}
+
+/**
+@brief Avanza la cámara un paso de simulación.
+Se ejecuta en la fase `FaseCamara`, después de que Goku, los enemigos y el escenario se movieron.
+
+- El destino horizontal deja a Goku a `ancla` píxeles del borde izquierdo, desplazado por el
+  adelanto actual en la dirección en la que avanza.
+- Si el destino queda dentro de la zona muerta alrededor de la posición actual, la cámara no se
+  mueve en X; si sale, se acerca solo lo necesario para devolverlo al borde de la zona.
+- El destino vertical centra a Goku.
+- La cámara recorre una fracción `suavizado` de la distancia y no sale de los límites de la escena.
+
+La posición anterior se guarda para interpolar al pintar.
+*/
+void camaraLogica::actualizar()
+{
+    if (!objetivo) return;
+    if (!inicializada) {
+        colocarEnObjetivo();
+        return;
+    }
+
+    const QSizeF tam = tamanoZona();
+    const qreal xGoku = objetivo->x();
+    const qreal yGoku = objetivo->y();
+
+    // Anticipación: sigue a la última dirección de avance y cambia como mucho 2 px por paso
+    const qreal dx = xGoku - xGokuAnterior;
+    xGokuAnterior = xGoku;
+    if (dx > 0) adelantoDeseado = anticipacion;
+    else if (dx < 0) adelantoDeseado = -anticipacion;
+    const qreal maxCambio = 2.0;
+    adelanto += qBound(-maxCambio, adelantoDeseado - adelanto, maxCambio);
+
+    // Zona muerta horizontal alrededor del punto de anclaje
+    QPointF destino = actual;
+    const qreal diferencia = (xGoku - ancla + adelanto) - actual.x();
+    const qreal mitad = zonaMuerta / 2.0;
+    if (diferencia > mitad) destino.rx() += diferencia - mitad;
+    else if (diferencia < -mitad) destino.rx() += diferencia + mitad;
+
+    destino.setY(yGoku - tam.height() / 2.0);
+
+    anterior = actual;
+    actual = limitar(actual + (destino - actual) * suavizado);
+}
+
+/**
+@brief Coloca la vista en la posición de la cámara interpolada para este frame.
+Se ejecuta una vez por frame, antes del repintado. Interpola entre los dos últimos pasos con
+`BucleJuego::getAlfa()` y redondea a píxeles enteros; si la vista ya está en ese píxel no se
+llama a `centerOn()`, de modo que no se desplaza (ni se repinta) por movimientos menores a un
+píxel.
+*/
+void camaraLogica::aplicarVista()
+{
+    if (!view || !inicializada || !tarea->estaActiva()) return;
+
+    const double alfa = BucleJuego::instancia()->getAlfa();
+    const QPointF interpolada = anterior + (actual - anterior) * alfa;
+    const QPoint pixel = interpolada.toPoint();
+
+    if (hayAplicada && pixel == ultimaAplicada) return;
+
+    const QSizeF tam = tamanoZona();
+    view->centerOn(QPointF(pixel) + QPointF(tam.width() / 2.0, tam.height() / 2.0));
+    ultimaAplicada = pixel;
+    hayAplicada = true;
+}
+
+/**
+@brief Tamaño de la zona que muestra la cámara, en píxeles de escena.
+Es un tamaño lógico fijo y no el del viewport: el juego y el simulador calculan la misma zona
+aunque la vista real tenga bordes o cambie de tamaño.
+@return `anchoLogico` x `altoLogico`.
+*/
+QSizeF camaraLogica::tamanoZona() const
+{
+    return QSizeF(anchoLogico, altoLogico);
+}
+
+/**
+@brief Ajusta la esquina de la cámara para que no muestre nada fuera de la escena.
+Igual que `centerOn()`: si la escena es más chica que la vista en un eje, se centra en ese eje.
+@param esquina Esquina superior izquierda deseada.
+@return Esquina superior izquierda dentro de los límites de la escena.
+*/
+QPointF camaraLogica::limitar(const QPointF& esquina) const
+{
+    if (!objetivo || !objetivo->scene())
+        return esquina;
+
+    const QRectF limites = objetivo->scene()->sceneRect();
+    const QSizeF tam = tamanoZona();
+    QPointF resultado = esquina;
+
+    if (tam.width() >= limites.width())
+        resultado.setX(limites.center().x() - tam.width() / 2.0);
+    else
+        resultado.setX(qBound(limites.left(), esquina.x(), limites.right() - tam.width()));
+
+    if (tam.height() >= limites.height())
+        resultado.setY(limites.center().y() - tam.height() / 2.0);
+    else
+        resultado.setY(qBound(limites.top(), esquina.y(), limites.bottom() - tam.height()));
+
+    return resultado;
+}
+
+/**
+@brief Devuelve la zona de la escena que muestra la cámara según la simulación.
+
+Es la posición del último paso, no la interpolada que se pinta, así que no depende de la
+velocidad de los frames. Su tamaño es siempre `anchoLogico` x `altoLogico`, no el del viewport, así
+que con vista o sin ella (simulador) la misma partida da la misma zona.
+
+@return Rectángulo visible en coordenadas de escena.
+*/
+QRectF camaraLogica::zonaVisible() const
+{
+    if (!inicializada)
+        return QRectF(QPointF(0, 0), tamanoZona());
+    return QRectF(actual, tamanoZona());
+}
+
+/**
+@brief Devuelve la zona de la escena que la vista muestra en este momento.
+
+Incluye la interpolación y el redondeo de `aplicarVista()`; sirve para lo que se dibuja alineado
+con la vista, como el fondo por capas.
+
+@return Rectángulo del viewport en coordenadas de escena, o `zonaVisible()` sin vista.
+*/
+QRectF camaraLogica::zonaMostrada() const
+{
+    if (view)
+        return view->mapToScene(view->viewport()->rect()).boundingRect();
+    return zonaVisible();
+}
@@ -3,9 +3,19 @@
 
 #include <QObject>
 #include <QGraphicsView>
-#include <QTimer>
+#include <QPoint>
+#include <QPointF>
+#include <QRectF>
+#include <QSizeF>
 #include "goku.h"
+#include "buclejuego.h"
 
+/**
+ * Cámara lateral que sigue a Goku.
+ * Su posición es parte de la simulación: se actualiza en cada paso (FaseCamara) con zona muerta,
+ * anticipación en la dirección de avance y un seguimiento suave. Al pintar, la vista se coloca
+ * interpolando entre los dos últimos pasos, y solo se mueve si cambia al menos un píxel.
+ */
 class camaraLogica : public QObject
 {
     Q_OBJECT
@@ -19,16 +29,44 @@ public:
     void iniciarMovimiento();
     void detenerMovimiento();
     void seguirAGoku(Goku* goku);
+    QRectF zonaVisible() const;   // Lo que muestra la cámara según la simulación, con o sin vista real
+    QRectF zonaMostrada() const;  // Lo que la vista muestra ahora (interpolado); sin vista, igual a zonaVisible
+
+    // Ajustes del seguimiento (en píxeles de escena)
+    void setAncla(qreal ancla);                   // Distancia de Goku al borde izquierdo
+    void setZonaMuerta(qreal ancho);              // Ancho dentro del cual Goku se mueve sin mover la cámara
+    void setAnticipacion(qreal distancia);        // Cuánto se adelanta la cámara hacia donde va Goku
+    void setSuavizado(qreal fraccion);            // Fracción de la distancia que se recorre por paso (0, 1]
+
+    static constexpr int anchoLogico = 1536;   // Tamaño de la zona de juego, con vista o sin ella
+    static constexpr int altoLogico = 784;
 
 private slots:
-    void moverVista();
+    void actualizar();            // Un paso de simulación
+    void aplicarVista();          // Una vez por frame, antes del repintado
 
 private:
+    void colocarEnObjetivo();     // Salta a Goku sin suavizado
+    QSizeF tamanoZona() const;
+    QPointF limitar(const QPointF& esquina) const;
+
     QGraphicsView *view;
-    QTimer *timer;
+    TareaBucle *tarea;
     Goku *objetivo = nullptr;
 
+    qreal ancla = 200;
+    qreal zonaMuerta = 80;
+    qreal anticipacion = 150;
+    qreal suavizado = 0.1;
 
+    QPointF anterior;             // Esquina superior izquierda en el paso anterior
+    QPointF actual;               // Esquina superior izquierda en el último paso
+    bool inicializada = false;
+    qreal xGokuAnterior = 0;
+    qreal adelanto = 0;           // Anticipación actual, que se acerca de a poco a la deseada
+    qreal adelantoDeseado = 0;
+    QPoint ultimaAplicada;        // Última posición entera que recibió la vista
+    bool hayAplicada = false;
 };
 
 #endif // CAMARALOGICA_H
@@ -0,0 +1,216 @@
+#include "capahud.h"
+#include "perfilador.h"
+#include "rastreomemoria.h"
+#include <QVariant>
+#include <algorithm>
+#include <vector>
+#include <stdexcept>  // Excepciones estándar
+
+namespace {
+// Propiedad de la escena donde queda registrada su capa de HUD
+const char* const propiedadHud = "capaHud";
+
+// Difumina en el lugar un canal de 8 bits con una caja de `radio` píxeles (una pasada por eje)
+void difuminar(std::vector<int>& canal, int ancho, int alto, int radio)
+{
+    std::vector<int> temporal(canal.size());
+    const int lado = 2 * radio + 1;
+
+    for (int y = 0; y < alto; ++y) {
+        int suma = 0;
+        for (int x = -radio; x <= radio; ++x)
+            suma += canal[y * ancho + qBound(0, x, ancho - 1)];
+        for (int x = 0; x < ancho; ++x) {
+            temporal[y * ancho + x] = suma / lado;
+            suma += canal[y * ancho + qMin(x + radio + 1, ancho - 1)];
+            suma -= canal[y * ancho + qMax(x - radio, 0)];
+        }
+    }
+
+    for (int x = 0; x < ancho; ++x) {
+        int suma = 0;
+        for (int y = -radio; y <= radio; ++y)
+            suma += temporal[qBound(0, y, alto - 1) * ancho + x];
+        for (int y = 0; y < alto; ++y) {
+            canal[y * ancho + x] = suma / lado;
+            suma += temporal[qMin(y + radio + 1, alto - 1) * ancho + x];
+            suma -= temporal[qMax(y - radio, 0) * ancho + x];
+        }
+    }
+}
+}
+
+/**
+@brief Constructor de un elemento del HUD.
+
+@param parent Objeto padre (normalmente la `CapaHud` del nivel).
+*/
+ElementoHud::ElementoHud(QObject* parent)
+    : QObject(parent)
+{
+}
+
+/**
+@brief Dibuja el elemento en su posición, generando antes su imagen si cambió.
+
+@param painter Pintor en coordenadas del viewport.
+*/
+void ElementoHud::dibujar(QPainter* painter)
+{
+    if (sucio) {
+        ETIQUETA_MEMORIA(MemoriaHud);
+        imagen = renderizar();
+        sucio = false;
+        ++renderizados;
+    }
+
+    painter->drawPixmap(posicion, imagen);
+}
+
+/**
+@brief Devuelve el contenido con una sombra negra difuminada debajo.
+
+La sombra se calcula una sola vez por imagen generada, a partir del canal alfa del contenido,
+con un difuminado de caja en dos pasadas. La imagen resultante tiene el margen necesario para
+que la sombra no se corte.
+
+@param contenido Imagen con transparencia (formato ARGB32 premultiplicado).
+@param desplazamiento Desplazamiento de la sombra respecto del contenido.
+@param radio Radio del difuminado en píxeles.
+@return Imagen con la sombra y el contenido, con `radio` píxeles de margen arriba y a la izquierda.
+*/
+QImage ElementoHud::conSombra(const QImage& contenido, const QPoint& desplazamiento, int radio)
+{
+    const QImage origen = contenido.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    const int margen = radio;
+    const int ancho = origen.width() + 2 * margen + qAbs(desplazamiento.x());
+    const int alto = origen.height() + 2 * margen + qAbs(desplazamiento.y());
+
+    // Alfa del contenido, ya desplazado, en un lienzo con margen para el difuminado
+    std::vector<int> alfa(static_cast<std::size_t>(ancho) * alto, 0);
+    const int dx = margen + qMax(0, desplazamiento.x());
+    const int dy = margen + qMax(0, desplazamiento.y());
+    for (int y = 0; y < origen.height(); ++y) {
+        const QRgb* linea = reinterpret_cast<const QRgb*>(origen.constScanLine(y));
+        for (int x = 0; x < origen.width(); ++x)
+            alfa[(y + dy) * ancho + x + dx] = qAlpha(linea[x]);
+    }
+
+    if (radio > 0)
+        difuminar(alfa, ancho, alto, radio);
+
+    QImage resultado(ancho, alto, QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < alto; ++y) {
+        QRgb* linea = reinterpret_cast<QRgb*>(resultado.scanLine(y));
+        for (int x = 0; x < ancho; ++x)
+            linea[x] = qRgba(0, 0, 0, alfa[y * ancho + x]);
+    }
+
+    QPainter painter(&resultado);
+    painter.drawImage(margen + qMax(0, -desplazamiento.x()), margen + qMax(0, -desplazamiento.y()), origen);
+    return resultado;
+}
+
+/**
+@brief Constructor de la capa del HUD.
+
+Registra la capa en la escena para que la vista la encuentre al pintar.
+
+@param escena Escena del nivel. No puede ser nula.
+@param parent Objeto padre en la jerarquía de Qt (normalmente el nivel).
+
+@throw std::invalid_argument Si la escena es nula.
+*/
+CapaHud::CapaHud(QGraphicsScene* escena, QObject* parent)
+    : QObject(parent), escena(escena)
+{
+    if (!escena)
+        throw std::invalid_argument("CapaHud: la escena no puede ser nula.");
+
+    escena->setProperty(propiedadHud, QVariant::fromValue<QObject*>(this));
+}
+
+/**
+@brief Destructor: quita el registro de la escena si sigue apuntando a esta capa.
+*/
+CapaHud::~CapaHud()
+{
+    if (deEscena(escena) == this)
+        escena->setProperty(propiedadHud, QVariant());
+}
+
+/**
+@brief Agrega un elemento para que se dibuje en cada frame.
+
+La capa no es dueña del elemento: si se destruye antes, simplemente deja de dibujarse.
+
+@param elemento Elemento a agregar; los nulos se ignoran.
+*/
+void CapaHud::agregar(ElementoHud* elemento)
+{
+    if (elemento && !elementos.contains(elemento))
+        elementos.append(elemento);
+}
+
+/**
+@brief Dibuja todos los elementos vivos, en el orden en que se agregaron.
+
+@param painter Pintor en coordenadas del viewport.
+*/
+void CapaHud::dibujar(QPainter* painter)
+{
+    ZONA_PERFIL("hud");
+    for (const QPointer<ElementoHud>& elemento : std::as_const(elementos)) {
+        if (elemento)
+            elemento->dibujar(painter);
+    }
+}
+
+/**
+@brief Zona de la ventana que ocupan los elementos ya dibujados.
+
+La vista la repinta cuando desplaza el viewport: el HUD está fijo y no puede desplazarse con
+la escena.
+
+@return Unión de los rectángulos de los elementos, en coordenadas del viewport.
+*/
+QRegion CapaHud::zona() const
+{
+    QRegion region;
+    for (const QPointer<ElementoHud>& elemento : elementos) {
+        if (elemento)
+            region += elemento->zona();
+    }
+    return region;
+}
+
+/**
+@brief Zona de los elementos cuyo valor cambió y todavía no se volvieron a dibujar.
+
+Con los modos de repintado parcial, la escena no sabe nada del HUD: `BucleJuego` pide
+repintar esta zona al cerrar cada frame. Un elemento que nunca se dibujó tiene zona vacía (su
+primer pintado llega con el de toda la ventana).
+
+@return Unión de los rectángulos sucios, en coordenadas del viewport.
+*/
+QRegion CapaHud::zonaSucia() const
+{
+    QRegion region;
+    for (const QPointer<ElementoHud>& elemento : elementos) {
+        if (elemento && elemento->estaSucio())
+            region += elemento->zona();
+    }
+    return region;
+}
+
+/**
+@brief Devuelve la capa de HUD registrada en una escena.
+
+@param escena Escena a consultar.
+@return La capa de la escena, o `nullptr` si no tiene.
+*/
+CapaHud* CapaHud::deEscena(const QGraphicsScene* escena)
+{
+    if (!escena) return nullptr;
+    return qobject_cast<CapaHud*>(escena->property(propiedadHud).value<QObject*>());
+}
@@ -0,0 +1,77 @@
+#ifndef CAPAHUD_H
+#define CAPAHUD_H
+
+#include <QObject>
+#include <QGraphicsScene>
+#include <QImage>
+#include <QPainter>
+#include <QPixmap>
+#include <QPoint>
+#include <QPointer>
+#include <QRegion>
+#include <QVector>
+
+/**
+ * Elemento del HUD (vida, progreso) que se dibuja desde una imagen guardada.
+ * La imagen, con sus sombras ya incluidas, se vuelve a generar solo cuando la subclase llama a
+ * invalidar() porque cambió lo que muestra; el resto de los frames solo se copia a la vista.
+ */
+class ElementoHud : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ElementoHud(QObject* parent = nullptr);
+
+    void setPosicion(const QPoint& posicion) { this->posicion = posicion; }
+    QPoint getPosicion() const { return posicion; }
+    void dibujar(QPainter* painter);         // En coordenadas del viewport
+    QRect zona() const { return QRect(posicion, imagen.size()); }
+    bool estaSucio() const { return sucio; }
+
+    int getRenderizados() const { return renderizados; }
+
+protected:
+    virtual QPixmap renderizar() const = 0;  // Solo se llama cuando el elemento está sucio
+    void invalidar() { sucio = true; }
+
+    // Agrega una sombra difuminada debajo del contenido (reemplaza a QGraphicsDropShadowEffect)
+    static QImage conSombra(const QImage& contenido, const QPoint& desplazamiento, int radio);
+
+private:
+    QPoint posicion;
+    QPixmap imagen;
+    bool sucio = true;
+    int renderizados = 0;
+};
+
+/**
+ * HUD de un nivel: la lista de elementos que la vista dibuja en drawForeground().
+ * Queda registrada en la escena (como FondoParalaje), así que la vista no necesita conocer al
+ * nivel. Sin vista los elementos siguen guardando sus valores y nunca se dibujan.
+ */
+class CapaHud : public QObject
+{
+    Q_OBJECT
+
+public:
+    CapaHud(QGraphicsScene* escena, QObject* parent = nullptr);
+    ~CapaHud();
+
+    void agregar(ElementoHud* elemento);
+    void dibujar(QPainter* painter);
+    QRegion zona() const;                   // Lo que ocupa el HUD en la ventana
+    QRegion zonaSucia() const;              // Elementos que cambiaron desde el último pintado
+
+    static CapaHud* deEscena(const QGraphicsScene* escena);   // nullptr si la escena no tiene
+
+private:
+    QGraphicsScene* escena;
+    QVector<QPointer<ElementoHud>> elementos;
+
+    // Bloqueamos copia y asignación
+    CapaHud(const CapaHud&) = delete;
+    CapaHud& operator=(const CapaHud&) = delete;
+};
+
+#endif // CAPAHUD_H
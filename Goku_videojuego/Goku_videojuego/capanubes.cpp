@@ -0,0 +1,117 @@
+#include "capanubes.h"
+#include "azarjuego.h"
+#include <stdexcept>  // Excepciones estándar
+
+/**
+@brief Constructor de la capa de nubes.
+
+Los límites del item se fijan aquí y no cambian: cubren el ancho de la escena más una nube a
+la izquierda (las que están saliendo) y el alto de reaparición más la nube más alta.
+
+@param escalas Imágenes de la nube en cada tamaño; no puede estar vacía ni tener más de 256.
+@param anchoEscena Ancho de la escena; las nubes que salen por la izquierda reaparecen aquí.
+@param parent Item padre opcional.
+
+@throw std::invalid_argument Si no hay imágenes o alguna es nula.
+*/
+CapaNubes::CapaNubes(const QVector<QPixmap>& escalas, qreal anchoEscena, QGraphicsItem* parent)
+    : QGraphicsItem(parent), escalas(escalas), anchoEscena(anchoEscena)
+{
+    if (escalas.isEmpty() || escalas.size() > 256)
+        throw std::invalid_argument("CapaNubes: cantidad de imágenes no válida.");
+
+    qreal anchoMax = 0;
+    qreal altoMax = 0;
+    for (const QPixmap& imagen : escalas) {
+        if (imagen.isNull())
+            throw std::invalid_argument("CapaNubes: imagen de nube nula.");
+        anchoMax = qMax<qreal>(anchoMax, imagen.width());
+        altoMax = qMax<qreal>(altoMax, imagen.height());
+    }
+
+    limites = QRectF(-anchoMax, 0, anchoEscena + anchoMax, yMaxReaparicion + altoMax);
+
+    // El pintado usa exposedRect para saltarse las nubes fuera de la zona a repintar
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+}
+
+/**
+@brief Agrega una nube a la capa.
+
+@param x Coordenada X de la esquina superior izquierda.
+@param y Coordenada Y de la esquina superior izquierda.
+@param escala Índice de la imagen a usar dentro de `escalas`.
+
+@throw std::out_of_range Si el índice no corresponde a ninguna imagen.
+*/
+void CapaNubes::agregar(qreal x, qreal y, int escala)
+{
+    if (escala < 0 || escala >= escalas.size())
+        throw std::out_of_range("CapaNubes::agregar - índice de escala fuera de rango.");
+
+    xs.push_back(static_cast<float>(x));
+    ys.push_back(static_cast<float>(y));
+    anchos.push_back(static_cast<float>(escalas[escala].width()));
+    indices.push_back(static_cast<quint8>(escala));
+    update();
+}
+
+/**
+@brief Mueve todas las nubes `dx` píxeles a la izquierda.
+
+El desplazamiento es un recorrido plano sobre `xs` sin ramas, que el compilador puede
+vectorizar. Luego, en un segundo recorrido, las nubes que salieron completamente por la
+izquierda reaparecen en el borde derecho de la escena con una altura aleatoria (igual que las
+nubes sueltas de antes). Al final se pide una única actualización del item.
+
+@param dx Píxeles a desplazar.
+*/
+void CapaNubes::avanzar(qreal dx)
+{
+    const float paso = static_cast<float>(dx);
+    const std::size_t n = xs.size();
+    float* x = xs.data();
+
+    for (std::size_t i = 0; i < n; ++i)
+        x[i] -= paso;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        if (x[i] + anchos[i] < 0) {
+            x[i] = static_cast<float>(anchoEscena);
+            ys[i] = static_cast<float>(AzarJuego::generador()->bounded(0, yMaxReaparicion));
+        }
+    }
+
+    update();
+}
+
+/**
+@brief Rectángulo que ocupa la capa, fijo desde la construcción.
+*/
+QRectF CapaNubes::boundingRect() const
+{
+    return limites;
+}
+
+/**
+@brief Dibuja las nubes que tocan la zona expuesta.
+
+@param painter Pintor en coordenadas del item.
+@param option Opciones de estilo; `exposedRect` indica qué parte hay que repintar.
+@param widget No se usa.
+*/
+void CapaNubes::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
+{
+    Q_UNUSED(widget);
+
+    const QRectF expuesto = option->exposedRect;
+    const std::size_t n = xs.size();
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const QPixmap& imagen = escalas[indices[i]];
+        const QRectF nube(xs[i], ys[i], imagen.width(), imagen.height());
+        if (!expuesto.intersects(nube)) continue;
+
+        painter->drawPixmap(nube.topLeft(), imagen);
+    }
+}
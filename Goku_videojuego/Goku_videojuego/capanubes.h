@@ -0,0 +1,49 @@
+#ifndef CAPANUBES_H
+#define CAPANUBES_H
+
+#include <QGraphicsItem>
+#include <QPainter>
+#include <QPixmap>
+#include <QRectF>
+#include <QStyleOptionGraphicsItem>
+#include <QVector>
+#include <vector>
+#include "arenanivel.h"
+
+/**
+ * Todas las nubes de un nivel en un solo item.
+ * Las posiciones se guardan en arreglos planos y se mueven en un único recorrido; las nubes
+ * comparten unas pocas imágenes ya escaladas. Cada tick cuesta una sola actualización de la
+ * escena en lugar de un setPos() por nube.
+ */
+class CapaNubes : public QGraphicsItem
+{
+public:
+    ENTIDAD_DE_NIVEL
+    static const int yMaxReaparicion = 100;   // Las nubes que reaparecen lo hacen entre 0 y este alto
+
+    CapaNubes(const QVector<QPixmap>& escalas, qreal anchoEscena, QGraphicsItem* parent = nullptr);
+
+    void agregar(qreal x, qreal y, int escala);   // escala: índice en las imágenes compartidas
+    void avanzar(qreal dx);                       // Mueve todas hacia la izquierda y recicla las que salen
+    int cantidad() const { return static_cast<int>(xs.size()); }
+
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;
+
+private:
+    QVector<QPixmap> escalas;      // Una imagen por tamaño, compartida por todas las nubes
+    qreal anchoEscena;
+    QRectF limites;
+
+    std::vector<float> xs;         // Estructura de arreglos: una entrada por nube
+    std::vector<float> ys;
+    std::vector<float> anchos;
+    std::vector<quint8> indices;
+
+    // Bloqueamos copia y asignación
+    CapaNubes(const CapaNubes&) = delete;
+    CapaNubes& operator=(const CapaNubes&) = delete;
+};
+
+#endif // CAPANUBES_H
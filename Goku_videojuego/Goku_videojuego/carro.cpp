@@ -1,4 +1,5 @@
 #include "carro.h"
+#include "spritecache.h"
 
 // Inicialización del contador
 int Carro::contador = 0;
@@ -7,10 +8,10 @@ int Carro::contCarro=0;
 /**
 @brief Constructor de la clase Carro.
 Inicializa un objeto Carro como obstáculo especial de tipo Roca en la escena
-especificada. Carga su sprite desde un sprite-sheet horizontal ("carro_rojo.png"),
-establece el primer frame visible y prepara el temporizador que controlará su
+especificada. Toma de la caché de sprites los cuadros del sprite-sheet horizontal ("carro_rojo.png"),
+establece el primer frame visible y registra la tarea del bucle central que controlará su
 animación de movimiento en espiral (usada cuando Goku lo patea en el Nivel 1).
-Además, etiqueta el sprite como "carro" para facilitar las detecciones de colisión
+Además, cambia el tipo de su cuerpo en el mundo de colisiones a `EntidadCarro`
 y contabiliza la creación del carro mediante un contador estático.
 @param scene Escena gráfica donde se insertará el carro. No puede ser nula.
 @param velocidad Velocidad inicial del carro (heredada de obstáculo) – no se usa
@@ -20,41 +21,42 @@ y contabiliza la creación del carro mediante un contador estático.
 Carro::Carro(QGraphicsScene *scene, int velocidad, QObject *parent)
     : obstaculo(scene, obstaculo::Roca, velocidad, parent), anguloActual(0), girando(false)
 {
-    imagenCarro = QPixmap(":/images/carro_rojo.png"); // sprite sheet del carro desde los recursos
-
     cuadroActual = 0; // frmae[0]
 
     anchoCuadro = 400;
     altoCuadro = 251;
 
-    // Extrae el primer cuadro desde la imagen y lo aplica al sprite
-    QPixmap cuadro = imagenCarro.copy(cuadroActual * anchoCuadro, 0, anchoCuadro, altoCuadro);
-    sprite->setPixmap(cuadro);
+    // Los 3 cuadros de giro del sprite sheet, recortados una sola vez
+    frames = SpriteCache::instancia()->frames(":/images/carro_rojo.png", anchoCuadro, altoCuadro, 3);
+    if (!frames.isEmpty())
+        sprite->setPixmap(frames[cuadroActual]);
 
-    sprite->setData(0, "carro");
+    MundoColisiones::instancia()->setCategoria(cuerpo, EntidadCarro);
 
-    //conexion para el movimiento
-    timerEspiral = new QTimer(this);
-    connect(timerEspiral, &QTimer::timeout, this, &Carro::actualizarMovimiento);
+    //tareas para la rotacion y el movimiento
+    tareaRotacion = new TareaBucle(BucleJuego::FaseEscenario, [this]() { animarRotacion(); }, this, "animarRotacion");
+    tareaEspiral = new TareaBucle(BucleJuego::FaseEscenario, [this]() { actualizarMovimiento(); }, this, "actualizarMovimiento");
     contCarro+=1;
     //qDebug()<<"creo carro constructor "<<contCarro;
 }
 
 /**
 @brief Destructor de la clase Carro.
-Libera los recursos asociados al carro, deteniendo el temporizador encargado de su
-movimiento en espiral y eliminando el objeto correspondiente. Reduce en uno el contador
+Libera los recursos asociados al carro, deteniendo las tareas encargadas de su
+rotación y movimiento en espiral y quitándolas del bucle central. Reduce en uno el contador
 estático que lleva la cuenta total de instancias de Carro existentes, lo que facilita
 el seguimiento de su ciclo de vida durante la ejecución del juego.
 @note El sprite es eliminado por la clase base obstáculo; aquí solo se gestiona el
-  temporizador específico del carro.
+  tareas específicas del carro.
 */
 Carro::~Carro() {
     //qDebug() << "Destructor de carro llamado";
     contCarro-=1;
     //qDebug()<<"libero carro desstructor "<<contCarro;
-    timerEspiral->stop();
-    delete timerEspiral; // Eliminar el temporizador creado con new
+    tareaRotacion->detener();
+    delete tareaRotacion;
+    tareaEspiral->detener();
+    delete tareaEspiral; // Eliminar la tarea creada con new
 }
 
 /**
@@ -69,23 +71,24 @@ de movimiento o interacción con el jugador.
 void Carro::iniciar(int x, int y)
 {
     sprite->setPos(x, y);
+    MundoColisiones::instancia()->actualizar(cuerpo);
 }
 
 /**
 @brief Inicia la animación de rotación del carro.
-Activa el temporizador responsable de alternar los cuadros del sprite para simular
+Activa la tarea responsable de alternar los cuadros del sprite para simular
 que el carro está girando sobre sí mismo. Solo procede si el carro no se encuentra
 ya en estado de rotación, evitando así reinicios innecesarios o superposiciones de
-temporizadores. Este efecto visual se utiliza cuando el carro es pateado por Goku
+tareas. Este efecto visual se utiliza cuando el carro es pateado por Goku
 o durante secuencias específicas del nivel.
 @note La animación se ejecuta cada 150 ms hasta que se detenga externamente.
 */
 void Carro::rotar()
 {
-    // Si el carro no está girando, activa el temporizador para comenzar la animación
+    // Si el carro no está girando, activa la tarea para comenzar la animación
     if (!girando) {
         girando = true;                // Marca que ya está girando
-        timerRotacion->start(150);    // Cambia el cuadro de animación cada 150 milisegundos
+        tareaRotacion->iniciar(150);  // Cambia el cuadro de animación cada 150 milisegundos
     }
 }
 
@@ -107,7 +110,7 @@ primero una subida parabólica, luego un giro circular y, finalmente, una caída
 Solo se ejecuta si el carro no ha realizado ya la espiral y se encuentra en estado
 de reposo (fase 3). Se registra la posición horizontal exacta en la que Goku lo pateó
 para calcular un punto de inicio desplazado 1000 píxeles hacia la derecha, evitando
-que el vehículo pase por encima del personaje. El temporizador timerEspiral
+que el vehículo pase por encima del personaje. La tarea tareaEspiral del bucle central
 generará actualizaciones cada 20 ms para lograr un movimiento fluido.
 @param _posXpatada Posición en X del personaje Goku en el momento de la patada.
 */
@@ -125,12 +128,12 @@ void Carro::iniciarMovimientoEspiral(float _posXpatada)
     fase   = 0;                    // comenzamos con la fase de subida
     tiempo = 0.0f;
     inicio = sprite->pos();               // guardar posicion actual
-    timerEspiral->start(20);   // llama actualizarMovimiento() cada 20 ms
+    tareaEspiral->iniciar(20);   // llama actualizarMovimiento() cada 20 ms
 }
 
 /**
 @brief Actualiza la posición y rotación del carro durante su trayectoria espiral.
-Se ejecuta periódicamente (cada 20 ms) mientras el temporizador timerEspiral está activo.
+Se ejecuta periódicamente (cada 20 ms) mientras la tarea tareaEspiral está activa.
 Divide la animación en tres fases consecutivas:
 Subida parabólica: el carro asciende describiendo una parábola controlada por gravedad g
 y velocidades iniciales vx, vy. La coordenada horizontal se desplaza 127 píxeles para evitar
@@ -138,7 +141,7 @@ que el vehículo pase por encima de Goku.
 Giro circular: activa la animación de rotación mientras el carro describe un arco circular
 de radio radio y duración tiempoGiro.
 Caída libre: finalmente el carro cae verticalmente hasta alcanzar la altura ySuelo.
-Al finalizar la tercera fase se detiene el temporizador y se marca la animación como concluida
+Al finalizar la tercera fase se detiene la tarea y se marca la animación como concluida
 (fase 3), notificando al resto del juego que el carro ha tocado el suelo y que pueden proceder
 eventos posteriores (aparición de robots, cambio de estado, etc.).
 @note El método se apoya en animarRotacion() durante la fase circular para mostrar los frames
@@ -188,9 +191,11 @@ void Carro::actualizarMovimiento()
         if (y >= ySuelo) {
             sprite->setY(ySuelo);
             fase = 3;
-            timerEspiral->stop();  // se acabó la animación
+            tareaEspiral->detener();  // se acabó la animación
         }
     }
+
+    MundoColisiones::instancia()->actualizar(cuerpo);
 }
 
 /**
@@ -203,10 +208,10 @@ al alcanzar el último frame, asegurando una animación fluida y sin interrupcio
 void Carro::animarRotacion()
 {
     // frame ya existente:
-    cuadroActual = (cuadroActual + 1) % 3;
-    QPixmap cuadro = imagenCarro.copy(cuadroActual * anchoCuadro, 0,
-                                      anchoCuadro, altoCuadro);
-    sprite->setPixmap(cuadro);
+    if (frames.isEmpty()) return;
+
+    cuadroActual = (cuadroActual + 1) % frames.size();
+    sprite->setPixmap(frames[cuadroActual]);
 }
 
 /**
@@ -2,7 +2,6 @@
 #define CARRO_H
 
 #include "obstaculo.h"
-#include <QTimer>
 
 class Carro : public obstaculo
 {
@@ -28,11 +27,10 @@ private slots:
     void animarRotacion();                //implementar
 
 private:
-    QPixmap imagenCarro;           // Imagen completa que contiene las vistas del carro
     int cuadroActual;              // indice del cuadro actual
     int anchoCuadro;               // Ancho de cada cuadro
     int altoCuadro;                // Alto de cada cuadro
-    QTimer *timerRotacion;         // Temporizador para animacion
+    TareaBucle *tareaRotacion;     // Tarea del bucle para animacion
     int anguloActual;              // angulo
     bool girando;
 
@@ -48,7 +46,7 @@ private:
     float radio  = 120.0f;   // radio del giro
     float tiempoGiro = 2.0f;  // cuanto dura el giro
     float ySuelo = 500.0f;   // altura del suelo
-    QTimer *timerEspiral;  // timer para mvto
+    TareaBucle *tareaEspiral;  // tarea del bucle para mvto
     float posXpatada=0;
 
 };
@@ -0,0 +1,185 @@
+#include "cintaobstaculos.h"
+#include "camaralogica.h"
+#include "azarjuego.h"
+#include <QtGlobal>
+#include <stdexcept>  // Excepciones estándar
+
+/**
+@brief Constructor de la cinta de obstáculos.
+
+Crea de una vez los `tamVentana` obstáculos que se van a reciclar durante todo el nivel. Quedan
+ocultos y detenidos hasta que se llama a `iniciar()`.
+
+@param escena Escena donde se colocan los obstáculos. No puede ser nula.
+@param camara Cámara del nivel; define qué obstáculos siguen visibles. Si es nula se usa el rectángulo de la escena.
+@param tamVentana Cantidad máxima de obstáculos vivos al mismo tiempo.
+@param velocidad Velocidad de desplazamiento de los obstáculos.
+@param parent Objeto padre en la jerarquía de Qt.
+
+@throw std::invalid_argument Si la escena es nula o la ventana no tiene al menos un obstáculo.
+*/
+CintaObstaculos::CintaObstaculos(QGraphicsScene* escena, camaraLogica* camara, int tamVentana,
+                                 int velocidad, QObject* parent)
+    : QObject(parent),
+    escena(escena),
+    camara(camara),
+    tarea(nullptr)
+{
+    if (!escena)
+        throw std::invalid_argument("CintaObstaculos: la escena no puede ser nula.");
+
+    if (tamVentana <= 0)
+        throw std::invalid_argument("CintaObstaculos: la ventana debe tener al menos un obstáculo.");
+
+    obstaculos.reserve(tamVentana);
+    for (int i = 0; i < tamVentana; ++i) {
+        obstaculo* obs = new obstaculo(escena, obstaculo::Roca, velocidad, this);
+        obs->retirar();
+        obstaculos.push_back(obs);
+    }
+
+    // Revisión periódica de la ventana; no necesita la precisión del movimiento
+    tarea = new TareaBucle(BucleJuego::FaseEscenario, [this]() { revisar(); }, this, "revisar");
+}
+
+/**
+@brief Destructor de la cinta.
+
+Detiene la revisión y destruye todos los obstáculos de la ventana.
+*/
+CintaObstaculos::~CintaObstaculos()
+{
+    detener();
+
+    for (obstaculo* obs : obstaculos)
+        delete obs;
+    obstaculos.clear();
+}
+
+/**
+@brief Coloca la primera tanda de obstáculos y empieza a reciclarlos.
+
+Los obstáculos se reparten desde `xInicial` con la misma separación por tipo que tenía el nivel
+original (500 px después de un ave, 600 después de una montaña y 700 después de una roca).
+
+@param xInicial Coordenada X del primer obstáculo.
+@param total Cantidad de obstáculos que tendrá el recorrido; un valor negativo hace el nivel infinito.
+*/
+void CintaObstaculos::iniciar(int xInicial, int total)
+{
+    this->total = total;
+    colocados = 0;
+    ultimo = nullptr;
+
+    int x = xInicial;
+    for (obstaculo* obs : obstaculos) {
+        if (total >= 0 && colocados >= total) break;
+
+        colocar(obs, x);
+        x += separacion(obs->getTipo());
+    }
+
+    tarea->iniciar(100);
+}
+
+/**
+@brief Detiene la revisión de la ventana. Los obstáculos en vuelo siguen moviéndose.
+*/
+void CintaObstaculos::detener()
+{
+    if (tarea && tarea->estaActiva())
+        tarea->detener();
+}
+
+/**
+@brief Recicla los obstáculos que quedaron detrás de la cámara.
+
+Se ejecuta periódicamente desde el bucle central:
+
+- Un obstáculo cuyo borde derecho quedó a la izquierda de la vista se retira.
+- Cada obstáculo libre (retirado, o que salió por el borde de la escena) se vuelve a colocar
+  delante del último, o justo fuera del borde derecho de la vista si eso queda más adelante.
+- Cuando el nivel es finito y ya se colocaron todos, los libres se quedan ocultos.
+*/
+void CintaObstaculos::revisar()
+{
+    const QRectF zona = zonaVisible();
+
+    for (obstaculo* obs : obstaculos) {
+        QGraphicsPixmapItem* sprite = obs->getSprite();
+
+        if (sprite->isVisible() && obs->estaActivo() && sprite->sceneBoundingRect().right() < zona.left())
+            obs->retirar();
+
+        if (sprite->isVisible()) continue;
+        if (total >= 0 && colocados >= total) continue;
+
+        qreal x = zona.right() + 100;
+        if (ultimo && ultimo->getSprite()->isVisible())
+            x = qMax(x, ultimo->getSprite()->x() + separacion(ultimo->getTipo()));
+
+        colocar(obs, static_cast<int>(x));
+    }
+}
+
+/**
+@brief Asigna un tipo aleatorio al obstáculo y lo pone en marcha en la coordenada indicada.
+
+La altura depende del tipo, igual que en el nivel original: las aves vuelan entre 100 y 150 px,
+las montañas se apoyan en la base de la escena y las rocas quedan entre 350 y 550 px.
+
+@param obs Obstáculo de la ventana que se va a colocar.
+@param x Coordenada X en la escena.
+*/
+void CintaObstaculos::colocar(obstaculo* obs, int x)
+{
+    QRandomGenerator* azar = AzarJuego::generador();
+    const obstaculo::Tipo tipo = static_cast<obstaculo::Tipo>(azar->bounded(0, 3));
+
+    obs->reconfigurar(tipo);
+
+    int y = 0;
+    switch (tipo) {
+    case obstaculo::Ave:
+        y = azar->bounded(100, 150);
+        break;
+    case obstaculo::Montania:
+        y = static_cast<int>(escena->height()) - obs->getAltura();
+        break;
+    default:
+        y = azar->bounded(350, 550);
+        break;
+    }
+
+    obs->iniciar(x, y);
+    ultimo = obs;
+    ++colocados;
+}
+
+/**
+@brief Devuelve la zona de la escena que muestra la cámara.
+
+@return Rectángulo visible en coordenadas de escena, o el rectángulo de la escena si no hay cámara.
+*/
+QRectF CintaObstaculos::zonaVisible() const
+{
+    if (!camara)
+        return escena->sceneRect();
+
+    return camara->zonaVisible();
+}
+
+/**
+@brief Distancia horizontal que se deja después de un obstáculo de cierto tipo.
+
+@param tipo Tipo del obstáculo ya colocado.
+@return Separación en píxeles hasta el siguiente obstáculo.
+*/
+int CintaObstaculos::separacion(obstaculo::Tipo tipo) const
+{
+    switch (tipo) {
+    case obstaculo::Ave:      return 500;
+    case obstaculo::Montania: return 600;
+    default:                  return 700;
+    }
+}
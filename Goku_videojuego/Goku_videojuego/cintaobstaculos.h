@@ -0,0 +1,51 @@
+#ifndef CINTAOBSTACULOS_H
+#define CINTAOBSTACULOS_H
+
+#include <QObject>
+#include <QGraphicsScene>
+#include <QRectF>
+#include <vector>
+#include "buclejuego.h"
+#include "obstaculo.h"
+
+class camaraLogica;
+
+/**
+ * Generador continuo de obstáculos del Nivel 1.
+ * Mantiene una ventana fija de obstáculos vivos alrededor de la cámara: cuando uno sale de la
+ * vista por la izquierda se recicla con un tipo y una altura nuevos y se coloca delante del
+ * último. La cantidad de entidades no depende del largo del nivel, que puede ser infinito.
+ */
+class CintaObstaculos : public QObject
+{
+    Q_OBJECT
+
+public:
+    CintaObstaculos(QGraphicsScene* escena, camaraLogica* camara, int tamVentana = 5,
+                    int velocidad = 10, QObject* parent = nullptr);
+    ~CintaObstaculos();
+
+    void iniciar(int xInicial, int total);   // total < 0: nivel sin fin
+    void detener();
+
+private:
+    void revisar();                          // Recicla los que salieron de la vista
+    void colocar(obstaculo* obs, int x);
+    QRectF zonaVisible() const;
+    int separacion(obstaculo::Tipo tipo) const;
+
+    QGraphicsScene* escena;
+    camaraLogica* camara;
+    TareaBucle* tarea;
+
+    std::vector<obstaculo*> obstaculos;      // Ventana fija, creada una sola vez
+    obstaculo* ultimo = nullptr;             // El que está más adelante
+    int total = 0;
+    int colocados = 0;
+
+    // Bloqueamos copia y asignación
+    CintaObstaculos(const CintaObstaculos&) = delete;
+    CintaObstaculos& operator=(const CintaObstaculos&) = delete;
+};
+
+#endif // CINTAOBSTACULOS_H
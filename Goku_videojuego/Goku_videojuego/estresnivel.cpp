@@ -0,0 +1,286 @@
+#include "estresnivel.h"
+#include "nivel.h"
+#include "goku.h"
+#include "obstaculo.h"
+#include "explosion.h"
+#include "pocion.h"
+#include "robot.h"
+#include "azarjuego.h"
+#include "perfilador.h"
+#include "rastreomemoria.h"
+#include "spritecache.h"
+#include <QFile>
+#include <QGraphicsScene>
+#include <QStringList>
+#include <QTextStream>
+#include <QDebug>
+#include <stdexcept>  // Excepciones estándar
+
+/**
+@brief Constructor del modo estrés.
+
+Debe crearse después de `iniciarNivel()`. Vuelve invulnerable a Goku, agrega la primera tanda de
+entidades y registra en el bucle central dos tareas: una que cierra cada etapa (`msPorEtapa`) y
+otra que cada 100 ms vuelve a lanzar las aves y explosiones que salieron de la escena. Si la
+configuración tiene un archivo, lo crea con la cabecera del CSV.
+
+@param nivel Nivel ya iniciado; también es el padre, así que el modo estrés muere con él.
+@param config Cantidades finales, etapas y archivo de salida.
+
+@throw std::invalid_argument Si el nivel es nulo o las etapas no tienen cantidad o duración positivas.
+@throw std::runtime_error Si no se puede crear el archivo CSV.
+*/
+EstresNivel::EstresNivel(Nivel* nivel, const ConfigEstres& config)
+    : QObject(nivel), nivel(nivel), config(config)
+{
+    if (!nivel)
+        throw std::invalid_argument("EstresNivel: el nivel no puede ser nulo.");
+    if (config.etapas <= 0 || config.msPorEtapa <= 0)
+        throw std::invalid_argument("EstresNivel: las etapas deben tener cantidad y duración positivas.");
+
+    if (!config.archivo.isEmpty()) {
+        QFile archivo(config.archivo);
+        if (!archivo.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+            throw std::runtime_error(("EstresNivel: no se pudo crear " + config.archivo).toStdString());
+        QTextStream(&archivo) << "nivel,etapa,aves,explosiones,pociones,robots,items,pasos,ms_reales,"
+                                 "x_tiempo_real,frame_p50_ms,frame_p95_ms,frame_max_ms,memoria_kb\n";
+    }
+
+    if (Goku* goku = nivel->getGoku())
+        goku->setInvulnerable(true);
+
+    tareaEtapa = new TareaBucle(BucleJuego::FaseNivel, [this]() { siguienteEtapa(); }, this, "etapaEstres");
+    tareaReciclaje = new TareaBucle(BucleJuego::FaseNivel, [this]() { reciclar(); }, this, "reciclarEstres");
+
+    etapa = 1;
+    agregarHasta(etapa);
+
+    pasosInicioEtapa = BucleJuego::instancia()->getPasosTotales();
+    relojEtapa.start();
+    tareaEtapa->iniciar(config.msPorEtapa);
+    tareaReciclaje->iniciar(100);
+}
+
+/**
+@brief Destructor. Detiene las tareas y destruye las entidades agregadas.
+
+Las aves, explosiones y robots son hijos de este objeto; las pociones no tienen padre `QObject`
+y se destruyen a mano (al destruirse salen de la escena).
+*/
+EstresNivel::~EstresNivel()
+{
+    if (tareaEtapa) tareaEtapa->detener();
+    if (tareaReciclaje) tareaReciclaje->detener();
+
+    for (Pocion* pocion : pociones)
+        delete pocion;
+    pociones.clear();
+}
+
+/**
+@brief Lee la configuración del modo estrés desde la línea de comandos.
+
+El texto es una lista `clave=valor` separada por comas. Las claves son `aves`, `explosiones`,
+`pociones`, `robots`, `etapas` y `ms` (duración de cada etapa en ms de juego); las que faltan
+quedan con su valor por omisión.
+
+@param texto Por ejemplo `aves=2000,explosiones=500,pociones=1000,robots=100`.
+@return Configuración leída.
+
+@throw std::invalid_argument Si una clave no existe o un valor no es un entero válido.
+*/
+ConfigEstres EstresNivel::leerConfig(const QString& texto)
+{
+    ConfigEstres config;
+
+    for (const QString& parte : texto.split(',', Qt::SkipEmptyParts)) {
+        const QStringList claveValor = parte.split('=');
+        bool valido = claveValor.size() == 2;
+        const QString clave = claveValor.value(0).trimmed().toLower();
+        const int valor = claveValor.value(1).trimmed().toInt(&valido);
+
+        if (!valido || valor < 0) {
+            qCritical() << "EstresNivel: valor no válido en" << parte;
+            throw std::invalid_argument("EstresNivel: se espera 'clave=entero' no negativo.");
+        }
+
+        if (clave == "aves")             config.aves = valor;
+        else if (clave == "explosiones") config.explosiones = valor;
+        else if (clave == "pociones")    config.pociones = valor;
+        else if (clave == "robots")      config.robots = valor;
+        else if (clave == "etapas")      config.etapas = valor;
+        else if (clave == "ms")          config.msPorEtapa = valor;
+        else {
+            qCritical() << "EstresNivel: clave desconocida" << clave;
+            throw std::invalid_argument("EstresNivel: clave desconocida (aves, explosiones, pociones, robots, etapas o ms).");
+        }
+    }
+
+    return config;
+}
+
+/**
+@brief Cierra la etapa que terminó y, si quedan, agrega la tanda de la siguiente.
+
+Después de la última etapa las cantidades quedan fijas y se deja de medir.
+*/
+void EstresNivel::siguienteEtapa()
+{
+    medir();
+
+    if (etapa >= config.etapas) {
+        tareaEtapa->detener();
+        emit etapaMedida(QString("estres nivel %1: terminado, se mantienen las cantidades finales")
+                             .arg(nivel->getNumero()));
+        return;
+    }
+
+    ++etapa;
+    agregarHasta(etapa);
+
+    pasosInicioEtapa = BucleJuego::instancia()->getPasosTotales();
+    relojEtapa.restart();
+}
+
+/**
+@brief Agrega entidades hasta llegar a la fracción `etapa / etapas` de cada cantidad final.
+
+- Aves: repartidas a lo ancho de la escena, a la altura de las aves del nivel 1.
+- Explosiones: lanzadas desde puntos al azar, alternando tiro parabólico y rectilíneo.
+- Pociones: en la misma grilla de 7 columnas que usa el nivel 2.
+- Robots: caminan hacia la izquierda 300 px y se quedan animados.
+
+@param etapa Etapa que empieza (1 a `etapas`).
+*/
+void EstresNivel::agregarHasta(int etapa)
+{
+    ETIQUETA_MEMORIA(MemoriaNivel);
+    QGraphicsScene* escena = nivel->getEscena();
+    QRandomGenerator* azar = AzarJuego::generador();
+
+    auto objetivo = [&](int total) {
+        return static_cast<int>(static_cast<qint64>(total) * etapa / config.etapas);
+    };
+
+    while (static_cast<int>(aves.size()) < objetivo(config.aves)) {
+        obstaculo* ave = new obstaculo(escena, obstaculo::Ave, 10, this);
+        aves.push_back(ave);
+        lanzarAve(ave, false);
+    }
+
+    while (static_cast<int>(explosiones.size()) < objetivo(config.explosiones)) {
+        Explosion* explosion = new Explosion(escena, this);
+        explosiones.push_back(explosion);
+        lanzarExplosion(explosion);
+    }
+
+    if (static_cast<int>(pociones.size()) < objetivo(config.pociones)) {
+        const QVector<QPixmap> frames = SpriteCache::instancia()->frames(":/images/pocion.png", 65, 64, 6);
+        while (static_cast<int>(pociones.size()) < objetivo(config.pociones)) {
+            const int i = static_cast<int>(pociones.size());
+            Pocion* pocion = new Pocion(frames, i / 7 % 4, i % 7, 7);
+            escena->addItem(pocion);
+            pociones.push_back(pocion);
+        }
+    }
+
+    while (static_cast<int>(robots.size()) < objetivo(config.robots)) {
+        Robot* robot = new Robot(escena, 6, azar->bounded(1, 5), this);
+        const int x = azar->bounded(300, qMax(301, static_cast<int>(escena->width())));
+        robot->iniciar(x, 500, x - 300);
+        robots.push_back(robot);
+    }
+}
+
+/**
+@brief Vuelve a lanzar las aves que salieron por la izquierda y las explosiones que terminaron.
+
+Así la cantidad de entidades en movimiento se mantiene en lo pedido durante toda la etapa.
+*/
+void EstresNivel::reciclar()
+{
+    for (obstaculo* ave : aves) {
+        if (!ave->estaActivo())
+            lanzarAve(ave, true);
+    }
+
+    for (Explosion* explosion : explosiones) {
+        if (!explosion->getSprite()->isVisible())
+            lanzarExplosion(explosion);
+    }
+}
+
+/**
+@brief Registra el costo de la etapa que terminó.
+
+Mide los pasos simulados y el tiempo real que tardaron (en el simulador, el cociente dice cuántas
+veces más rápido que el tiempo real se simula; en el juego, un valor menor a 1 indica pasos
+descartados por atraso), los percentiles de frame del `Perfilador` si hubo frames pintados y la
+memoria viva según `RastreoMemoria`. Emite la línea legible y, si hay archivo, agrega la fila al CSV.
+*/
+void EstresNivel::medir()
+{
+    const qint64 pasos = BucleJuego::instancia()->getPasosTotales() - pasosInicioEtapa;
+    const qint64 msReales = qMax<qint64>(relojEtapa.elapsed(), 1);
+    const double xTiempoReal = static_cast<double>(pasos * BucleJuego::pasoMs) / msReales;
+    const Perfilador::Estadisticas frames = Perfilador::instancia()->estadisticas();
+    const qint64 memoriaKb = RastreoMemoria::bytesVivos() / 1024;
+    const int items = nivel->getEscena()->items().size();
+
+    QString linea = QString("estres nivel %1 etapa %2/%3: aves=%4 explosiones=%5 pociones=%6 robots=%7 items=%8"
+                            " | %9 pasos en %10 ms (x%11)")
+                        .arg(nivel->getNumero()).arg(etapa).arg(config.etapas)
+                        .arg(aves.size()).arg(explosiones.size()).arg(pociones.size()).arg(robots.size())
+                        .arg(items).arg(pasos).arg(msReales).arg(xTiempoReal, 0, 'f', 2);
+    if (frames.frames > 0)
+        linea += QString(" | frame p50=%1 p95=%2 max=%3 ms")
+                     .arg(frames.p50, 0, 'f', 2).arg(frames.p95, 0, 'f', 2).arg(frames.maximo, 0, 'f', 2);
+    linea += QString(" | memoria=%1 KB").arg(memoriaKb);
+
+    emit etapaMedida(linea);
+
+    if (config.archivo.isEmpty()) return;
+
+    QFile archivo(config.archivo);
+    if (!archivo.open(QIODevice::Append | QIODevice::Text)) {
+        qWarning() << "EstresNivel: no se pudo escribir en" << config.archivo;
+        return;
+    }
+    QTextStream(&archivo) << nivel->getNumero() << ',' << etapa << ',' << aves.size() << ','
+                          << explosiones.size() << ',' << pociones.size() << ',' << robots.size() << ','
+                          << items << ',' << pasos << ',' << msReales << ',' << xTiempoReal << ','
+                          << frames.p50 << ',' << frames.p95 << ',' << frames.maximo << ','
+                          << memoriaKb << '\n';
+}
+
+/**
+@brief Pone un ave en vuelo.
+
+@param ave Ave a lanzar.
+@param alFinal `true` para que entre por el borde derecho de la escena; `false` para repartirla
+a lo ancho (la primera vez).
+*/
+void EstresNivel::lanzarAve(obstaculo* ave, bool alFinal)
+{
+    QRandomGenerator* azar = AzarJuego::generador();
+    const int ancho = static_cast<int>(nivel->getEscena()->width());
+
+    const int x = alFinal ? ancho + azar->bounded(0, 400) : azar->bounded(0, qMax(1, ancho));
+    const int y = azar->bounded(100, 550);
+    ave->iniciar(x, y);
+}
+
+/**
+@brief Lanza una explosión desde un punto al azar de la escena.
+
+@param explosion Explosión libre (recién creada o que ya terminó su vuelo).
+*/
+void EstresNivel::lanzarExplosion(Explosion* explosion)
+{
+    QRandomGenerator* azar = AzarJuego::generador();
+    const int ancho = static_cast<int>(nivel->getEscena()->width());
+
+    explosion->setTipoMovimiento(azar->bounded(2) == 0 ? Explosion::Parabolico : Explosion::MRU);
+    explosion->setPosicionInicial(QPointF(azar->bounded(200, qMax(201, ancho - 100)), azar->bounded(100, 500)));
+    explosion->lanzar();
+}
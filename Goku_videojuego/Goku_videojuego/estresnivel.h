@@ -0,0 +1,77 @@
+#ifndef ESTRESNIVEL_H
+#define ESTRESNIVEL_H
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QString>
+#include <vector>
+#include "buclejuego.h"
+
+class Nivel;
+class obstaculo;
+class Explosion;
+class Pocion;
+class Robot;
+
+// Cantidades finales del modo estrés y cómo se llega a ellas
+struct ConfigEstres {
+    int aves = 0;
+    int explosiones = 0;
+    int pociones = 0;
+    int robots = 0;
+    int etapas = 10;             // Se agrega 1/etapas del total en cada etapa
+    int msPorEtapa = 4000;       // Tiempo de juego de cada etapa (el perfilador guarda ~4 s)
+    QString archivo;             // CSV con una fila por etapa; vacío = solo el registro
+
+    bool activo() const { return aves + explosiones + pociones + robots > 0; }
+};
+
+/**
+ * Modo estrés de un nivel.
+ * Agrega a la escena del nivel muchas más entidades que las del juego (aves, explosiones,
+ * pociones y robots con su comportamiento real) en etapas crecientes. Al terminar cada etapa
+ * registra cuánto costó simularla y pintarla y cuánta memoria queda viva, para ver dónde deja
+ * de escalar el motor. Goku se vuelve invulnerable para que el nivel no termine antes.
+ */
+class EstresNivel : public QObject
+{
+    Q_OBJECT
+
+public:
+    EstresNivel(Nivel* nivel, const ConfigEstres& config);
+    ~EstresNivel();
+
+    // "aves=2000,explosiones=500,pociones=1000,robots=100[,etapas=10][,ms=4000]"
+    static ConfigEstres leerConfig(const QString& texto);
+
+signals:
+    void etapaMedida(const QString& linea);   // Resumen legible de cada etapa
+
+private:
+    void siguienteEtapa();       // Mide la etapa que terminó y agrega la próxima tanda
+    void agregarHasta(int etapa);
+    void reciclar();             // Vuelve a lanzar las aves y explosiones que terminaron
+    void medir();
+    void lanzarAve(obstaculo* ave, bool alFinal);
+    void lanzarExplosion(Explosion* explosion);
+
+    Nivel* nivel;
+    ConfigEstres config;
+    TareaBucle* tareaEtapa;
+    TareaBucle* tareaReciclaje;
+
+    std::vector<obstaculo*> aves;
+    std::vector<Explosion*> explosiones;
+    std::vector<Pocion*> pociones;
+    std::vector<Robot*> robots;
+
+    int etapa = 0;
+    qint64 pasosInicioEtapa = 0;
+    QElapsedTimer relojEtapa;
+
+    // Bloqueamos copia y asignación
+    EstresNivel(const EstresNivel&) = delete;
+    EstresNivel& operator=(const EstresNivel&) = delete;
+};
+
+#endif // ESTRESNIVEL_H
@@ -1,7 +1,8 @@
 #include "explosion.h"
 #include "goku2.h"
+#include "spritecache.h"
+#include "perfilador.h"
 #include <QMessageBox>
-#include <QTimer>
 #include <QGraphicsItem>
 #include <QPixmap>
 #include <QDebug>
@@ -17,11 +18,13 @@ int Explosion::contador=0;
 
 /**
 @brief Constructor de la clase Explosion.
-Crea un proyectil animado que representa una explosión en movimiento. Extrae seis
-frames desde la hoja de sprites “:/images/explosion.png”, configura el primero como
+Crea un proyectil animado que representa una explosión en movimiento. Obtiene de la
+caché compartida los seis frames de la hoja “:/images/explosion.png”, configura el primero como
 imagen inicial y escala el sprite para un tamaño reducido. Establece el tipo de
-obstáculo como Explosion, registra la etiqueta “explosion” para detección de colisión
-y prepara los parámetros físicos iniciales (trayectoria parabólica por defecto).
+obstáculo como Explosion (cuerpo de tipo `EntidadExplosion` que busca al jugador)
+y la trayectoria parabólica por defecto. El movimiento y la animación los hace la entrada
+de la explosión en el almacén de proyectiles; aquí solo se le asignan los avisos de cada
+tick y de fin de vuelo.
 Si la imagen no se puede cargar o no contiene frames válidos, lanza una excepción
 para evitar un estado inconsistente.
 @param scene Escena gráfica donde se insertará la explosión. No puede ser nula.
@@ -30,27 +33,15 @@ para evitar un estado inconsistente.
 */
 Explosion::Explosion(QGraphicsScene* scene, QObject* parent)
     : obstaculo(scene, obstaculo::Explosion, 6, parent),  // Tipo Explosion con 6 frames
-    velocidadX(-10),
-    velocidadY(-15),
-    gravedad(1.2),
-    tiempo(0),
-    frameActual(0),
     tipoMovimiento(Parabolico),
     posicionInicial(posicionDisparo)
 {
     const int anchoFrame = 100;
     const int altoFrame  = 72;
 
-    // Carga hoja de sprites desde recursos
-    QPixmap sheet(":/images/explosion.png");
-    if (sheet.isNull()) {
-        throw std::runtime_error("Explosion: No se pudo cargar explosion.png.");
-    }
-
+    // Frames compartidos: la hoja se decodifica y recorta una sola vez para todas las explosiones
     const int numFrames = 6;
-    frames.clear();
-    for (int i = 0; i < numFrames; ++i)
-        frames.append(sheet.copy(i * anchoFrame, 0, anchoFrame, altoFrame));  // Extrae cada frame
+    frames = SpriteCache::instancia()->frames(":/images/explosion.png", anchoFrame, altoFrame, numFrames);
 
     if (frames.isEmpty()) {
         throw std::runtime_error("Explosion: No se pudieron extraer los frames desde la hoja de sprites.");
@@ -59,7 +50,11 @@ Explosion::Explosion(QGraphicsScene* scene, QObject* parent)
     // Frame inicial de la animación
     sprite->setPixmap(frames[0]);
     sprite->setScale(1.8);                     // Escala pequeña
-    sprite->setData(0, "explosion");           // Identificador del objeto
+    sprite->setTransformationMode(Qt::SmoothTransformation);   // Escalado suave solo en este item
+
+    // Avisos del almacén de proyectiles: impacto tras cada tick y fin del vuelo
+    almacen->setAlMoverse(entrada, [this]() { revisarImpacto(); });
+    almacen->setAlSalir(entrada, [this]() { terminar(); });
 
     //contador+=1;
     //qDebug() << "Explosiones creadas "<<contador;
@@ -67,30 +62,12 @@ Explosion::Explosion(QGraphicsScene* scene, QObject* parent)
 
 /**
 @brief Destructor de la clase Explosion.
-Finaliza y libera todos los recursos asociados a la explosión: detiene y desconecta
-los temporizadores de movimiento y animación, destruye sus instancias y pone a
-nullptr los punteros correspondientes para evitar accesos posteriores. Este proceso
-garantiza una limpieza segura y completa cuando el objeto se elimina o se reinicia
-el nivel. El sprite es gestionado por la clase base obstáculo.
+El sprite, su cuerpo de colisión y su entrada en el almacén de proyectiles los libera la
+clase base obstáculo; la entrada se quita antes de que sus avisos puedan volver a llamarse.
 */
 Explosion::~Explosion() {
     //qDebug() << "Destructor de Explosion llamado";
 
-    // 1. Detener y liberar temporizadores
-    if (timerMovimiento) {
-        disconnect(timerMovimiento, nullptr, this, nullptr);
-        timerMovimiento->stop();
-        delete timerMovimiento;
-        timerMovimiento = nullptr;
-    }
-
-    if (timerAnimacion) {
-        disconnect(timerAnimacion, nullptr, this, nullptr);
-        timerAnimacion->stop();
-        delete timerAnimacion;
-        timerAnimacion = nullptr;
-    }
-
     //contador-=1;
     //qDebug() << "Explosiones eliminadas  "<<contador;
 }
@@ -120,111 +97,96 @@ void Explosion::setPosicionInicial(QPointF pos) {
 }
 
 /**
-@brief Avanza un paso en la secuencia de frames de la explosión.
-Incrementa el índice de frame actual y actualiza el sprite con la imagen correspondiente,
-generando la animación de estallido. Cuando se alcanza el último frame, detiene y libera
-el temporizador de animación para evitar ciclos innecesarios, marcando así el fin
-visual de la explosión.
-@note El método verifica que el sprite exista antes de actuar, garantizando estabilidad
-  si la explosión se destruye durante la animación.
+@brief Revisa si la explosión alcanzó al jugador. El almacén la llama tras cada tick de vuelo.
+
+El almacén ya movió el sprite y actualizó su cuerpo. Si colisiona con un objeto `Goku2`
+(consultado por tipo `EntidadJugador` en el `MundoColisiones`), se le aplica daño y la explosión
+termina. La salida de la pantalla la detecta el propio almacén con los límites fijados en `lanzar()`.
 */
-void Explosion::avanzarFrameAnimacion() {
-    if (!sprite) return;
-
-    if (frameActual < frames.size() - 1) {
-        frameActual++;
-        sprite->setPixmap(frames[frameActual]);
-    } else {
-        if (timerAnimacion) {
-            timerAnimacion->stop();
-            timerAnimacion->deleteLater();
-            timerAnimacion = nullptr;
+void Explosion::revisarImpacto() {
+    ZONA_PERFIL("Explosion");
+    if (!sprite || !scene) return;  // Validación directa
+
+    // Detección de COLISIONES: solo contra los tipos de su máscara (el jugador)
+    MundoColisiones* mundo = MundoColisiones::instancia();
+    int candidatos[4];
+    const int cantidad = mundo->recolectar(sprite->sceneBoundingRect(), mundo->mascara(cuerpo),
+                                           candidatos, 4, cuerpo);
+
+    for (int i = 0; i < cantidad; ++i) {
+        Goku2* goku = qobject_cast<Goku2*>(mundo->dueno(candidatos[i]));
+        if (goku && sprite->collidesWithItem(goku)) {
+            goku->recibirDanio(20);
+            goku->animarMuerte();
+            terminar();
+            return;
         }
     }
 }
 
+/**
+@brief Termina el vuelo: detiene el movimiento, oculta el sprite y emite `terminada()`.
+
+Se llama al chocar con el jugador o al salir de los límites de la pantalla, para que la reserva
+que la creó pueda reutilizarla.
+*/
+void Explosion::terminar() {
+    almacen->detener(entrada);
+    sprite->hide();
+    emit terminada();
+}
+
 /**
  @brief Inicia el lanzamiento de la explosión, activando su movimiento físico y su animación visual.
 
  Este método coloca el sprite de la explosión en su posición inicial (`posicionInicial`) y configura su trayectoria
- dependiendo del tipo de movimiento especificado (parabólico o movimiento rectilíneo uniforme). Luego crea dos temporizadores:
+ dependiendo del tipo de movimiento especificado (parabólico o movimiento rectilíneo uniforme). Luego pone en marcha su entrada del almacén de proyectiles:
 
-1. **`timerMovimiento`**: se encarga de actualizar la posición del sprite cada 30ms, aplicando una física simple.
-    - Si el movimiento es parabólico, se aplica una aceleración simulando la gravedad.
-    - Si colisiona con un objeto `Goku2`, se le aplica daño y se oculta la explosión.
-    - Si la explosión sale de los límites de la pantalla, también se detiene y se oculta.
+1. **Movimiento**: avanza la posición cada 30ms; en la parabólica la velocidad vertical crece 0.6 px por tick (la gravedad).
+   - Sale al bajar a 50 px del borde inferior o al alejarse 100 px de los bordes laterales.
 
-2. **`timerAnimacion`**: cambia el frame del sprite cada 300ms para mostrar la animación de la explosión.
-   - La animación se detiene automáticamente al llegar al último frame.
-Este método es llamado una vez por cada instancia de explosión que se desea animar/lanzar en la escena.
+2. **Animación**: cambia el frame del sprite cada 300ms y se detiene al llegar al último frame.
+Este método se llama cada vez que la explosión se reutiliza: reinicia la posición, el frame y la velocidad
+y vuelve a mostrar el sprite, por lo que una explosión recogida se puede lanzar de nuevo.
 
 @see Explosion::setTipoMovimiento() para definir el tipo de trayectoria antes de lanzar.
 @see Explosion::setPosicionInicial() para definir desde dónde inicia el lanzamiento.
  */
 void Explosion::lanzar() {
     // Configuración inicial
-    sprite->setPos(posicionInicial);
-    tiempo = 0;
-    frameActual = 0;
     sprite->setPixmap(frames[0]);
+    sprite->show();
+    almacen->colocar(entrada, posicionInicial.x(), posicionInicial.y());
 
     // Parámetros de movimiento
+    QPointF velocidad;
+    float gravedad;
     if (tipoMovimiento == Parabolico) {
-        velocidadX = -10;
-        velocidadY = -15;
-        gravedad = 1.2;
+        velocidad = QPointF(-10, -15);
+        gravedad = 1.2f;
     } else {  // MRU
-        velocidadX = -12;
-        velocidadY = 6;
+        velocidad = QPointF(-12, 6);
         gravedad = 0;
     }
 
-    // Temporizador de MOVIMIENTO FÍSICO
-    timerMovimiento = new QTimer(this);
-    connect(timerMovimiento, &QTimer::timeout, this, [this]() {
-        if (!sprite || !scene) return;  // Validación directa
-
-        // Actualizar posición
-        float x = sprite->x() + velocidadX;
-        float y = sprite->y();
-
-        if (tipoMovimiento == Parabolico) {
-            y += velocidadY + gravedad * tiempo;
-            tiempo += 0.5;
-        } else {
-            y += velocidadY;
-        }
+    // Límites de la pantalla
+    almacen->setLimites(entrada, -100, scene->width() + 100, scene->height() - 50);
 
-        sprite->setPos(x, y);
-
-        // Detección de COLISIONES
-        QList<QGraphicsItem*> colisiones = sprite->collidingItems();
-        for (int i = 0; i < colisiones.size(); ++i) {
-            QGraphicsItem* item = colisiones.at(i);
-            if (Goku2* goku = dynamic_cast<Goku2*>(item)) {
-                goku->recibirDanio(20);
-                goku->animarMuerte();
-                timerMovimiento->stop();
-                sprite->hide();
-                return;
-            }
-        }
+    // MOVIMIENTO FÍSICO cada 30ms: la velocidad vertical crece gravedad * 0.5 por tick
+    almacen->mover(entrada, velocidad, gravedad * 0.5f, 30);
 
-        // Límites de la pantalla
-        if (sprite->y() >= scene->height() - 50 ||
-            sprite->x() < -100 ||
-            sprite->x() > scene->width() + 100) {
-            timerMovimiento->stop();
-            sprite->hide();
-        }
-    });
-
-
-    timerMovimiento->start(30);  // Ejecuta cada 30ms
+    // ANIMACIÓN VISUAL: cambia frame cada 300ms
+    almacen->animar(entrada, 300, false);
+}
 
-    // Temporizador de ANIMACIÓN VISUAL
-    timerAnimacion = new QTimer(this);
-    connect(timerAnimacion, &QTimer::timeout, this, &Explosion::avanzarFrameAnimacion);
+/**
+@brief Detiene la explosión y la deja oculta, lista para volver a lanzarse.
 
-    timerAnimacion->start(300);  // Cambia frame cada 300ms
+Detiene su entrada del almacén (movimiento y animación) y oculta el sprite; como los cuerpos ocultos no
+participan en las consultas del `MundoColisiones`, la explosión deja de colisionar sin quitar su
+cuerpo del mundo. La usa `PoolExplosiones` al crearla y cada vez que vuelve a la reserva.
+*/
+void Explosion::recoger() {
+    almacen->detener(entrada);
+    sprite->hide();
 }
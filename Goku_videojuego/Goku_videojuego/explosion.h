@@ -2,7 +2,6 @@
 #define EXPLOSION_H
 
 #include "obstaculo.h"
-#include <QTimer>
 #include <QPointF>
 
 class Explosion : public obstaculo
@@ -24,17 +23,14 @@ public:
     void setTipoMovimiento(TipoMovimiento tipo);
     void setPosicionInicial(QPointF pos);
     void lanzar();
+    void recoger();          // Detiene y oculta la explosión para reutilizarla
 
-private slots:
-    void avanzarFrameAnimacion();
+signals:
+    void terminada();        // El vuelo terminó (chocó o salió de la pantalla)
 
 private:
-    QTimer* timerMovimiento;
-    float velocidadX;
-    float velocidadY;
-    float gravedad;
-    float tiempo;
-    int frameActual;
+    void revisarImpacto();   // Después de cada tick de vuelo: daño al jugador
+    void terminar();         // Oculta la explosión y avisa con terminada()
 
     TipoMovimiento tipoMovimiento;
     QPointF posicionInicial;
@@ -0,0 +1,161 @@
+#include "fondoparalaje.h"
+#include "camaralogica.h"
+#include "perfilador.h"
+#include <QVariant>
+#include <QtMath>
+#include <stdexcept>  // Excepciones estándar
+
+namespace {
+// Propiedad de la escena donde queda registrado su fondo
+const char* const propiedadFondo = "fondoParalaje";
+}
+
+/**
+@brief Constructor del fondo por capas.
+
+Registra el fondo en la escena para que la vista lo encuentre al pintar. Una escena tiene a lo
+sumo un fondo: el último creado reemplaza al anterior.
+
+@param escena Escena cuyo fondo se dibuja. No puede ser nula.
+@param parent Objeto padre en la jerarquía de Qt (normalmente el nivel).
+
+@throw std::invalid_argument Si la escena es nula.
+*/
+FondoParalaje::FondoParalaje(QGraphicsScene* escena, QObject* parent)
+    : QObject(parent), escena(escena)
+{
+    if (!escena)
+        throw std::invalid_argument("FondoParalaje: la escena no puede ser nula.");
+
+    escena->setProperty(propiedadFondo, QVariant::fromValue<QObject*>(this));
+    escena->invalidate(QRectF(), QGraphicsScene::BackgroundLayer);   // Las vistas con caché de fondo la rehacen
+}
+
+/**
+@brief Destructor: quita el registro de la escena si sigue apuntando a este fondo e invalida la caché de fondo de sus vistas.
+*/
+FondoParalaje::~FondoParalaje()
+{
+    if (deEscena(escena) == this) {
+        escena->setProperty(propiedadFondo, QVariant());
+        escena->invalidate(QRectF(), QGraphicsScene::BackgroundLayer);
+    }
+}
+
+/**
+@brief Agrega una capa por delante de las existentes.
+
+@param imagen Imagen de la capa (normalmente obtenida de `SpriteCache`).
+@param origen Franja de la imagen que se repite; si está vacía se usa la imagen completa.
+@param factor Cuánto acompaña a la cámara: 0 la deja fija en pantalla y 1 la mueve con el mundo.
+@param y Coordenada vertical de la franja en la escena.
+@param uniforme `true` si la franja se ve igual en toda su anchura; entonces, aunque no acompañe
+       al mundo, la vista puede desplazarla en lugar de repintarla.
+
+@throw std::invalid_argument Si la imagen es nula.
+*/
+void FondoParalaje::agregarCapa(const QPixmap& imagen, const QRect& origen, qreal factor, qreal y,
+                                bool uniforme)
+{
+    if (imagen.isNull())
+        throw std::invalid_argument("FondoParalaje: la imagen de la capa es nula.");
+
+    const QRect franja = origen.isEmpty() ? imagen.rect() : (origen & imagen.rect());
+    capas.append({imagen, franja, factor, y, uniforme});
+}
+
+/**
+@brief Asocia la cámara del nivel; sin cámara el fondo se dibuja como si estuviera en x = 0.
+
+@param camara Cámara que sigue a Goku, o `nullptr`.
+*/
+void FondoParalaje::setCamara(camaraLogica* camara)
+{
+    this->camara = camara;
+}
+
+/**
+@brief Dibuja las capas en la zona expuesta de la escena.
+
+Para una capa con factor `f`, su mosaico 0 empieza en `xCamara * (1 - f)`: con `f = 1` queda
+quieto en la escena y con `f = 0` acompaña a la cámara. Solo se recorren los mosaicos que tocan
+`rect`, y de cada uno se copia únicamente la parte visible.
+
+@param painter Pintor de la vista, en coordenadas de escena.
+@param rect Zona expuesta en coordenadas de escena.
+*/
+void FondoParalaje::dibujar(QPainter* painter, const QRectF& rect) const
+{
+    ZONA_PERFIL("fondoParalaje");
+    const qreal xCam = xCamara();
+
+    for (const Capa& capa : capas) {
+        const qreal ancho = capa.origen.width();
+        const qreal alto = capa.origen.height();
+
+        const QRectF franja(rect.left(), capa.y, rect.width(), alto);
+        const QRectF visible = franja & rect;
+        if (visible.isEmpty()) continue;
+
+        // Desplazamiento entero para que los mosaicos no dejen costuras
+        const qreal desplazamiento = qRound(xCam * (1.0 - capa.factor));
+        const int primero = qFloor((visible.left() - desplazamiento) / ancho);
+        const int ultimo = qFloor((visible.right() - desplazamiento) / ancho);
+
+        for (int i = primero; i <= ultimo; ++i) {
+            const QRectF mosaico(desplazamiento + i * ancho, capa.y, ancho, alto);
+            const QRectF destino = mosaico & visible;
+            if (destino.isEmpty()) continue;
+
+            const QRectF fuente = destino.translated(capa.origen.x() - mosaico.x(),
+                                                     capa.origen.y() - mosaico.y());
+            painter->drawPixmap(destino, capa.imagen, fuente);
+        }
+    }
+}
+
+/**
+@brief Devuelve las franjas visibles que hay que repintar cuando la cámara se desplaza.
+
+Cuando la vista desplaza los píxeles ya pintados (scroll-and-patch), solo quedan bien las capas
+que se mueven con el mundo (`factor` 1) o que son uniformes a lo ancho. El resto avanza a otro
+ritmo y su franja tiene que volver a dibujarse.
+
+@param visible Zona de la escena que muestra la vista.
+@return Franjas, en coordenadas de escena, recortadas a `visible`.
+*/
+QVector<QRectF> FondoParalaje::zonasMoviles(const QRectF& visible) const
+{
+    QVector<QRectF> zonas;
+    for (const Capa& capa : capas) {
+        if (capa.uniforme || qFuzzyCompare(capa.factor, 1.0)) continue;
+
+        const QRectF franja = QRectF(visible.left(), capa.y, visible.width(), capa.origen.height()) & visible;
+        if (!franja.isEmpty())
+            zonas.append(franja);
+    }
+    return zonas;
+}
+
+/**
+@brief Devuelve el fondo registrado en una escena.
+
+@param escena Escena a consultar.
+@return El fondo de la escena, o `nullptr` si no tiene.
+*/
+FondoParalaje* FondoParalaje::deEscena(const QGraphicsScene* escena)
+{
+    if (!escena) return nullptr;
+    return qobject_cast<FondoParalaje*>(escena->property(propiedadFondo).value<QObject*>());
+}
+
+/**
+@brief Borde izquierdo de lo que muestra la cámara.
+
+@return Coordenada X en la escena, o 0 si no hay cámara.
+*/
+qreal FondoParalaje::xCamara() const
+{
+    if (!camara) return 0;
+    return camara->zonaMostrada().left();
+}
@@ -0,0 +1,57 @@
+#ifndef FONDOPARALAJE_H
+#define FONDOPARALAJE_H
+
+#include <QObject>
+#include <QGraphicsScene>
+#include <QPainter>
+#include <QPixmap>
+#include <QRect>
+#include <QRectF>
+#include <QVector>
+
+class camaraLogica;
+
+/**
+ * Fondo de un nivel dibujado por capas con paralaje, sin items en la escena.
+ * Cada capa es una franja horizontal de una imagen que se repite sin fin a lo ancho; su factor
+ * indica cuánto acompaña a la cámara (0: queda fija en pantalla, 1: se mueve con el mundo).
+ * La vista lo pinta desde drawBackground() y solo dibuja los mosaicos que caen en la zona
+ * expuesta, así que el costo no depende del largo del nivel.
+ */
+class FondoParalaje : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Capa {
+        QPixmap imagen;
+        QRect origen;        // Franja de la imagen que se repite
+        qreal factor;        // 0 = fija en pantalla, 1 = con el mundo
+        qreal y;             // Altura de la franja en la escena
+        bool uniforme;       // Igual en toda su anchura (un cielo liso): desplazarla no se nota
+    };
+
+    FondoParalaje(QGraphicsScene* escena, QObject* parent = nullptr);
+    ~FondoParalaje();
+
+    void agregarCapa(const QPixmap& imagen, const QRect& origen, qreal factor, qreal y,
+                     bool uniforme = false);
+    void setCamara(camaraLogica* camara);
+    void dibujar(QPainter* painter, const QRectF& rect) const;
+    QVector<QRectF> zonasMoviles(const QRectF& visible) const;   // Franjas que no admiten scroll-and-patch
+
+    static FondoParalaje* deEscena(const QGraphicsScene* escena);   // nullptr si la escena no tiene
+
+private:
+    qreal xCamara() const;
+
+    QGraphicsScene* escena;
+    camaraLogica* camara = nullptr;
+    QVector<Capa> capas;                 // De la más lejana a la más cercana
+
+    // Bloqueamos copia y asignación
+    FondoParalaje(const FondoParalaje&) = delete;
+    FondoParalaje& operator=(const FondoParalaje&) = delete;
+};
+
+#endif // FONDOPARALAJE_H
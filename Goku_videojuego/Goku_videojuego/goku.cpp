@@ -13,7 +13,8 @@ Valida los parámetros de entrada para asegurar que la escena y las dimensiones
 
 - Inserta al personaje en la escena.
 - Establece su capacidad de recibir eventos de teclado (`setFocus()`).
-- Inicializa punteros como `timerMovimiento`, `timerDanio` y `vidaHUD` en `nullptr`.
+- Inicializa punteros como `tareaMovimiento`, `tareaDanio` y `vidaHUD` en `nullptr`.
+- Registra al personaje en el mundo de colisiones con el tipo `EntidadJugador`; cada subclase fija los tipos con los que choca.
 
 @param scene Puntero a la escena de juego donde se insertará el personaje. No debe ser nulo.
 @param velocidad Velocidad horizontal del personaje. Debe ser mayor que cero.
@@ -27,8 +28,9 @@ Goku::Goku(QGraphicsScene* scene, int velocidad, int fotogWidth, int fotogHeight
     : QObject(parent),
     QGraphicsPixmapItem(),
     scene(scene),
-    timerMovimiento(nullptr),
-    timerDanio(nullptr),
+    tareaMovimiento(nullptr),
+    tareaDanio(nullptr),
+    cuerpo(-1),
     frameActual(0),
     velocidad(velocidad),
     fotogWidth(fotogWidth),
@@ -55,6 +57,19 @@ Goku::Goku(QGraphicsScene* scene, int velocidad, int fotogWidth, int fotogHeight
     scene->addItem(this);
     setFlag(QGraphicsItem::ItemIsFocusable);  // Permite recibir eventos de teclado
     setFocus();                                // Goku recibe foco automáticamente
+
+    // Registro en el mundo de colisiones como jugador; cada nivel fija con qué choca
+    cuerpo = MundoColisiones::instancia()->agregar(this, EntidadJugador, EntidadNinguna, this);
+}
+
+/**
+@brief Actualiza la caja de colisión de Goku en el mundo de colisiones.
+
+Debe llamarse después de cada cambio de posición o de imagen, para que las consultas de
+otras entidades (por ejemplo, las explosiones) vean la caja actual del personaje.
+*/
+void Goku::actualizarCuerpo() {
+    MundoColisiones::instancia()->actualizar(cuerpo);
 }
 
 /**
@@ -87,6 +102,7 @@ La vida se refleja a través de un HUD representado por un objeto `Vida`, el cua
 - Si no hay barra de vida asociada, también lanza una excepción.
 - Si la vida llega a cero o menos, se considera que el personaje ha sido derrotado, aunque la reacción específica
 (ej. animación o final del juego) debe ser manejada externamente.
+- Si el personaje es invulnerable (modo estrés), el daño se ignora.
 
 @param cantidad Cantidad de puntos de vida que se deben restar al personaje.
 
@@ -102,6 +118,8 @@ void Goku::recibirDanio(int cantidad) {
         throw std::runtime_error("Goku::recibirDanio - no se ha asociado una barra de vida.");
     }
 
+    if (invulnerable) return;
+
     vidaHUD->restar(cantidad);  // Resta la vida en el HUD
 
     if (vidaHUD->obtenerVida() <= 0) {
@@ -113,10 +131,10 @@ void Goku::recibirDanio(int cantidad) {
 /**
 @brief Destructor de la clase base `Goku`.
 
-Este destructor detiene y limpia los temporizadores asociados al movimiento y al control de daño,
+Este destructor detiene las tareas del bucle asociadas al movimiento y al control de daño,
 dejando los punteros en `nullptr` para evitar accesos colgantes.
 
-No elimina directamente los objetos `timerMovimiento`, `timerDanio` ni `vidaHUD` ya que Qt se encarga
+No elimina directamente los objetos `tareaMovimiento`, `tareaDanio` ni `vidaHUD` ya que Qt se encarga
 de destruirlos automáticamente si tienen un `QObject` padre asignado.
 
 También libera la referencia a la escena para prevenir referencias circulares o fugas de memoria.
@@ -126,17 +144,21 @@ Este destructor debe ser invocado automáticamente al destruir una instancia de
 Goku::~Goku() {
     //qDebug() << "Destructor de Goku base llamado";
 
-    if (timerMovimiento && timerMovimiento->isActive()) {
-        timerMovimiento->stop();
+    if (tareaMovimiento && tareaMovimiento->estaActiva()) {
+        tareaMovimiento->detener();
     }
 
-    if (timerDanio && timerDanio->isActive()) {
-        timerDanio->stop();
+    if (tareaDanio && tareaDanio->estaActiva()) {
+        tareaDanio->detener();
     }
 
+    // Ya no participa en las colisiones
+    MundoColisiones::instancia()->quitar(cuerpo);
+    cuerpo = -1;
+
     // Qt los eliminará automáticamente si tienen parent
-    timerMovimiento = nullptr;
-    timerDanio = nullptr;
+    tareaMovimiento = nullptr;
+    tareaDanio = nullptr;
     vidaHUD = nullptr;
     scene = nullptr;
 }
@@ -157,3 +179,35 @@ int Goku::obtenerVida() const {
 
     return vidaHUD->obtenerVida();
 }
+
+/**
+@brief Hace que el personaje ignore el daño recibido.
+
+Lo usa el modo estrés (`EstresNivel`) para que el nivel no termine por la cantidad de obstáculos
+y explosiones que agrega.
+
+@param valor `true` para ignorar el daño, `false` para volver a recibirlo.
+*/
+void Goku::setInvulnerable(bool valor)
+{
+    invulnerable = valor;
+}
+
+/**
+@brief Entrega una tecla al personaje como si viniera del teclado.
+
+Permite controlar a Goku sin una vista ni foco de teclado, por ejemplo desde el simulador con
+entradas programadas. Construye el `QKeyEvent` correspondiente y lo pasa a `keyPressEvent()` o
+`keyReleaseEvent()` de la subclase.
+
+@param tecla Código de tecla de Qt (por ejemplo, `Qt::Key_W`).
+@param presionada `true` para pulsar la tecla, `false` para soltarla.
+*/
+void Goku::enviarTecla(int tecla, bool presionada) {
+    QKeyEvent evento(presionada ? QEvent::KeyPress : QEvent::KeyRelease, tecla, Qt::NoModifier);
+
+    if (presionada)
+        keyPressEvent(&evento);
+    else
+        keyReleaseEvent(&evento);
+}
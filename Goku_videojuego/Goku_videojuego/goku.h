@@ -5,9 +5,11 @@
 #include <QGraphicsPixmapItem>
 #include <QGraphicsScene>
 #include <QKeyEvent>
-#include <QTimer>
 #include <QVector>
 #include "vida.h"
+#include "buclejuego.h"
+#include "mundocolisiones.h"
+#include "arenanivel.h"
 
 /**
  * Clase base abstracta que representa a Goku en el videojuego.
@@ -19,6 +21,7 @@ class Goku : public QObject, public QGraphicsPixmapItem
     Q_OBJECT
 
 public:
+    ENTIDAD_DE_NIVEL   // Se reserva en la arena del nivel (Goku1 y Goku2)
     static int contador;
 
     Goku(QGraphicsScene *scene, int velocidad, int fotogWidth, int fotogHeight, QObject *parent = nullptr);
@@ -27,6 +30,8 @@ public:
     void setBarraVida(Vida* barra);          // Asocia la barra de vida externa
     void recibirDanio(int cantidad);         // Aplica daño visualmente
     int obtenerVida() const;                 // Getter para consultar vida actual
+    void enviarTecla(int tecla, bool presionada);   // Entrada programada, sin pasar por la vista
+    void setInvulnerable(bool valor);        // Modo estrés: el daño no baja la vida
 
     virtual void iniciar(int x, int y) = 0;  // Posiciona e inicia lógica visual
     virtual void detener() = 0;              // Detiene cualquier animación o movimiento
@@ -38,10 +43,12 @@ protected:
     virtual void mover() = 0;                                       // Actualiza posición
 
     void actualizarFrame(int indice);       // Cambia frame de animación
+    void actualizarCuerpo();                // Sincroniza la caja de colisión tras moverse
 
     QGraphicsScene *scene;                  // Escena donde se inserta Goku
-    QTimer *timerMovimiento;                // Timer para movimiento continuo
-    QTimer *timerDanio;                     // Timer para recibir daño y gestionar animación
+    TareaBucle *tareaMovimiento;            // Tarea del bucle para movimiento continuo
+    TareaBucle *tareaDanio;                 // Tarea para recibir daño y gestionar animación
+    int cuerpo;                             // Cuerpo en el mundo de colisiones (tipo jugador)
 
     QVector<QPixmap> frames;                // Frames de animación
     int frameActual;                        // Índice de frame actual
@@ -52,6 +59,7 @@ protected:
 
     Vida* vidaHUD;                          // Referencia a HUD de vida
     bool puedeRecibirDanio;                 // Lógica para inmunidad temporal (aún sin usar aquí)
+    bool invulnerable = false;              // Ignora el daño (modo estrés)
 };
 
 #endif // GOKU_H
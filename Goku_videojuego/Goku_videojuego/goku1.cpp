@@ -1,7 +1,6 @@
 #include "goku1.h"
+#include "spritecache.h"
 #include <QKeyEvent>
-#include <QCoreApplication>
-#include <QThread>
 #include <QDebug>
 
 // Inicialización del contador
@@ -10,10 +9,11 @@ int Goku1::contador = 0;
 /**
 @brief Constructor de la clase `Goku1`, versión del personaje para el primer nivel del juego.
 
-Inicializa las variables de estado y configura los temporizadores necesarios para el movimiento y la gestión del daño.
+Inicializa las variables de estado y registra en el bucle central las tareas necesarias para el movimiento y la gestión del daño.
 
-- Crea el `timerMovimiento` que llama periódicamente al método `mover()` para actualizar la posición del personaje.
-- Crea el `timerDanio` con modo de disparo único, que permite controlar la inmunidad temporal tras recibir daño.
+- Crea la `tareaMovimiento` que llama periódicamente al método `mover()` para actualizar la posición del personaje.
+- Crea la `tareaDanio` con modo de disparo único, que permite controlar la inmunidad temporal tras recibir daño.
+- Arma la secuencia de la patada (`secuenciaPatada`): frame 3 durante 200 ms, frame 4 durante 200 ms y `detener()`.
 - Inicializa flags de movimiento vertical (`mvtoArriba`, `mvtoAbajo`) y colisiones (`tocoCarro`, `tocoObstaculo`).
 
 Este constructor debe usarse en el contexto del primer nivel, donde `Goku1` se mueve automáticamente y reacciona a obstáculos.
@@ -35,25 +35,34 @@ Goku1::Goku1(QGraphicsScene* scene, int velocidad, int fotogWidth, int fotogHeig
     tocoCarro(false),
     tocoObstaculo(false)
 {
-    // Timer para mover a Goku
-    timerMovimiento = new QTimer(this);
-    connect(timerMovimiento, &QTimer::timeout, this, &Goku1::mover);
+    // En el nivel 1 Goku choca con los obstáculos y con el carro
+    MundoColisiones::instancia()->setMascara(cuerpo, EntidadObstaculo | EntidadCarro);
 
-    // Timer para controlar el tiempo entre daños
-    timerDanio = new QTimer(this);
-    timerDanio->setSingleShot(true);
-    connect(timerDanio, &QTimer::timeout, this, [=]() {
+    // Tarea para mover a Goku
+    tareaMovimiento = new TareaBucle(BucleJuego::FaseJugador, [this]() { mover(); }, this, "mover");
+
+    // Tarea para controlar el tiempo entre daños
+    tareaDanio = new TareaBucle(BucleJuego::FaseJugador, [this]() {
 
         //qDebug() << "timer danio goku1 llamado  "<<contador++;
         puedeRecibirDanio = true;
-    });
+    }, this, "finInmunidad");
+    tareaDanio->setUnaVez(true);
+
+    // Patada del final del nivel 1; corre con el bucle, sin bloquear el juego
+    secuenciaPatada = new SecuenciaAcciones(this, BucleJuego::FaseJugador, "patada");
+    secuenciaPatada->hacer([this]() { actualizarFrame(3); })   // patada frame 1
+        .esperar(200)
+        .hacer([this]() { actualizarFrame(4); })                // patada frame 2
+        .esperar(200)
+        .hacer([this]() { detener(); });
 }
 
 /**
 @brief Carga y extrae los sprites de animación de Goku1 desde una hoja de sprites.
 
-Este método intenta cargar la imagen `GokuSpriter.png` desde los recursos del sistema.
-Si falla, intenta cargarla desde la ruta local `imagenes/GokuSpriter.png`.
+Este método pide a `SpriteCache` la imagen `GokuSpriter.png` desde los recursos del sistema
+(o, si falla, desde la ruta local `imagenes/GokuSpriter.png`); la hoja se decodifica una sola vez.
 
 - Divide la hoja de sprites en 5 frames horizontales, cada uno con el ancho y alto especificados por `fotogWidth` y `fotogHeight`.
 - Almacena los frames en el vector `frames`.
@@ -64,19 +73,13 @@ Este método debe ser invocado antes de mostrar o animar a Goku1.
 @note Si la imagen no se encuentra, se imprime un mensaje de error en consola y no se cargan frames.
 */
 void Goku1::cargarImagen() {
-    frames.clear();
-    QPixmap spriteSheet(":/images/GokuSpriter.png");
-    if (spriteSheet.isNull()) spriteSheet.load("imagenes/GokuSpriter.png");
+    frames = SpriteCache::instancia()->frames(":/images/GokuSpriter.png", fotogWidth, fotogHeight, 5);
 
-    if (spriteSheet.isNull()) {
+    if (frames.isEmpty()) {
         qDebug() << "Error: No se encontró GokuSpriter.png";
         return;
     }
 
-    for (int i = 0; i < 5; ++i) {
-        frames.append(spriteSheet.copy(i * fotogWidth, 0, fotogWidth, fotogHeight));
-    }
-
     setPixmap(frames[1]); // Frame inicial
 }
 
@@ -84,7 +87,7 @@ void Goku1::cargarImagen() {
 @brief Posiciona a Goku1 en la escena e inicia su movimiento automático.
 
 Este método establece la posición inicial del personaje en las coordenadas `(x, y)`
-y activa el temporizador de movimiento `timerMovimiento`, que ejecuta el método `mover()` cada 60 milisegundos.
+y activa la tarea de movimiento `tareaMovimiento`, que ejecuta el método `mover()` cada 60 milisegundos.
 
 Debe llamarse después de crear la instancia de `Goku1` y de haber cargado sus sprites con `cargarImagen()`.
 
@@ -93,18 +96,19 @@ Debe llamarse después de crear la instancia de `Goku1` y de haber cargado sus s
 */
 void Goku1::iniciar(int x, int y) {
     setPos(x, y);
-    timerMovimiento->start(60); // Intervalo de actualización
+    actualizarCuerpo();
+    tareaMovimiento->iniciar(60); // Intervalo de actualización
 }
 
 /**
 @brief Actualiza la posición y el estado de Goku1 en la escena, incluyendo movimiento, colisiones y animación.
 
-Este método es ejecutado periódicamente por el temporizador `timerMovimiento` y realiza las siguientes acciones:
+Este método es ejecutado periódicamente por la tarea `tareaMovimiento` y realiza las siguientes acciones:
 
 1. Calcula el desplazamiento horizontal y vertical según las teclas presionadas (`W`/`S`).
 2. Aplica el movimiento si no se ha alcanzado el límite derecho de la escena.
 3. Restringe la posición vertical dentro de los márgenes válidos de la escena.
-4. Detecta colisiones con elementos etiquetados como `"carro"` o `"obstaculo"`, y actualiza los flags `tocoCarro` y `tocoObstaculo`.
+4. Consulta al `MundoColisiones` los carros y obstáculos cercanos, confirma la colisión con su forma y actualiza los flags `tocoCarro` y `tocoObstaculo`.
 5. Aplica daño si colisiona con un obstáculo, respetando un período de inmunidad de 1 segundo.
 6. Actualiza el sprite en función del estado del personaje (`mientrasTocaObstaculo()`).
 
@@ -133,21 +137,26 @@ void Goku1::mover()
     qreal nuevaY = qBound<qreal>(70.0, posicionActual.y(), scene->height() - pixmap().height() + 80);
     posicionActual.setY(nuevaY);
     setPos(posicionActual);
+    actualizarCuerpo();
 
-    // 5. Detección de colisiones
+    // 5. Detección de colisiones: el mundo filtra por caja y tipo, y la forma exacta
+    //    solo se compara con los candidatos
     tocoCarro = false;
     tocoObstaculo = false;
 
-    const QList<QGraphicsItem*> items = collidingItems();
-    for (QGraphicsItem* const& item : items) {
-        QString etiqueta = item->data(0).toString();
-        if (etiqueta == "carro") {
+    MundoColisiones* mundo = MundoColisiones::instancia();
+    mundo->consultar(sceneBoundingRect(), mundo->mascara(cuerpo), [&](int id) {
+        if (!collidesWithItem(mundo->item(id)))
+            return true;
+
+        //qDebug() << "Goku1 choca con" << nombreEntidad(mundo->categoria(id));
+        if (mundo->categoria(id) & EntidadCarro) {
             tocoCarro = true;
-            break;
-        } else if (etiqueta == "obstaculo") {
-            tocoObstaculo = true;
+            return false;
         }
-    }
+        tocoObstaculo = true;
+        return true;
+    }, cuerpo);
 
     // 6. Manejo de daños
     if (tocoCarro) {
@@ -155,7 +164,7 @@ void Goku1::mover()
     } else if (tocoObstaculo && puedeRecibirDanio) {
         recibirDanio(20);
         puedeRecibirDanio = false;
-        timerDanio->start(1000); // espera 1s antes de volver a recibir daño
+        tareaDanio->iniciar(1000); // espera 1s antes de volver a recibir daño
     }
 
     // 7. Actualizar sprite según estado
@@ -241,27 +250,25 @@ void Goku1::mientrasTocaObstaculo() {
 /**
 @brief Ejecuta la animación de patada de Goku1, utilizada específicamente en el Nivel 1.
 
-Este método reproduce dos frames de ataque (`frames[3]` y `frames[4]`) con una pausa de 200 milisegundos entre ellos para simular el movimiento de una patada.
+Este método reproduce dos frames de ataque (`frames[3]` y `frames[4]`) durante 200 milisegundos cada uno para simular el movimiento de una patada.
 
-- Se llama a `QCoreApplication::processEvents()` para forzar la actualización de la interfaz gráfica entre los cambios de frame.
+- Goku deja de avanzar mientras patea; el resto del juego sigue corriendo.
+- La animación la lleva `secuenciaPatada` en el bucle central; el método vuelve enseguida.
 - Al finalizar la animación, se llama a `detener()` para detener el movimiento de Goku1 y restaurar su estado neutral.
 
 @note Este método está diseñado para usarse en el evento especial de enfrentamiento con el carro en el Nivel 1.
 */
 void Goku1::patadaGokuNivel1() {
-    actualizarFrame(3); // patada frame 1
-    QCoreApplication::processEvents();
-    QThread::msleep(200);
-    actualizarFrame(4); // patada frame 2
-    QCoreApplication::processEvents();
-    QThread::msleep(200);
-    detener();
+    if (tareaMovimiento && tareaMovimiento->estaActiva())
+        tareaMovimiento->detener();
+
+    secuenciaPatada->iniciar();
 }
 
 /**
 @brief Detiene el movimiento de Goku1 y restablece su sprite a la posición neutra.
 
-Este método se encarga de detener el temporizador de movimiento si está activo, desactivar las banderas de movimiento vertical
+Este método se encarga de detener la tarea de movimiento si está activa, desactivar las banderas de movimiento vertical
 (`mvtoArriba` y `mvtoAbajo`) y actualizar el sprite al frame neutral (`frames[1]`).
 
 Se utiliza, por ejemplo, después de realizar una acción como una patada o al finalizar una secuencia especial.
@@ -269,8 +276,8 @@ Se utiliza, por ejemplo, después de realizar una acción como una patada o al f
 @see Goku1::patadaGokuNivel1()
 */
 void Goku1::detener() {
-    if (timerMovimiento && timerMovimiento->isActive())
-        timerMovimiento->stop();
+    if (tareaMovimiento && tareaMovimiento->estaActiva())
+        tareaMovimiento->detener();
 
     mvtoArriba = mvtoAbajo = false;
     actualizarFrame(1);
@@ -279,60 +286,65 @@ void Goku1::detener() {
 /**
 @brief Detecta si Goku1 está colisionando con un carro u obstáculo.
 
-Este método recorre los elementos con los que Goku1 está colisionando y retorna una cadena identificadora
-si alguno de ellos tiene la etiqueta `"carro"` o `"obstaculo"` en su `data(0)`.
+Este método consulta al mundo de colisiones los cuerpos de los tipos de su máscara (obstáculos y carro)
+que se superponen con Goku1 y retorna el tipo del primero que colisiona.
 
-@return `"carro"` si colisiona con un carro, `"obstaculo"` si colisiona con un obstáculo, o cadena vacía (`""`) si no hay colisión relevante.
+@return `EntidadCarro` si colisiona con un carro, `EntidadObstaculo` si colisiona con un obstáculo, o `EntidadNinguna` si no hay colisión relevante.
 */
-QString Goku1::detectarColision() const {
-    const QList<QGraphicsItem*> items = collidingItems();
-    for (QGraphicsItem* const& item : items) {
-        QString etiqueta = item->data(0).toString();
-        if (etiqueta == "carro" || etiqueta == "obstaculo")
-            return etiqueta;
-    }
-    return "";
+TipoEntidad Goku1::detectarColision() const {
+    MundoColisiones* mundo = MundoColisiones::instancia();
+
+    TipoEntidad tipo = EntidadNinguna;
+    mundo->consultar(sceneBoundingRect(), mundo->mascara(cuerpo), [&](int id) {
+        if (!collidesWithItem(mundo->item(id)))
+            return true;
+
+        tipo = static_cast<TipoEntidad>(mundo->categoria(id));
+        return false;
+    }, cuerpo);
+    return tipo;
 }
 
 /**
 @brief Indica si Goku1 ha colisionado con un carro en el último ciclo de movimiento.
 
-@return `true` si se detectó una colisión con un objeto etiquetado como "carro", `false` en caso contrario.
+@return `true` si se detectó una colisión con un cuerpo de tipo `EntidadCarro`, `false` en caso contrario.
 */
 bool Goku1::haTocadoCarro() const { return tocoCarro; }
 
 /**
 @brief Indica si Goku1 ha colisionado con un obstáculo en el último ciclo de movimiento.
 
-@return `true` si se detectó una colisión con un objeto etiquetado como "obstaculo", `false` en caso contrario.
+@return `true` si se detectó una colisión con un cuerpo de tipo `EntidadObstaculo`, `false` en caso contrario.
 */
 bool Goku1::haTocadoObstaculo() const { return tocoObstaculo; }
 
 /**
 @brief Destructor de la clase `Goku1`.
 
-Libera los recursos asociados a los temporizadores de movimiento (`timerMovimiento`) y de daño (`timerDanio`).
+Libera los recursos asociados a las tareas de movimiento (`tareaMovimiento`) y de daño (`tareaDanio`).
 
-- Detiene y desconecta los temporizadores si están activos.
+- Detiene las tareas y las quita del bucle central.
 - Libera la memoria asociada a ellos y deja los punteros en `nullptr`.
 
-Este destructor asegura una limpieza adecuada de recursos específicos de `Goku1`, evitando fugas de memoria y conflictos con el sistema de señales de Qt.
+Este destructor asegura una limpieza adecuada de recursos específicos de `Goku1`, evitando fugas de memoria y tareas colgantes en el bucle central.
 */
 Goku1::~Goku1()
 {
     qDebug() << "Destructor de Goku1 llamado";
 
-    if (timerMovimiento) {
-        timerMovimiento->stop();
-        disconnect(timerMovimiento, nullptr, this, nullptr);
-        delete timerMovimiento;
-        timerMovimiento = nullptr;
+    if (tareaMovimiento) {
+        tareaMovimiento->detener();
+        delete tareaMovimiento;
+        tareaMovimiento = nullptr;
     }
 
-    if (timerDanio) {
-        timerDanio->stop();
-        disconnect(timerDanio, nullptr, this, nullptr);
-        delete timerDanio;
-        timerDanio = nullptr;
+    if (tareaDanio) {
+        tareaDanio->detener();
+        delete tareaDanio;
+        tareaDanio = nullptr;
     }
+
+    delete secuenciaPatada;
+    secuenciaPatada = nullptr;
 }
@@ -2,8 +2,8 @@
 #define GOKU1_H
 
 #include "goku.h"
-#include <QTimer>
-#include <QString>
+#include "tipoentidad.h"
+#include "secuenciaacciones.h"
 
 class Goku1 : public Goku {
     Q_OBJECT
@@ -18,7 +18,7 @@ public:
     void detener() override;
     void cargarImagen() override;
 
-    QString detectarColision() const;
+    TipoEntidad detectarColision() const;   // Tipo del primer cuerpo que toca
     bool haTocadoCarro() const;
     bool haTocadoObstaculo() const;
     void patadaGokuNivel1();
@@ -33,8 +33,9 @@ private:
     void mientrasTocaObstaculo();    //Slots privados
 
     QVector<QPixmap> frames;        // Frames del sprite
-    QTimer* timerMovimiento;        // Timer para mover a Goku
-    QTimer* timerDanio;             // Timer entre daños
+    TareaBucle* tareaMovimiento;    // Tarea del bucle para mover a Goku
+    TareaBucle* tareaDanio;         // Tarea entre daños
+    SecuenciaAcciones* secuenciaPatada;   // Frames de la patada del nivel 1
 
     int frameActual;                // Frame actual del sprite
     int contadorCaminata;           // Control para animación de caminar
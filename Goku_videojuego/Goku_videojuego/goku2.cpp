@@ -1,9 +1,9 @@
 #include "goku2.h"
 #include "nivel2.h"
 #include "pocion.h"
+#include "spritecache.h"
 #include <QKeyEvent>
 #include <QTimer>
-#include <QTransform>
 #include <QPixmap>
 #include <QDebug>
 #include <stdexcept>  // Excepciones estándar
@@ -16,10 +16,11 @@ int Goku2::contador = 0;
 
 Inicializa los parámetros específicos de movimiento lateral y salto, además de asociar el personaje al nivel correspondiente (`Nivel2`).
 
-- Crea y conecta tres temporizadores:
-  - `timerMovimiento` para movimiento horizontal.
-  - `timerSalto` para simular la física del salto.
-  - `timerDanio` para controlar la inmunidad temporal tras recibir daño.
+- Registra en el bucle central las tareas del personaje:
+  - `tareaMovimiento` para movimiento horizontal.
+  - `tareaSalto` para simular la física del salto.
+  - `tareaDanio` para controlar la inmunidad temporal tras recibir daño.
+  - Las tareas de las animaciones especiales (muerte, Kamehameha, avance y regreso), inactivas hasta que se usan.
 - Establece parámetros iniciales como la gravedad, posición del suelo (`sueloY`) y estado de salto.
 - Configura un efecto de sonido (`salto`) que se reproduce al saltar.
 
@@ -47,21 +48,29 @@ Goku2::Goku2(QGraphicsScene* scene, int velocidad, int fotogWidth, int fotogHeig
         throw std::invalid_argument("Goku2: el puntero a Nivel2 no puede ser nulo.");
     }
 
-    // Timer para movimiento lateral continuo
-    timerMovimiento = new QTimer(this);
-    connect(timerMovimiento, &QTimer::timeout, this, &Goku2::mover);
+    // En el nivel 2 Goku recibe daño de las explosiones y recoge pociones
+    MundoColisiones::instancia()->setMascara(cuerpo, EntidadExplosion | EntidadPocion);
 
-    // Timer para física del salto
-    timerSalto = new QTimer(this);
-    connect(timerSalto, &QTimer::timeout, this, &Goku2::actualizarSalto);
+    // Tarea para movimiento lateral continuo
+    tareaMovimiento = new TareaBucle(BucleJuego::FaseJugador, [this]() { mover(); }, this, "mover");
 
-    // Timer que controla inmunidad temporal tras recibir daño
-    timerDanio = new QTimer(this);
-    connect(timerDanio, &QTimer::timeout, this, [=]() {
+    // Tarea para física del salto
+    tareaSalto = new TareaBucle(BucleJuego::FaseJugador, [this]() { actualizarSalto(); }, this, "actualizarSalto");
+
+    // Tarea que controla inmunidad temporal tras recibir daño
+    tareaDanio = new TareaBucle(BucleJuego::FaseJugador, [this]() {
 
         //qDebug() << "timer danio goku2 llamado  "<<contador++;
         puedeRecibirDanio = true;
-    });
+    }, this, "finInmunidad");
+    tareaDanio->setUnaVez(true);
+
+    // Tareas de las animaciones especiales
+    tareaMuerte = new TareaBucle(BucleJuego::FaseJugador, [this]() { avanzarMuerte(); }, this, "avanzarMuerte");
+    tareaAnimSalto = new TareaBucle(BucleJuego::FaseJugador, [this]() { avanzarAnimSalto(); }, this, "avanzarAnimSalto");
+    tareaAvance = new TareaBucle(BucleJuego::FaseJugador, [this]() { avanzarHaciaRobot(); }, this, "avanzarHaciaRobot");
+    tareaAnimAtaque = new TareaBucle(BucleJuego::FaseJugador, [this]() { avanzarAnimAtaque(); }, this, "avanzarAnimAtaque");
+    tareaRegreso = new TareaBucle(BucleJuego::FaseJugador, [this]() { avanzarRegreso(); }, this, "avanzarRegreso");
 
     //Para sonido
     salto = new QMediaPlayer;
@@ -74,9 +83,10 @@ Goku2::Goku2(QGraphicsScene* scene, int velocidad, int fotogWidth, int fotogHeig
 /**
 @brief Destructor de la clase `Goku2`.
 
-Libera todos los recursos asociados al personaje en el segundo nivel del juego, incluyendo temporizadores y componentes de audio.
+Libera todos los recursos asociados al personaje en el segundo nivel del juego, incluyendo tareas del bucle y componentes de audio.
 
-- Detiene y desconecta los temporizadores de movimiento, salto e inmunidad (`timerMovimiento`, `timerSalto`, `timerDanio`).
+- Detiene y quita del bucle central las tareas de movimiento, salto e inmunidad (`tareaMovimiento`, `tareaSalto`, `tareaDanio`).
+- Las tareas de animaciones especiales se liberan automáticamente al ser hijas del personaje.
 - Elimina los objetos de audio utilizados para reproducir el sonido de salto (`QMediaPlayer` y `QAudioOutput`).
 - Establece los punteros a `nullptr` para evitar accesos colgantes.
 
@@ -86,25 +96,22 @@ Goku2::~Goku2()
 {
     qDebug() << "Destructor de Goku2 llamado";
 
-    if (timerMovimiento) {
-        timerMovimiento->stop();
-        disconnect(timerMovimiento, nullptr, this, nullptr);
-        delete timerMovimiento;
-        timerMovimiento = nullptr;
+    if (tareaMovimiento) {
+        tareaMovimiento->detener();
+        delete tareaMovimiento;
+        tareaMovimiento = nullptr;
     }
 
-    if (timerSalto) {
-        timerSalto->stop();
-        disconnect(timerSalto, nullptr, this, nullptr);
-        delete timerSalto;
-        timerSalto = nullptr;
+    if (tareaSalto) {
+        tareaSalto->detener();
+        delete tareaSalto;
+        tareaSalto = nullptr;
     }
 
-    if (timerDanio) {
-        timerDanio->stop();
-        disconnect(timerDanio, nullptr, this, nullptr);
-        delete timerDanio;
-        timerDanio = nullptr;
+    if (tareaDanio) {
+        tareaDanio->detener();
+        delete tareaDanio;
+        tareaDanio = nullptr;
     }
 
     //liberar sonido
@@ -114,24 +121,99 @@ Goku2::~Goku2()
 }
 
 /**
-@brief Carga el sprite inicial del personaje Goku2.
-
-Este método intenta cargar la imagen `Goku_caminando.png` desde los recursos del sistema.
-Si falla, realiza un intento alternativo desde la ruta local `imagenes/Goku_caminando.png`.
+@brief Carga todas las animaciones de Goku2 y muestra el sprite inicial.
 
-- Si la imagen se carga correctamente, se asigna el primer frame (posición 0,0) al `pixmap` del personaje con las dimensiones `fotogWidth` y `fotogHeight`.
+Este método llama a `cargarClips()` para dejar listas todas las animaciones del personaje y
+asigna el primer frame de la caminata (posición 0,0) al `pixmap` del personaje.
 
-@throw std::runtime_error Si no se encuentra la imagen requerida.
+@throw std::runtime_error Si no se encuentra alguna de las imágenes requeridas.
 */
 void Goku2::cargarImagen() {
-    QPixmap sprite(":/images/Goku_caminando.png");
-    if (sprite.isNull()) sprite.load("imagenes/Goku_caminando.png");
+    cargarClips();
+    reproducir(ClipCaminar);
+}
+
+/**
+@brief Precarga los clips de animación de Goku2.
+
+Cada clip guarda sus frames tal como vienen en la hoja, los mismos frames ya volteados para
+cuando Goku2 mira a la izquierda y la duración de cada frame. Las hojas se obtienen de
+`SpriteCache` (desde los recursos o, si falla, desde la ruta local `imagenes/`), de modo que
+durante el juego cambiar de animación es solo elegir un índice.
+
+- `ClipCaminar`: todos los frames de `Goku_caminando.png` (`fotogWidth` x `fotogHeight`), 60 ms cada uno.
+- `ClipSaltar`: primer frame de `Goku_saltando.png`.
+- `ClipMuerte`: 6 frames de `Goku_muere.png`, 50 ms cada uno.
+- `ClipKamSalto`: 6 frames de `Goku_kam1.png`, 100 ms cada uno. No se voltea.
+- `ClipKamAtaque`: 8 frames de `Goku_kam2.png`, 80 ms cada uno. No se voltea.
+
+@throw std::runtime_error Si no se encuentra alguna de las hojas de sprites.
+*/
+void Goku2::cargarClips() {
+    SpriteCache* cache = SpriteCache::instancia();
+
+    struct Definicion {
+        Clip clip;
+        const char* ruta;
+        int ancho, alto, cantidad, msPorFrame;
+        bool seVoltea;
+    };
+
+    const Definicion definiciones[NumClips] = {
+        { ClipCaminar,   ":/images/Goku_caminando.png", fotogWidth, fotogHeight, 0, 60,  true  },
+        { ClipSaltar,    ":/images/Goku_saltando.png",  200, 256, 1, 0,   true  },
+        { ClipMuerte,    ":/images/Goku_muere.png",     280, 298, 6, 50,  true  },
+        { ClipKamSalto,  ":/images/Goku_kam1.png",      200, 262, 6, 100, false },
+        { ClipKamAtaque, ":/images/Goku_kam2.png",      325, 347, 8, 80,  false }
+    };
+
+    for (const Definicion& d : definiciones) {
+        ClipAnimacion& clip = clips[d.clip];
+        clip.derecha = cache->frames(d.ruta, d.ancho, d.alto, d.cantidad);
+
+        if (clip.derecha.isEmpty()) {
+            throw std::runtime_error(QString("Goku2::cargarClips - No se encontró %1.")
+                                         .arg(d.ruta).toStdString());
+        }
 
-    if (sprite.isNull()) {
-        throw std::runtime_error("Goku2::cargarImagen - No se encontró Goku_caminando.png.");
+        clip.izquierda = d.seVoltea ? cache->espejados(clip.derecha) : clip.derecha;
+        clip.msPorFrame = d.msPorFrame;
     }
+}
+
+/**
+@brief Cambia al clip indicado y muestra su primer frame.
+
+@param clip Clip de animación a reproducir.
+*/
+void Goku2::reproducir(Clip clip) {
+    clipActual = clip;
+    frameClip = 0;
+    msEnFrame = 0;
+    mostrarFrame();
+}
+
+/**
+@brief Muestra el siguiente frame del clip actual.
+
+@return `false` si el clip ya estaba en su último frame (no se cambia nada), `true` en otro caso.
+*/
+bool Goku2::avanzarClip() {
+    if (frameClip + 1 >= clips[clipActual].derecha.size())
+        return false;
 
-    setPixmap(sprite.copy(0, 0, fotogWidth, fotogHeight));
+    ++frameClip;
+    mostrarFrame();
+    return true;
+}
+
+/**
+@brief Asigna al personaje el frame actual, eligiendo la versión según hacia dónde mira.
+*/
+void Goku2::mostrarFrame() {
+    const ClipAnimacion& clip = clips[clipActual];
+    setPixmap(mirandoDerecha ? clip.derecha[frameClip] : clip.izquierda[frameClip]);
+    actualizarCuerpo();  // Los clips tienen tamaños distintos
 }
 
 /**
@@ -139,35 +221,36 @@ void Goku2::cargarImagen() {
 
 Este método establece la posición inicial del personaje en `(x, y)` y actualiza la altura del suelo (`sueloY`) para las físicas de salto.
 
-- Verifica que el temporizador de movimiento (`timerMovimiento`) esté correctamente inicializado.
-- Inicia el temporizador para que el personaje comience a moverse de forma continua.
+- Verifica que la tarea de movimiento (`tareaMovimiento`) esté correctamente inicializada.
+- Inicia la tarea para que el personaje comience a moverse de forma continua.
 
 @param x Coordenada horizontal inicial.
 @param y Coordenada vertical inicial (también define la posición del suelo).
 
-@throw std::runtime_error Si el temporizador de movimiento no ha sido inicializado.
+@throw std::runtime_error Si la tarea de movimiento no ha sido inicializada.
 */
 void Goku2::iniciar(int x, int y) {
     setPos(x, y);
+    actualizarCuerpo();
     sueloY = y;
 
-    if (!timerMovimiento) {
-        throw std::runtime_error("Goku2::iniciar - Timer de movimiento no inicializado.");
+    if (!tareaMovimiento) {
+        throw std::runtime_error("Goku2::iniciar - Tarea de movimiento no inicializada.");
     }
 
-    timerMovimiento->start(60);
+    tareaMovimiento->iniciar(msPaso);
 }
 
 /**
 @brief Actualiza la posición y el estado visual de Goku2 durante el movimiento lateral.
 
-Este método es llamado periódicamente por el `timerMovimiento` y realiza lo siguiente:
+Este método es llamado periódicamente por la `tareaMovimiento` y realiza lo siguiente:
 
 - Calcula la nueva posición horizontal según las banderas `mvtoIzquierda` y `mvtoDerecha`.
 - Restringe el movimiento dentro de los límites de la escena.
 - Si Goku2 no está en salto, actualiza su sprite de caminata según la dirección.
 - Corrige la posición vertical si excede los límites de la escena.
-- Detecta colisiones con objetos etiquetados como `"explosion"`, aplica daño y activa un período de inmunidad de 1 segundo.
+- Consulta al `MundoColisiones` los proyectiles (explosiones) cercanos; si alguno colisiona, aplica daño y activa un período de inmunidad de 1 segundo.
 
 Este método es clave para el control de movimiento lateral y la detección de daño en el Nivel 2.
 
@@ -186,8 +269,8 @@ void Goku2::mover() {
     setX(nuevaX);
 
     if (!enSalto) {
-        if (mvtoDerecha) actualizarSpriteCaminar(true);
-        else if (mvtoIzquierda) actualizarSpriteCaminar(false);
+        if (mvtoDerecha) actualizarSpriteCaminar(true, msPaso);
+        else if (mvtoIzquierda) actualizarSpriteCaminar(false, msPaso);
     }
 
     // Corrección de límites verticales
@@ -195,23 +278,29 @@ void Goku2::mover() {
     if (y() + pixmap().height() > scene->height())
         setY(scene->height() - pixmap().height());
 
+    actualizarCuerpo();
+
     // Colisión con explosión: daño temporal
-    const QList<QGraphicsItem*> colisiones = collidingItems();
-    for (int i = 0; i < colisiones.size(); ++i) {
-        QGraphicsItem* item = colisiones[i];
-        QString etiqueta = item->data(0).toString();
-        if (etiqueta == "explosion" && puedeRecibirDanio) {
-            recibirDanio(20);
-            puedeRecibirDanio = false;
-            timerDanio->start(1000);  // 1 segundo de inmunidad
-        }
+    if (!puedeRecibirDanio) return;
+
+    MundoColisiones* mundo = MundoColisiones::instancia();
+    bool golpeado = false;
+    mundo->consultar(sceneBoundingRect(), mundo->mascara(cuerpo) & EntidadExplosion, [&](int id) {
+        golpeado = collidesWithItem(mundo->item(id));
+        return !golpeado;
+    }, cuerpo);
+
+    if (golpeado) {
+        recibirDanio(20);
+        puedeRecibirDanio = false;
+        tareaDanio->iniciar(1000);  // 1 segundo de inmunidad
     }
 }
 
 /**
 @brief Aplica la física del salto y actualiza la posición vertical de Goku2.
 
-Este método es llamado periódicamente por el `timerSalto` durante el salto del personaje. Simula una trayectoria ascendente y descendente
+Este método es llamado periódicamente por la `tareaSalto` durante el salto del personaje. Simula una trayectoria ascendente y descendente
 mediante una velocidad vertical afectada por la gravedad.
 
 - Incrementa `velocidadVertical` para simular la aceleración de caída.
@@ -232,19 +321,21 @@ void Goku2::actualizarSalto() {
         enSalto = false;
         velocidadVertical = 0;
 
-        if (timerSalto) timerSalto->stop();
+        if (tareaSalto) tareaSalto->detener();
 
-        actualizarSpriteCaminar(mirandoDerecha);
+        actualizarSpriteCaminar(mirandoDerecha, 0);
     }
 
     setY(nuevaY);
+    actualizarCuerpo();
     detectarPocion();
 }
 
 /**
 @brief Detecta y gestiona la recolección de pociones por parte de Goku2.
 
-Este método verifica si el personaje colisiona con algún objeto del tipo `Pocion`. Si encuentra una colisión válida:
+Este método consulta al mundo de colisiones las pociones (tipo `EntidadPocion`) que se superponen con el personaje
+y confirma cada una con su forma exacta. Si encuentra una colisión válida:
 
 - Detiene su animación (`detener()`).
 - Oculta la poción visualmente (`setVisible(false)`), la desactiva (`setEnabled(false)`) y la relega al fondo (`setZValue(-100)`).
@@ -257,10 +348,16 @@ Este método se invoca automáticamente en eventos como el salto (`actualizarSal
 @see Nivel2::pocionRecolectada
 */
 void Goku2::detectarPocion() {
-    QList<QGraphicsItem*> colisiones = collidingItems();
-    for (int i = 0; i < colisiones.size(); ++i) {
-        Pocion* pocion = dynamic_cast<Pocion*>(colisiones[i]);
-        if (pocion) {
+    MundoColisiones* mundo = MundoColisiones::instancia();
+
+    // Se copian a un buffer porque recolectar una poción puede crear otras
+    int candidatas[8];
+    const int cantidad = mundo->recolectar(sceneBoundingRect(), mundo->mascara(cuerpo) & EntidadPocion,
+                                           candidatas, 8, cuerpo);
+
+    for (int i = 0; i < cantidad; ++i) {
+        Pocion* pocion = qobject_cast<Pocion*>(mundo->dueno(candidatas[i]));
+        if (pocion && collidesWithItem(pocion)) {
             // Solo ocultarla de la escena
             pocion->detener();// Detiene su animacion
             pocion->setVisible(false);// No se ve
@@ -281,7 +378,7 @@ void Goku2::detectarPocion() {
 
 Este método responde a tres teclas:
 
-- `W`: inicia un salto si Goku2 no está ya en el aire. Configura la velocidad vertical, activa el `timerSalto` y reproduce el sonido correspondiente.
+- `W`: inicia un salto si Goku2 no está ya en el aire. Configura la velocidad vertical, activa la `tareaSalto` y reproduce el sonido correspondiente.
 - `D`: activa el movimiento hacia la derecha (`mvtoDerecha = true`).
 - `A`: activa el movimiento hacia la izquierda (`mvtoIzquierda = true`).
 
@@ -289,18 +386,18 @@ También actualiza el sprite del salto al despegar del suelo.
 
 @param event Evento de teclado generado por Qt.
 
-@throw std::runtime_error Si el temporizador de salto (`timerSalto`) no ha sido inicializado.
+@throw std::runtime_error Si la tarea de salto (`tareaSalto`) no ha sido inicializada.
 */
 void Goku2::keyPressEvent(QKeyEvent* event) {
     if (event->key() == Qt::Key_W && !enSalto) {
         enSalto = true;
         velocidadVertical = -15.0f;
 
-        if (!timerSalto) {
-            throw std::runtime_error("Goku2::keyPressEvent - timerSalto no está inicializado.");
+        if (!tareaSalto) {
+            throw std::runtime_error("Goku2::keyPressEvent - tareaSalto no está inicializada.");
         }
 
-        timerSalto->start(16);
+        tareaSalto->iniciar(16);
         actualizarSpriteSalto();
 
         salto->stop();
@@ -333,67 +430,50 @@ void Goku2::keyReleaseEvent(QKeyEvent* event) {
 /**
 @brief Actualiza el sprite de Goku2 durante la caminata y ajusta su orientación.
 
-Este método cambia el frame del sprite para animar la caminata de Goku2, avanzando de forma cíclica
-entre los distintos recortes de la hoja de imagen `Goku_caminando.png`.
+Este método avanza de forma cíclica por los frames del clip `ClipCaminar` según su `msPorFrame`, igual
+que los demás clips, y no según el periodo de la tarea que lo llama: el tiempo recibido se acumula y el
+frame cambia cada vez que el acumulado alcanza la duración de un frame.
 
-- Si el personaje cambia de dirección, se invierte horizontalmente el sprite usando una transformación (`QTransform`).
 - La dirección del personaje se actualiza mediante la variable `mirandoDerecha`.
+- Si mira a la izquierda se usan los frames ya volteados del clip, sin aplicar ninguna transformación.
+- Aunque el frame no cambie, la caja de colisión se actualiza con la posición actual.
 
 @param derecha Indica si Goku2 se está moviendo hacia la derecha (`true`) o hacia la izquierda (`false`).
-
-@throw std::runtime_error Si no se encuentra la imagen del sprite.
+@param ms Tiempo transcurrido desde el paso anterior de la caminata, en milisegundos.
 */
 
-void Goku2::actualizarSpriteCaminar(bool derecha) {
-    QPixmap sprite(":/images/Goku_caminando.png");
-    if (sprite.isNull()) sprite.load("imagenes/Goku_caminando.png");
-    if (sprite.isNull()) {
-        throw std::runtime_error("Goku2::actualizarSpriteCaminar - No se encontró el sprite.");
-    }
+void Goku2::actualizarSpriteCaminar(bool derecha, int ms) {
+    const bool giro = (derecha != mirandoDerecha);
+    mirandoDerecha = derecha;
 
-    static int frameIndex = 0;
-    int totalFrames = sprite.width() / fotogWidth;
-    frameIndex = (frameIndex + 1) % totalFrames;
+    if (clipActual != ClipCaminar) {
+        reproducir(ClipCaminar);
+        return;
+    }
 
-    setPixmap(sprite.copy(frameIndex * fotogWidth, 0, fotogWidth, fotogHeight));
+    const ClipAnimacion& clip = clips[ClipCaminar];
+    bool cambio = giro;
 
-    if (mirandoDerecha != derecha) {
-        mirandoDerecha = derecha;
-        QTransform transform;
-        if (!mirandoDerecha) {
-            transform.scale(-1, 1);
-            transform.translate(-pixmap().width(), 0);
-        }
-        setTransform(transform);
+    msEnFrame += ms;
+    while (clip.msPorFrame > 0 && msEnFrame >= clip.msPorFrame) {
+        msEnFrame -= clip.msPorFrame;
+        frameClip = (frameClip + 1) % clip.derecha.size();
+        cambio = true;
     }
+
+    if (cambio) mostrarFrame();
+    else actualizarCuerpo();
 }
 
 /**
 @brief Cambia el sprite de Goku2 para representar visualmente que está en el aire durante un salto.
 
-Este método carga el sprite `Goku_saltando.png` y asigna el primer frame al personaje.
-Además, ajusta su orientación horizontal dependiendo de la dirección en la que está mirando (`mirandoDerecha`).
-
-- Si `mirandoDerecha` es `false`, se aplica una transformación para voltear el sprite horizontalmente.
-
-@throw std::runtime_error Si no se encuentra la imagen del sprite de salto.
+Este método cambia al clip `ClipSaltar`, cuya versión (normal o volteada) depende de la dirección
+en la que está mirando (`mirandoDerecha`).
 */
 
 void Goku2::actualizarSpriteSalto() {
-    QPixmap sprite(":/images/Goku_saltando.png");
-    if (sprite.isNull()) sprite.load("imagenes/Goku_saltando.png");
-    if (sprite.isNull()) {
-        throw std::runtime_error("Goku2::actualizarSpriteSalto - No se encontró el sprite.");
-    }
-
-    setPixmap(sprite.copy(0, 0, 200, 256));
-
-    QTransform transform;
-    if (!mirandoDerecha) {
-        transform.scale(-1, 1);
-        transform.translate(-pixmap().width(), 0);
-    }
-    setTransform(transform);
+    reproducir(ClipSaltar);
 }
 
 /**
@@ -409,7 +489,7 @@ void Goku2::setSueloY(float y) {
 }
 
 /**
-@brief Detiene todos los temporizadores activos de movimiento y salto de Goku2.
+@brief Detiene las tareas activas de movimiento y salto de Goku2.
 
 Este método se utiliza para pausar completamente al personaje, por ejemplo, durante animaciones especiales
 o al finalizar una acción. No modifica la posición ni el estado visual.
@@ -418,114 +498,92 @@ o al finalizar una acción. No modifica la posición ni el estado visual.
 @see Goku2::animarMuerte
 */
 void Goku2::detener() {
-    if (timerMovimiento) timerMovimiento->stop();
-    if (timerSalto) timerSalto->stop();
+    if (tareaMovimiento) tareaMovimiento->detener();
+    if (tareaSalto) tareaSalto->detener();
 }
 
 /**
 @brief Ejecuta la animación de muerte de Goku2 utilizando una secuencia de frames.
 
-Este método carga la hoja de sprites `Goku_muere.png`, extrae 6 frames y los reproduce en secuencia para mostrar
+Este método reproduce el clip precargado `ClipMuerte` (6 frames de `Goku_muere.png`) para mostrar
 una animación fluida de muerte. Durante la animación:
 
 - Se detiene el movimiento del personaje (`detener()`).
-- Se actualiza el `pixmap` cada 50 ms mediante un `QTimer`.
+- Se actualiza el `pixmap` cada 50 ms mediante la tarea `tareaMuerte` del bucle central.
 - Una vez completada la animación, el movimiento puede reanudarse (opcionalmente).
 
 @note La animación de muerte es visual únicamente; el control de game over debe manejarse externamente.
-
-@throw std::runtime_error Si no se encuentra la imagen de la animación de muerte.
 */
 void Goku2::animarMuerte() {
-    QPixmap spriteSheet(":/images/Goku_muere.png");
-    if (spriteSheet.isNull()) {
-        throw std::runtime_error("Goku2::animarMuerte - No se encontró Goku_muere.png.");
-    }
-
-    QVector<QPixmap> framesMuerte;
-    const int anchoFrame = 280;
-    const int altoFrame = 298;
-
-    for (int i = 0; i < 6; ++i) {
-        framesMuerte.append(spriteSheet.copy(i * anchoFrame, 0, anchoFrame, altoFrame));
-    }
-
     detener();  // Detener movimiento mientras muere
 
-    int* index = new int(0);  // Índice dinámico para animación
-    timerMuerte = new QTimer(this);  // Se destruye automáticamente
+    reproducir(ClipMuerte);
+    tareaMuerte->iniciar(clips[ClipMuerte].msPorFrame);
+}
 
-    connect(timerMuerte, &QTimer::timeout, this, [=]() mutable {
+/**
+@brief Avanza un frame de la animación de muerte de Goku2.
 
-        //qDebug() << "timer muerte goku2 llamado  " <<contador++;
-        if (*index < framesMuerte.size()) {
-            this->setPixmap(framesMuerte[*index]);
-            (*index)++;
-        } else {
-            timerMuerte->stop();
-            timerMuerte->deleteLater();
-            delete index;
+Al mostrar el último frame detiene la tarea `tareaMuerte` y reanuda el movimiento lateral.
 
-            // Reanudar movimiento después de morir (opcional)
-            timerMovimiento->start(60);
-        }
-    });
+@see Goku2::animarMuerte
+*/
+void Goku2::avanzarMuerte() {
+
+    //qDebug() << "timer muerte goku2 llamado  " <<contador++;
+    if (!avanzarClip()) {
+        tareaMuerte->detener();
 
-    timerMuerte->start(50);  // 50 ms entre frames para una animación fluida
+        // Reanudar movimiento después de morir (opcional)
+        tareaMovimiento->iniciar(msPaso);
+    }
 }
 
 /**
 @brief Inicia la animación del salto previo al ataque Kamehameha de Goku2.
 
-Este método detiene cualquier movimiento actual y reproduce una animación de salto compuesta por 6 frames
-extraídos de `Goku_kam1.png`. Cada frame se muestra con un intervalo de 100 ms utilizando un temporizador (`animSalto`).
+Este método detiene cualquier movimiento actual y reproduce el clip `ClipKamSalto` (6 frames de `Goku_kam1.png`).
+Cada frame se muestra con un intervalo de 100 ms utilizando la tarea `tareaAnimSalto`.
 
 Una vez completada la animación de salto, se invoca `caminarHaciaRobot()` para que Goku2 se acerque al enemigo antes de lanzar el ataque.
 
 @param xObjetivo Coordenada horizontal del robot objetivo.
 @param robotObjetivo Puntero al objeto `Robot` que será atacado.
 
-@throw std::runtime_error Si no se puede cargar el sprite de salto.
 @see Goku2::caminarHaciaRobot
 */
 void Goku2::iniciarKamehameha(float xObjetivo, Robot* robotObjetivo) {
     detener();  // Detener cualquier movimiento previo
 
-    QVector<QPixmap> framesSalto;
-    QPixmap spriteSalto(":/images/Goku_kam1.png");
-    const int w1 = 200, h1 = 262;
+    this->xObjetivo = xObjetivo;
+    this->robotObjetivo = robotObjetivo;
 
-    for (int i = 0; i < 6; ++i)
-        framesSalto.append(spriteSalto.copy(i * w1, 0, w1, h1));
+    reproducir(ClipKamSalto);
+    tareaAnimSalto->iniciar(clips[ClipKamSalto].msPorFrame);
+}
 
-    int* index = new int(0);
-    animSalto = new QTimer(this);
+/**
+@brief Avanza un frame de la animación de salto previa al Kamehameha.
 
-    connect(animSalto, &QTimer::timeout, this, [=]() mutable {
+Al terminar la animación detiene `tareaAnimSalto` y hace que Goku2 camine hacia el robot objetivo.
 
-        //qDebug() << "timer animsalto goku2 llamado  "<<contador++;
-        if (*index < framesSalto.size()) {
-            setPixmap(framesSalto[*index]);
-            setTransform(QTransform());
-            setScale(1.0);
-            (*index)++;
-        } else {
-            animSalto->stop();
-            animSalto->deleteLater();
-            delete index;
+@see Goku2::iniciarKamehameha
+*/
+void Goku2::avanzarAnimSalto() {
 
-            // Camina hacia el robot después del salto
-            caminarHaciaRobot(xObjetivo, robotObjetivo);
-        }
-    });
+    //qDebug() << "timer animsalto goku2 llamado  "<<contador++;
+    if (!avanzarClip()) {
+        tareaAnimSalto->detener();
 
-    animSalto->start(100);  // 100 ms por frame
+        // Camina hacia el robot después del salto
+        caminarHaciaRobot(xObjetivo, robotObjetivo);
+    }
 }
 
 /**
 @brief Mueve a Goku2 automáticamente hacia el robot enemigo antes de ejecutar el ataque Kamehameha.
 
-Este método crea un temporizador (`avance`) que desplaza a Goku2 hacia la coordenada `xObjetivo`, avanzando con la velocidad definida.
+Este método activa la tarea `tareaAvance`, que desplaza a Goku2 hacia la coordenada `xObjetivo` avanzando con la velocidad definida.
 Mientras se desplaza, se actualiza el sprite de caminata mirando hacia la derecha.
 
 Cuando Goku2 está lo suficientemente cerca del objetivo (a menos de 50 unidades), se detiene el avance y se llama a `atacarRobot()`.
@@ -536,30 +594,34 @@ Cuando Goku2 está lo suficientemente cerca del objetivo (a menos de 50 unidades
 @see Goku2::atacarRobot
 */
 void Goku2::caminarHaciaRobot(float xObjetivo, Robot* robotObjetivo) {
-    avance = new QTimer(this);
-
-    connect(avance, &QTimer::timeout, this, [=]() mutable {
-
-        //qDebug() << "timer avance goku2 llamado  "<<contador++;
-        qreal xActual = this->x();
-        if (xActual + velocidad < xObjetivo - 50) {
-            setX(xActual + velocidad);
-            actualizarSpriteCaminar(true);
-        } else {
-            avance->stop();
-            avance->deleteLater();
-            atacarRobot(robotObjetivo);  // Comienza ataque una vez cerca
-        }
-    });
+    this->xObjetivo = xObjetivo;
+    this->robotObjetivo = robotObjetivo;
+    tareaAvance->iniciar(msPaso);
+}
 
-    avance->start(60);
+/**
+@brief Avanza un paso de Goku2 hacia el robot objetivo.
+
+@see Goku2::caminarHaciaRobot
+*/
+void Goku2::avanzarHaciaRobot() {
+
+    //qDebug() << "timer avance goku2 llamado  "<<contador++;
+    qreal xActual = this->x();
+    if (xActual + velocidad < xObjetivo - 50) {
+        setX(xActual + velocidad);
+        actualizarSpriteCaminar(true, msPaso);  // También actualiza la caja de colisión
+    } else {
+        tareaAvance->detener();
+        atacarRobot(robotObjetivo);  // Comienza ataque una vez cerca
+    }
 }
 
 /**
 @brief Ejecuta la animación de ataque Kamehameha de Goku2 contra el robot enemigo.
 
-Este método reproduce una secuencia de 8 frames extraídos de `Goku_kam2.png`, mostrando la animación del ataque.
-Cada frame se actualiza cada 80 milisegundos mediante un temporizador (`animAtaque`).
+Este método reproduce el clip `ClipKamAtaque` (8 frames de `Goku_kam2.png`), mostrando la animación del ataque.
+Cada frame se actualiza cada 80 milisegundos mediante la tarea `tareaAnimAtaque`.
 
 Una vez completada la animación:
 - Se llama a `murioRobot()` en el `robotObjetivo` después de 1.3 segundos.
@@ -571,49 +633,43 @@ Una vez completada la animación:
 @see Robot::murioRobot
 */
 void Goku2::atacarRobot(Robot* robotObjetivo) {
-    QVector<QPixmap> framesAtaque;
-    QPixmap spriteAtaque(":/images/Goku_kam2.png");
-    const int w2 = 325, h2 = 347;
-
-    for (int i = 0; i < 8; ++i)
-        framesAtaque.append(spriteAtaque.copy(i * w2, 0, w2, h2));
-
-    int* index = new int(0);
-    animAtaque = new QTimer(this);
-
-    connect(animAtaque, &QTimer::timeout, this, [=]() mutable {
-
-        //qDebug() << "timerataque goku2  llamado  "<<contador++;
-        if (*index < framesAtaque.size()) {
-            setPixmap(framesAtaque[*index]);
-            setTransform(QTransform());
-            setScale(1.0);
-            (*index)++;
-        } else {
-            animAtaque->stop();
-            animAtaque->deleteLater();
-            delete index;
-
-            if (robotObjetivo) {
-                // Llama método de muerte del robot después del ataque
-                QTimer::singleShot(1300, this, [=]() {
-                    robotObjetivo->murioRobot();
-                });
-            }
+    this->robotObjetivo = robotObjetivo;
+
+    reproducir(ClipKamAtaque);
+    tareaAnimAtaque->iniciar(clips[ClipKamAtaque].msPorFrame);
+}
+
+/**
+@brief Avanza un frame de la animación del Kamehameha.
+
+Al terminar, programa la muerte del robot objetivo y hace que Goku2 retroceda.
 
-            // Goku retrocede después del ataque
-            float destino = qMax(0.0, this->x() - 300.0);
-            caminarHaciaIzquierda(destino);
+@see Goku2::atacarRobot
+*/
+void Goku2::avanzarAnimAtaque() {
+
+    //qDebug() << "timerataque goku2  llamado  "<<contador++;
+    if (!avanzarClip()) {
+        tareaAnimAtaque->detener();
+
+        if (robotObjetivo) {
+            // Llama método de muerte del robot después del ataque
+            Robot* objetivo = robotObjetivo;
+            BucleJuego::instancia()->programar(1300, this, [objetivo]() {
+                objetivo->murioRobot();
+            });
         }
-    });
 
-    animAtaque->start(80);  // 80 ms por frame
+        // Goku retrocede después del ataque
+        float destino = qMax(0.0, this->x() - 300.0);
+        caminarHaciaIzquierda(destino);
+    }
 }
 
 /**
 @brief Hace que Goku2 camine automáticamente hacia la izquierda hasta alcanzar una posición objetivo.
 
-Este método crea un temporizador (`regreso`) que mueve a Goku2 hacia la coordenada `xDestino` disminuyendo su posición `x` con cada ciclo.
+Este método activa la tarea `tareaRegreso`, que mueve a Goku2 hacia la coordenada `xDestino` disminuyendo su posición `x` con cada ciclo.
 Durante el movimiento, el sprite se actualiza con la animación de caminata hacia la izquierda.
 
 Una vez alcanzado o superado el destino, se detiene el movimiento, se ajusta la posición final exacta y se actualiza el sprite final.
@@ -621,22 +677,25 @@ Una vez alcanzado o superado el destino, se detiene el movimiento, se ajusta la
 @param xDestino Coordenada horizontal a la que Goku2 debe retroceder tras el ataque.
 */
 void Goku2::caminarHaciaIzquierda(float xDestino) {
-    regreso = new QTimer(this);
-
-    connect(regreso, &QTimer::timeout, this, [=]() mutable {
-
-        //qDebug() << "timer regreso goku2  llamado  "<<contador++;
-        qreal xActual = this->x();
-        if (xActual - velocidad > xDestino) {
-            setX(xActual - velocidad);
-            actualizarSpriteCaminar(false);
-        } else {
-            regreso->stop();
-            regreso->deleteLater();
-            setX(xDestino);
-            actualizarSpriteCaminar(false);
-        }
-    });
+    this->xDestino = xDestino;
+    tareaRegreso->iniciar(msPaso);
+}
 
-    regreso->start(60);
+/**
+@brief Avanza un paso del regreso de Goku2 hacia la izquierda.
+
+@see Goku2::caminarHaciaIzquierda
+*/
+void Goku2::avanzarRegreso() {
+
+    //qDebug() << "timer regreso goku2  llamado  "<<contador++;
+    qreal xActual = this->x();
+    if (xActual - velocidad > xDestino) {
+        setX(xActual - velocidad);
+        actualizarSpriteCaminar(false, msPaso);  // También actualiza la caja de colisión
+    } else {
+        tareaRegreso->detener();
+        setX(xDestino);
+        actualizarSpriteCaminar(false, 0);
+    }
 }
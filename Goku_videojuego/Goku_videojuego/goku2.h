@@ -32,22 +32,62 @@ protected:
     void mover() override;
 
 private:
+    // Animaciones precargadas del personaje
+    enum Clip {
+        ClipCaminar,
+        ClipSaltar,
+        ClipMuerte,
+        ClipKamSalto,
+        ClipKamAtaque,
+        NumClips
+    };
+
+    struct ClipAnimacion {
+        QVector<QPixmap> derecha;     // Frames tal como vienen en la hoja
+        QVector<QPixmap> izquierda;   // Los mismos frames ya volteados
+        int msPorFrame = 0;           // Duración de cada frame
+    };
+
+    void cargarClips();
+    void reproducir(Clip clip);
+    bool avanzarClip();               // false cuando el clip ya mostró su último frame
+    void mostrarFrame();
+
     void actualizarSalto();
     void detectarPocion();
-    void actualizarSpriteCaminar(bool derecha);
+    void actualizarSpriteCaminar(bool derecha, int ms);   // ms: tiempo transcurrido desde el último paso
     void actualizarSpriteSalto();
     void caminarHaciaRobot(float xObjetivo, Robot* robotObjetivo);
     void atacarRobot(Robot* robotObjetivo);
     void caminarHaciaIzquierda(float xDestino);
 
-    QTimer* timerMovimiento;
-    QTimer* timerSalto;
-    QTimer* timerDanio;
-    QTimer* timerMuerte;
-    QTimer* animSalto;
-    QTimer* avance;
-    QTimer* animAtaque;
-    QTimer* regreso;
+    void avanzarMuerte();
+    void avanzarAnimSalto();
+    void avanzarHaciaRobot();
+    void avanzarAnimAtaque();
+    void avanzarRegreso();
+
+    static constexpr int msPaso = 60;   // Periodo de las tareas que hacen caminar a Goku2
+
+    TareaBucle* tareaMovimiento;
+    TareaBucle* tareaSalto;
+    TareaBucle* tareaDanio;
+    TareaBucle* tareaMuerte;
+    TareaBucle* tareaAnimSalto;
+    TareaBucle* tareaAvance;
+    TareaBucle* tareaAnimAtaque;
+    TareaBucle* tareaRegreso;
+
+    // Estado de las animaciones
+    ClipAnimacion clips[NumClips];
+    Clip clipActual = ClipCaminar;
+    int frameClip = 0;
+    int msEnFrame = 0;                // Tiempo que lleva mostrándose el frame actual
+
+    // Estado de las secuencias del Kamehameha
+    float xObjetivo = 0;
+    float xDestino = 0;
+    Robot* robotObjetivo = nullptr;
 
     bool mvtoIzquierda;
     bool mvtoDerecha;
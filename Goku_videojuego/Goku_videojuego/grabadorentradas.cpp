@@ -0,0 +1,128 @@
+#include "grabadorentradas.h"
+#include "buclejuego.h"
+#include <QKeyEvent>
+#include <QDebug>
+#include <stdexcept>  // Excepciones estándar
+
+/**
+@brief Constructor del grabador.
+
+@param ruta Archivo donde se guardará la grabación.
+@param parent Objeto padre en la jerarquía de Qt.
+
+@throw std::invalid_argument Si la ruta está vacía.
+*/
+GrabadorEntradas::GrabadorEntradas(const QString& ruta, QObject* parent)
+    : QObject(parent), ruta(ruta)
+{
+    if (ruta.isEmpty())
+        throw std::invalid_argument("GrabadorEntradas: la ruta de la grabación no puede estar vacía.");
+}
+
+/**
+@brief Destructor. Guarda lo que se haya grabado.
+*/
+GrabadorEntradas::~GrabadorEntradas()
+{
+    terminarNivel();
+}
+
+/**
+@brief Empieza a grabar un nivel recién construido.
+
+Debe llamarse entre dos pasos del bucle, después de sembrar `AzarJuego` y antes de que el
+nivel avance: los pasos del bloque se cuentan desde aquí.
+
+@param numero Número del nivel.
+@param semilla Semilla con la que se generó el nivel.
+*/
+void GrabadorEntradas::iniciarNivel(int numero, quint32 semilla)
+{
+    terminarNivel();
+
+    bloqueActual = registro.agregarBloque(numero, semilla, sostenidas);
+    pasoInicial = BucleJuego::instancia()->getPasosTotales();
+    qCDebug(registroEntradas) << "Grabando nivel" << numero << "en" << ruta;
+}
+
+/**
+@brief Cierra el bloque del nivel en curso y guarda la grabación.
+*/
+void GrabadorEntradas::terminarNivel()
+{
+    if (bloqueActual < 0) return;
+
+    bloqueActual = -1;
+    guardar();
+}
+
+/**
+@brief Escribe a disco todo lo grabado hasta ahora.
+
+Un error de escritura no detiene el juego: se informa y se sigue grabando en memoria.
+*/
+void GrabadorEntradas::guardar()
+{
+    try {
+        registro.guardar(ruta);
+    } catch (const std::exception& e) {
+        qWarning() << "No se pudo guardar la grabación:" << e.what();
+    }
+}
+
+/**
+@brief Observa las teclas que recibe la vista del juego.
+
+Las repeticiones automáticas de una pulsación se graban (Goku2 vuelve a saltar con ellas), pero
+las liberaciones automáticas que las acompañan se ignoran porque la tecla sigue apretada.
+
+@param objeto Objeto que recibe el evento (la vista).
+@param evento Evento recibido.
+@return Siempre `false`: el evento sigue su camino hasta Goku.
+*/
+bool GrabadorEntradas::eventFilter(QObject* objeto, QEvent* evento)
+{
+    if (evento->type() == QEvent::KeyPress || evento->type() == QEvent::KeyRelease) {
+        QKeyEvent* tecla = static_cast<QKeyEvent*>(evento);
+        const int bit = RegistroEntradas::bitTecla(tecla->key());
+        const bool presionada = evento->type() == QEvent::KeyPress;
+
+        if (bit >= 0 && (presionada || !tecla->isAutoRepeat()))
+            anotar(bit, presionada);
+    }
+
+    return QObject::eventFilter(objeto, evento);
+}
+
+/**
+@brief Registra una tecla en el paso que el bucle va a ejecutar a continuación.
+
+Si el paso ya tenía cambios se combinan en el mismo registro.
+
+@param bit Índice de la tecla en el estado.
+@param presionada `true` para una pulsación, `false` para una liberación.
+*/
+void GrabadorEntradas::anotar(int bit, bool presionada)
+{
+    const quint8 mascara = 1u << bit;
+    if (presionada)
+        sostenidas |= mascara;
+    else
+        sostenidas &= ~mascara;
+
+    if (bloqueActual < 0) return;
+
+    const quint32 paso = static_cast<quint32>(BucleJuego::instancia()->getPasosTotales() - pasoInicial);
+    QVector<CambioTeclas>& cambios = registro.getBloque(bloqueActual).cambios;
+
+    if (cambios.isEmpty() || cambios.last().paso != paso) {
+        CambioTeclas cambio;
+        cambio.paso = paso;
+        cambios.push_back(cambio);
+    }
+
+    CambioTeclas& cambio = cambios.last();
+    cambio.estado = (cambio.estado & 0xF0) | sostenidas;
+    if (presionada)
+        cambio.estado |= mascara << 4;
+}
@@ -0,0 +1,43 @@
+#ifndef GRABADORENTRADAS_H
+#define GRABADORENTRADAS_H
+
+#include <QObject>
+#include <QString>
+#include "registroentradas.h"
+
+/**
+ * Graba las teclas de la partida para poder repetirla.
+ * Se instala como filtro de eventos en la vista del juego: anota cada pulsación y liberación
+ * en el paso del BucleJuego en que Goku la va a procesar, sin interceptarla. Con la semilla
+ * de cada nivel, la grabación basta para reproducir la partida paso a paso.
+ */
+class GrabadorEntradas : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit GrabadorEntradas(const QString& ruta, QObject* parent = nullptr);
+    ~GrabadorEntradas();
+
+    void iniciarNivel(int numero, quint32 semilla);   // Abre un bloque nuevo
+    void terminarNivel();                              // Cierra el bloque y guarda a disco
+    void guardar();
+
+protected:
+    bool eventFilter(QObject* objeto, QEvent* evento) override;
+
+private:
+    void anotar(int bit, bool presionada);
+
+    QString ruta;
+    RegistroEntradas registro;
+    int bloqueActual = -1;        // -1: no hay nivel en curso
+    qint64 pasoInicial = 0;       // Paso del bucle en que empezó el nivel
+    quint8 sostenidas = 0;        // Teclas apretadas ahora mismo (bits 0-3)
+
+    // Bloqueamos copia y asignación
+    GrabadorEntradas(const GrabadorEntradas&) = delete;
+    GrabadorEntradas& operator=(const GrabadorEntradas&) = delete;
+};
+
+#endif // GRABADORENTRADAS_H
@@ -7,6 +7,16 @@
 #include <QPointer>
 #include <QMediaPlayer>
 #include <QAudioOutput>
+#include "buclejuego.h"
+#include "spritecache.h"
+#include "azarjuego.h"
+#include "grabadorentradas.h"
+#include "reproductorentradas.h"
+#include "vistajuego.h"
+#include "trazaeventos.h"
+#include "rastreomemoria.h"
+#include "arenanivel.h"
+#include "precarganivel.h"
 
 // Inicialización del contador
 int juego::contador = 0;
@@ -34,6 +44,7 @@ juego::juego(QWidget *parent)
     , nivelActual(nullptr)
     , exito(nullptr)
     , timerFoco(new QTimer(this))
+    , transicion(nullptr)
 {
     ui->setupUi(this);
 
@@ -96,13 +107,84 @@ juego::~juego()
     qDebug() << "Cerrando juego exitoso!!";
 }
 
+/**
+@brief Graba la partida en un archivo para poder repetirla después.
+
+Se llama antes de iniciar el juego. Cada nivel jugado agrega su semilla y sus teclas a la
+grabación, que se guarda al terminar cada nivel.
+
+@param ruta Archivo de salida.
+
+@throw std::invalid_argument Si la ruta está vacía.
+*/
+void juego::setGrabacion(const QString& ruta)
+{
+    delete grabador;
+    grabador = new GrabadorEntradas(ruta, this);
+}
+
+/**
+@brief Repite una partida grabada con `setGrabacion`.
+
+Los niveles se generan con las semillas grabadas y Goku recibe las mismas teclas en los mismos
+pasos del bucle, así que la partida se desarrolla igual paso a paso. Mientras dura la repetición
+el teclado no mueve a Goku.
+
+@param ruta Archivo de la grabación.
+
+@throw std::runtime_error Si la grabación no se puede leer.
+*/
+void juego::setRepeticion(const QString& ruta)
+{
+    delete reproductor;
+    reproductor = new ReproductorEntradas(ruta, this);
+}
+
+/**
+@brief Usa siempre la misma semilla para generar los niveles.
+
+@param semilla Semilla de `AzarJuego`; la de una grabación tiene prioridad sobre esta.
+*/
+void juego::setSemilla(quint32 semilla)
+{
+    haySemillaFija = true;
+    semillaFija = semilla;
+}
+
+/**
+@brief Elige cómo se repinta la vista del juego (se aplica al iniciar la partida).
+
+Por omisión se usa `VistaJuego::RenderParches`, que solo repinta lo que cambió y desplaza el
+resto. La línea "render" del panel de F3 muestra los píxeles repintados por frame de cada modo.
+
+@param modo Modo de repintado.
+*/
+void juego::setModoRender(VistaJuego::ModoRender modo)
+{
+    modoRender = modo;
+}
+
+/**
+@brief Activa el modo estrés: cada nivel agrega por etapas las entidades pedidas.
+
+Cada etapa se registra en la consola (tiempo de frame y memoria) y, si se indicó, en un CSV.
+
+@param config Cantidades finales, etapas y archivo; sin cantidades el modo queda apagado.
+
+@see EstresNivel
+*/
+void juego::setEstres(const ConfigEstres& config)
+{
+    estres = config;
+}
+
 /**
 @brief Inicia una nueva sesión de juego, configurando la vista, escena y cargando el primer nivel.
 
 Este método se activa al presionar el botón de inicio en la interfaz principal. Realiza los siguientes pasos:
 
 - Oculta y desactiva la pantalla de bienvenida.
-- Crea una nueva ventana `QGraphicsView` y una escena `QGraphicsScene` donde se desarrollará el juego.
+- Crea una nueva ventana `VistaJuego` (F3 muestra el perfilador) y una escena `QGraphicsScene` donde se desarrollará el juego.
 - Configura la vista con tamaño fijo, sin barras de desplazamiento y con suavizado de bordes.
 - Conecta la destrucción de la vista a la limpieza del nivel actual mediante `cerrarNivel(true)`.
 - Llama a `cambiarNivel(2)` para cargar el segundo nivel.
@@ -120,7 +202,8 @@ void juego::iniciarJuego()
     ui->botonIniciar->clearFocus();
 
     // Crear la vista del juego como ventana independiente
-    view = new QGraphicsView();
+    VistaJuego* vistaJuego = new VistaJuego();
+    view = vistaJuego;
     view->setWindowTitle("Goku Adventure");
     view->setWindowFlags(Qt::Window | Qt::WindowTitleHint | Qt::WindowCloseButtonHint);
 
@@ -129,10 +212,18 @@ void juego::iniciarJuego()
     view->setScene(scene);
 
     // Configurar vista
-    view->setFixedSize(1536, 784); // Tamaño fijo para el juego
+    // Tamaño fijo para el juego, sin borde: el viewport coincide con la zona lógica de la cámara
+    view->setFrameShape(QFrame::NoFrame);
+    view->setFixedSize(camaraLogica::anchoLogico, camaraLogica::altoLogico);
     view->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
     view->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-    view->setRenderHint(QPainter::Antialiasing);
+    // Modo de repintado (--render); el bucle central cierra cada frame con un único repintado
+    vistaJuego->setModoRender(modoRender);
+    BucleJuego::instancia()->setVista(view);
+
+    // La grabación y la repetición observan las teclas que llegan a la vista
+    if (grabador) view->installEventFilter(grabador);
+    if (reproductor) view->installEventFilter(reproductor);
 
     // Conectar señal de cierre de la vista
     connect(view, &QGraphicsView::destroyed, this, [this]() {
@@ -144,12 +235,21 @@ void juego::iniciarJuego()
     // Iniciar el primer nivel
     cambiarNivel(1);
 
+    // Arrancar el reloj central que mueve todas las entidades
+    BucleJuego::instancia()->iniciar();
+
     // Mostrar la ventana del juego
     view->show();
 
     // Forzar actualización de eventos para obtener geometría real
     QApplication::processEvents();
 
+    const QSize tamLogico(camaraLogica::anchoLogico, camaraLogica::altoLogico);
+    if (view->viewport()->size() != tamLogico) {
+        qWarning() << "juego: el viewport mide" << view->viewport()->size()
+                   << "y no" << tamLogico << "; la vista no coincidirá con la zona de la cámara";
+    }
+
     // Centrar la vista en pantalla
     QRect screenGeometry = QGuiApplication::primaryScreen()->geometry();
     QRect frame = view->frameGeometry(); // incluye bordes y barra de título
@@ -166,9 +266,13 @@ Este método permite alternar entre el Nivel 1 y el Nivel 2. Realiza las siguien
 
 - Llama a `cerrarNivel(false)` para liberar el nivel anterior.
 - Ajusta el tamaño de la escena según el nivel seleccionado.
+- Empieza un periodo nuevo en `RastreoMemoria` y carga las reservas del nivel a la etiqueta `MemoriaNivel`.
+- Abre la `ArenaNivel` de la que se reservan las entidades del nivel.
+- Siembra `AzarJuego` con la semilla del nivel (la grabada, la fija o una nueva).
 - Crea una nueva instancia de `Nivel1` o `Nivel2` y lo asigna como `nivelActual`.
 - Conecta señales del nivel para manejar eventos como la muerte de Goku o la finalización del nivel.
-- Inicia el nuevo nivel mediante `iniciarNivel()`.
+- Inicia el nuevo nivel mediante `iniciarNivel()` y empieza a grabarlo o a repetirlo.
+- Si el modo estrés está activo, le agrega un `EstresNivel` que muere con el nivel.
 - Activa el temporizador `timerFoco` para garantizar que Goku reciba el foco tras cargar el nivel.
 
 @param numero Número del nivel a cargar (1 o 2).
@@ -180,10 +284,18 @@ Este método permite alternar entre el Nivel 1 y el Nivel 2. Realiza las siguien
 void juego::cambiarNivel(int numero)
 {
     qDebug() << "Cambiando a nivel" << numero;
+    TRAZA_EVENTO("juego::cambiarNivel", "nivel");
 
     // antes de crear un nuevo nivel, cerramos correctamente el actual
     cerrarNivel(false);   // esto hara delete nivel1/nivel2 si estaban vivos
 
+    // Las reservas del nivel se cuentan desde aquí y se cargan a la etiqueta "nivel"
+    RastreoMemoria::iniciarPeriodo();
+    ETIQUETA_MEMORIA(MemoriaNivel);
+
+    // Las entidades del nivel se reservan en su arena, que se libera entera en cerrarNivel
+    ArenaNivel::abrir();
+
     // Configurar tamaño de escena según el nivel
     int sceneWidth = (numero == 1) ? 1536 * 4 : 1536; // Nivel 1 es más ancho
     int sceneHeight = 784;
@@ -191,6 +303,11 @@ void juego::cambiarNivel(int numero)
     scene->clear();
     scene->setSceneRect(0, 0, sceneWidth, sceneHeight);
 
+    // Todo lo aleatorio del nivel sale de esta semilla; al repetir se usa la grabada
+    quint32 semilla = haySemillaFija ? semillaFija : AzarJuego::semillaNueva();
+    if (reproductor) reproductor->prepararNivel(numero, semilla);
+    AzarJuego::sembrar(semilla);
+
     // Crear nivel específico
     try {
         if (numero == 1) {
@@ -206,6 +323,7 @@ void juego::cambiarNivel(int numero)
                 });
             });
 
+            connect(nivel1, &Nivel1::carroAterrizo, this, &juego::precargarNivel2);
             connect(nivel1, &Nivel1::nivelCompletado, this, &juego::mostrarTransicion);
 
         } else {
@@ -226,6 +344,17 @@ void juego::cambiarNivel(int numero)
 
         nivelActual->iniciarNivel();
 
+        // Los pasos de la grabación se cuentan desde aquí, antes del primer paso del nivel
+        if (grabador) grabador->iniciarNivel(numero, semilla);
+        if (reproductor) reproductor->iniciarNivel(nivelActual->getGoku());
+
+        if (estres.activo()) {
+            EstresNivel* modoEstres = new EstresNivel(nivelActual, estres);
+            connect(modoEstres, &EstresNivel::etapaMedida, this, [](const QString& linea) {
+                qInfo().noquote() << linea;
+            });
+        }
+
         timerFoco->start(100); //actualiza el foco cuando se cambia nivel, no crea uno nuevo
         /*
         // Asegurar foco en el personaje principal
@@ -247,7 +376,7 @@ void juego::cambiarNivel(int numero)
 @brief Cierra y limpia el nivel actual, liberando todos sus recursos.
 
 Este método se encarga de destruir correctamente el nivel en curso (`nivel1` o `nivel2`), desconectar sus señales
-y limpiar la escena asociada. Además, detiene el temporizador `timerFoco` y cualquier `QTimer` en modo `singleShot`
+y limpiar la escena asociada. Muestra el informe de memoria del nivel y cierra su `ArenaNivel`. Cierra el bloque del nivel en la grabación o repetición activa. Además, detiene el temporizador `timerFoco` y cualquier `QTimer` en modo `singleShot`
 que esté pendiente (como los usados tras `gokuMurio`).
 
 @param mostrarMenu Si es `true`, muestra nuevamente la pantalla de bienvenida al finalizar la limpieza.
@@ -262,6 +391,9 @@ void juego::cerrarNivel(bool mostrarMenu)
     // Desconectar señales primero
     if (nivelActual) {
         disconnect(nivelActual, nullptr, this, nullptr);
+
+        // Memoria reservada durante el nivel que termina
+        qDebug().noquote() << RastreoMemoria::informe(nivelActual == nivel1 ? "nivel 1" : "nivel 2");
     }
 
     //Eliminar niveles
@@ -275,10 +407,18 @@ void juego::cerrarNivel(bool mostrarMenu)
     }
 
     nivelActual = nullptr;
+
+    // El nivel ya no recibe teclas: se cierra su bloque de la grabación
+    if (grabador) grabador->terminarNivel();
+    if (reproductor) reproductor->detener();
+
     if (scene) {
         scene->clear();
     }
 
+    // Con todas las entidades destruidas, la memoria del nivel se recupera de una vez
+    ArenaNivel::cerrar();
+
     //detenemos el timer foco goku
     if (timerFoco && timerFoco->isActive())
         timerFoco->stop();
@@ -304,12 +444,24 @@ Este método se utiliza para regresar al menú inicial después de cerrar un niv
 - Muestra el `widget` de bienvenida y habilita la interacción del botón de inicio.
 - Establece el foco en el botón `ui->botonIniciar`.
 - Se asegura de que la ventana principal esté visible.
+- Detiene el bucle central del juego mientras se está en el menú.
+- Descarta la precarga del Nivel 2 si había una y libera de `SpriteCache` las imágenes que ya no usa ninguna entidad.
 
 @see juego::cerrarNivel
 @see juego::iniciarJuego
 */
 void juego::mostrarPantallaInicio()
 {
+    // En el menú no hay nada que simular
+    BucleJuego::instancia()->detener();
+
+    // Una precarga a medias (se perdió en el Nivel 1) ya no sirve
+    if (precarga) {
+        delete precarga;
+        precarga = nullptr;
+    }
+    SpriteCache::instancia()->purgar();
+
     // Mostrar elementos de bienvenida
     ui->widget->show();
     ui->widget->setEnabled(true);
@@ -320,22 +472,44 @@ void juego::mostrarPantallaInicio()
     this->show();
 }
 
+/**
+@brief Empieza a decodificar en segundo plano las hojas del Nivel 2.
+
+Se llama cuando el carro del Nivel 1 aterriza: quedan la llegada de los robots y la transición
+para decodificar las imágenes en otro hilo y pasarlas a `SpriteCache` de a poco. Si la
+precarga ya estaba en marcha no hace nada.
+
+@see PrecargaNivel
+@see Nivel2::recursos
+*/
+void juego::precargarNivel2()
+{
+    if (precarga) return;
+
+    precarga = new PrecargaNivel(Nivel2::recursos(), this);
+    precarga->iniciar();
+}
+
 /**
 @brief Muestra una animación de transición visual entre niveles y luego cambia al Nivel 2.
 
 Este método detiene temporalmente el nivel actual y presenta una imagen de transición centrada sobre la vista del juego.
-Después de 4 segundos, se cierra la transición y se invoca `cambiarNivel(2)` para continuar con el juego.
+La transición termina en cuanto la precarga del Nivel 2 está lista (y se mostró al menos 1 segundo, para que no
+parpadee); entonces se invoca `terminarTransicion()`.
 
 - La imagen utilizada es `:/images/transicion.png`.
 - La transición se escala al tamaño de la vista y se destruye automáticamente tras mostrarse.
+- Si la precarga no había empezado (por ejemplo, sin carro), empieza aquí.
 
-@see juego::cambiarNivel
+@see juego::precargarNivel2
+@see juego::terminarTransicion
 */
 void juego::mostrarTransicion()
 {
     if (!view || !nivelActual) return;
 
     nivelActual->setEnabled(false); // Pausar el nivel
+    TrazaEventos::instancia()->instante("juego::mostrarTransicion", "nivel");
 
     transicion = new QLabel(view);
     transicion->setPixmap(QPixmap(":/images/transicion.png")
@@ -344,14 +518,40 @@ void juego::mostrarTransicion()
     transicion->setAttribute(Qt::WA_DeleteOnClose);
     transicion->show();
   
-    QTimer::singleShot(4000, this, [this]() {
+    precargarNivel2();
+
+    QTimer::singleShot(1000, this, [this]() {
         //qDebug() << "timer transicion en juego  llamado  "<<contador++;
-        transicion->close();
-        delete transicion;
-        cambiarNivel(2);
+        if (!precarga || precarga->estaLista())
+            terminarTransicion();
+        else
+            connect(precarga, &PrecargaNivel::terminada, this, &juego::terminarTransicion,
+                    Qt::SingleShotConnection);
     });
 }
 
+/**
+@brief Cierra la imagen de transición y carga el Nivel 2 con las hojas ya precargadas.
+
+@see juego::mostrarTransicion
+*/
+void juego::terminarTransicion()
+{
+    if (!transicion) return;
+
+    transicion->close();
+    delete transicion;
+    transicion = nullptr;
+
+    // Las hojas ya están en SpriteCache; la precarga no se necesita más
+    if (precarga) {
+        precarga->deleteLater();
+        precarga = nullptr;
+    }
+
+    cambiarNivel(2);
+}
+
 /**
 @brief Muestra una pantalla de éxito al completar un nivel y luego retorna al menú principal.
 
@@ -368,6 +568,7 @@ void juego::mostrarExito()
     if (!view) return;
 
     nivelActual->setEnabled(false); // Pausar el nivel
+    TrazaEventos::instancia()->instante("juego::mostrarExito", "nivel");
 
     exito = new QLabel(view);
     exito->setPixmap(QPixmap(":/images/exito.png")
@@ -7,8 +7,14 @@
 #include <QTimer>
 #include "nivel1.h"
 #include "nivel2.h"
+#include "vistajuego.h"
+#include "estresnivel.h"
 #include "ui_juego.h"
 
+class GrabadorEntradas;
+class PrecargaNivel;
+class ReproductorEntradas;
+
 class juego : public QMainWindow
 {
     Q_OBJECT
@@ -17,6 +23,12 @@ public:
     explicit juego(QWidget *parent = nullptr);
     ~juego();
 
+    void setGrabacion(const QString& ruta);     // Graba las teclas y semillas de la partida
+    void setRepeticion(const QString& ruta);    // Repite una partida grabada
+    void setSemilla(quint32 semilla);           // Misma semilla en todos los niveles
+    void setModoRender(VistaJuego::ModoRender modo);
+    void setEstres(const ConfigEstres& config);   // Modo estrés en cada nivel
+
 protected:
     void closeEvent(QCloseEvent *event) override;
 
@@ -24,6 +36,8 @@ private slots:
     void iniciarJuego();
     void regresarAlMenuTrasDerrota();
     void mostrarTransicion();
+    void terminarTransicion();
+    void precargarNivel2();
     void mostrarExito();
 
 
@@ -37,6 +51,14 @@ private:
     QLabel *exito;
     QTimer *timerFoco = nullptr;//foco en goku
     QLabel *transicion;
+    PrecargaNivel *precarga = nullptr;      // Hojas del Nivel 2, decodificadas en segundo plano
+
+    GrabadorEntradas *grabador = nullptr;
+    ReproductorEntradas *reproductor = nullptr;
+    VistaJuego::ModoRender modoRender = VistaJuego::RenderParches;   // El que menos píxeles repinta
+    ConfigEstres estres;                    // Sin cantidades: modo estrés apagado
+    bool haySemillaFija = false;
+    quint32 semillaFija = 0;
 
     static int contador;
 
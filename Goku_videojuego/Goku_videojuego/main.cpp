@@ -1,34 +1,63 @@
 #include "juego.h"
+#include "trazaeventos.h"
 
 #include <QApplication>
+#include <QCommandLineParser>
 #include <QDebug>
-
-using namespace std;
-int liberar = 0;
-
-void* operator new(size_t size){
-    void * p = malloc(size);
-    liberar +=1;
-
-    //qDebug() << "a liberar "<<liberar;
-    return p;
-}
-
-void operator delete(void* p, std::size_t){
-    liberar-=1;
-
-    //qDebug() << "memoria restante "<<liberar;
-    free(p);
-}
-
-void operator delete(void* p) noexcept {
-    free(p);
-}
+#include <stdexcept>
 
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Goku Adventure");
+    parser.addHelpOption();
+    parser.addOption({"grabar", "Graba la partida (semillas y teclas) en un archivo.", "ruta"});
+    parser.addOption({"repetir", "Repite una partida grabada con --grabar.", "ruta"});
+    parser.addOption({"semilla", "Semilla fija para generar los niveles.", "n"});
+    parser.addOption({"traza", "Guarda al salir una traza para chrome://tracing o Perfetto.", "ruta"});
+    parser.addOption({"render", "Modo de repintado: completo, parches (por omisión) o rectangulo.", "modo"});
+    parser.addOption({"estres", "Modo estrés: 'aves=N,explosiones=N,pociones=N,robots=N[,etapas=N][,ms=N]'.", "cantidades"});
+    parser.addOption({"estres-csv", "Guarda las mediciones del modo estrés en un CSV.", "ruta"});
+    parser.process(a);
+
     juego w;
+
+    try {
+        if (parser.isSet("grabar") && parser.isSet("repetir"))
+            throw std::invalid_argument("--grabar y --repetir no se pueden usar juntos.");
+
+        if (parser.isSet("grabar"))
+            w.setGrabacion(parser.value("grabar"));
+        if (parser.isSet("repetir"))
+            w.setRepeticion(parser.value("repetir"));
+        if (parser.isSet("semilla"))
+            w.setSemilla(parser.value("semilla").toUInt());
+        if (parser.isSet("traza"))
+            TrazaEventos::instancia()->iniciar(parser.value("traza"));
+        if (parser.isSet("render"))
+            w.setModoRender(VistaJuego::modoRender(parser.value("render")));
+        if (parser.isSet("estres")) {
+            ConfigEstres estres = EstresNivel::leerConfig(parser.value("estres"));
+            estres.archivo = parser.value("estres-csv");
+            w.setEstres(estres);
+        }
+
+    } catch (const std::exception& e) {
+        qCritical() << "Error en los argumentos:" << e.what();
+        return 1;
+    }
+
+    // La traza se vuelca una sola vez, al cerrar la aplicación
+    QObject::connect(&a, &QApplication::aboutToQuit, []() {
+        try {
+            TrazaEventos::instancia()->guardar();
+        } catch (const std::exception& e) {
+            qWarning() << "No se pudo guardar la traza:" << e.what();
+        }
+    });
+
     w.show();
     return a.exec();
 }
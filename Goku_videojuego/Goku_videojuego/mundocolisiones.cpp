@@ -0,0 +1,216 @@
+#include "mundocolisiones.h"
+#include <algorithm>
+#include <stdexcept>  // Para lanzar excepciones estándar
+
+/**
+@brief Constructor privado del mundo de colisiones.
+
+Reserva de antemano espacio para los cuerpos y para cada cubeta, de modo que durante el juego
+las altas y los movimientos normalmente no necesiten pedir memoria.
+*/
+MundoColisiones::MundoColisiones()
+{
+    cuerpos.reserve(256);
+    libres.reserve(256);
+    for (auto& lista : cubetas)
+        lista.reserve(8);
+}
+
+/**
+@brief Devuelve la instancia única del mundo de colisiones.
+
+@return Puntero al mundo de colisiones del juego.
+*/
+MundoColisiones* MundoColisiones::instancia()
+{
+    static MundoColisiones unico;
+    return &unico;
+}
+
+/**
+@brief Registra un item gráfico como cuerpo de colisión.
+
+La caja del cuerpo se toma de `sceneBoundingRect()` del item en este momento; cada vez que el
+item se mueva o cambie de imagen hay que llamar a `actualizar()`.
+
+@param item Item gráfico cuya caja se usará en las consultas. No puede ser nulo.
+@param categoria Tipo de la entidad, un bit de `TipoEntidad`.
+@param mascara Tipos con los que choca la entidad; los cuerpos pasivos usan `EntidadNinguna`.
+@param dueno Objeto lógico asociado (por ejemplo, el personaje o el obstáculo), opcional.
+@return Identificador del cuerpo, a usar en `actualizar()` y `quitar()`.
+
+@throw std::invalid_argument Si el item es nulo.
+*/
+int MundoColisiones::agregar(QGraphicsItem* item, quint32 categoria, quint32 mascara, QObject* dueno)
+{
+    if (!item)
+        throw std::invalid_argument("MundoColisiones::agregar - el item no puede ser nulo.");
+
+    int id;
+    if (!libres.empty()) {
+        id = libres.back();
+        libres.pop_back();
+    } else {
+        id = static_cast<int>(cuerpos.size());
+        cuerpos.emplace_back();
+    }
+
+    Cuerpo& c = cuerpos[id];
+    c.item = item;
+    c.dueno = dueno;
+    c.categoria = categoria;
+    c.mascara = mascara;
+    c.caja = item->sceneBoundingRect();
+    c.sello = 0;
+    c.enUso = true;
+
+    insertarEnCeldas(id);
+    ++activos;
+    return id;
+}
+
+/**
+@brief Recalcula la caja de un cuerpo a partir de la posición actual de su item.
+
+Si la caja sigue ocupando las mismas celdas (el caso normal en movimientos de pocos píxeles)
+solo se actualiza la caja; en otro caso el cuerpo se cambia de cubetas.
+
+@param cuerpo Identificador devuelto por `agregar()`. Los valores negativos se ignoran.
+*/
+void MundoColisiones::actualizar(int cuerpo)
+{
+    if (cuerpo < 0 || cuerpo >= static_cast<int>(cuerpos.size())) return;
+
+    Cuerpo& c = cuerpos[cuerpo];
+    if (!c.enUso) return;
+
+    c.caja = c.item->sceneBoundingRect();
+
+    if (celda(c.caja.left()) == c.celdaX0 && celda(c.caja.right()) == c.celdaX1 &&
+        celda(c.caja.top()) == c.celdaY0 && celda(c.caja.bottom()) == c.celdaY1)
+        return;
+
+    quitarDeCeldas(cuerpo);
+    insertarEnCeldas(cuerpo);
+}
+
+/**
+@brief Quita un cuerpo del mundo. Su identificador queda libre para reutilizarse.
+
+@param cuerpo Identificador devuelto por `agregar()`. Los valores negativos se ignoran.
+*/
+void MundoColisiones::quitar(int cuerpo)
+{
+    if (cuerpo < 0 || cuerpo >= static_cast<int>(cuerpos.size())) return;
+
+    Cuerpo& c = cuerpos[cuerpo];
+    if (!c.enUso) return;
+
+    quitarDeCeldas(cuerpo);
+    c.item = nullptr;
+    c.dueno = nullptr;
+    c.enUso = false;
+    libres.push_back(cuerpo);
+    --activos;
+}
+
+/**
+@brief Cambia la categoría de un cuerpo ya registrado.
+
+Lo usan las subclases cuyo cuerpo lo registró la clase base con un tipo genérico (por ejemplo,
+el carro es un obstáculo cuyo tipo es `EntidadCarro`).
+
+@param cuerpo Identificador devuelto por `agregar()`.
+@param categoria Nuevo tipo del cuerpo, un bit de `TipoEntidad`.
+*/
+void MundoColisiones::setCategoria(int cuerpo, quint32 categoria)
+{
+    if (cuerpo < 0 || cuerpo >= static_cast<int>(cuerpos.size())) return;
+    cuerpos[cuerpo].categoria = categoria;
+}
+
+/**
+@brief Cambia los tipos con los que choca un cuerpo ya registrado.
+
+@param cuerpo Identificador devuelto por `agregar()`.
+@param mascara Combinación de bits de `TipoEntidad`.
+*/
+void MundoColisiones::setMascara(int cuerpo, quint32 mascara)
+{
+    if (cuerpo < 0 || cuerpo >= static_cast<int>(cuerpos.size())) return;
+    cuerpos[cuerpo].mascara = mascara;
+}
+
+/**
+@brief Busca los cuerpos que se superponen con una zona y los copia en un buffer fijo.
+
+Aplica los mismos filtros que la versión con callback. Si hay más coincidencias que espacio en
+el buffer, las restantes se descartan.
+
+@param zona Caja a consultar, en coordenadas de escena.
+@param mascaraTipos Tipos aceptados, combinando bits de `TipoEntidad` con `|`.
+@param salida Buffer donde se escriben los identificadores encontrados.
+@param maximo Capacidad del buffer.
+@param ignorar Cuerpo a excluir (normalmente el del que consulta).
+@return Cantidad de identificadores escritos en `salida`.
+*/
+int MundoColisiones::recolectar(const QRectF& zona, quint32 mascaraTipos, int* salida, int maximo, int ignorar)
+{
+    int encontrados = 0;
+    if (maximo <= 0) return 0;
+
+    consultar(zona, mascaraTipos, [&](int id) {
+        salida[encontrados++] = id;
+        return encontrados < maximo;
+    }, ignorar);
+
+    return encontrados;
+}
+
+/**
+@brief Agrega el cuerpo a las cubetas de todas las celdas que cubre su caja.
+*/
+void MundoColisiones::insertarEnCeldas(int cuerpo)
+{
+    Cuerpo& c = cuerpos[cuerpo];
+    c.celdaX0 = celda(c.caja.left());
+    c.celdaX1 = celda(c.caja.right());
+    c.celdaY0 = celda(c.caja.top());
+    c.celdaY1 = celda(c.caja.bottom());
+
+    for (int cy = c.celdaY0; cy <= c.celdaY1; ++cy)
+        for (int cx = c.celdaX0; cx <= c.celdaX1; ++cx)
+            cubetas[cubeta(cx, cy)].push_back(cuerpo);
+}
+
+/**
+@brief Quita el cuerpo de las cubetas de las celdas que ocupaba.
+
+Se quita una aparición por celda, así un cuerpo cuyas celdas caen en la misma cubeta queda
+consistente. El orden dentro de la cubeta no importa, por lo que se usa intercambio con el último.
+*/
+void MundoColisiones::quitarDeCeldas(int cuerpo)
+{
+    const Cuerpo& c = cuerpos[cuerpo];
+
+    for (int cy = c.celdaY0; cy <= c.celdaY1; ++cy) {
+        for (int cx = c.celdaX0; cx <= c.celdaX1; ++cx) {
+            std::vector<int>& lista = cubetas[cubeta(cx, cy)];
+            auto it = std::find(lista.begin(), lista.end(), cuerpo);
+            if (it != lista.end()) {
+                *it = lista.back();
+                lista.pop_back();
+            }
+        }
+    }
+}
+
+/**
+@brief Pone en cero los sellos de todos los cuerpos cuando el contador de consultas da la vuelta.
+*/
+void MundoColisiones::reiniciarSellos()
+{
+    for (Cuerpo& c : cuerpos)
+        c.sello = 0;
+    selloConsulta = 1;
+}
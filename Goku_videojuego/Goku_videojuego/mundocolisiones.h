@@ -0,0 +1,116 @@
+#ifndef MUNDOCOLISIONES_H
+#define MUNDOCOLISIONES_H
+
+#include <QGraphicsItem>
+#include <QObject>
+#include <QRectF>
+#include <QtGlobal>
+#include <cmath>
+#include <vector>
+#include "tipoentidad.h"
+#include "perfilador.h"
+
+/**
+ * Mundo de colisiones del juego (fase amplia).
+ * Cada entidad registra su caja (AABB) con su categoría (`TipoEntidad`) y la máscara de
+ * categorías con las que choca; las cajas se reparten en una grilla
+ * uniforme de celdas de `tamCelda` píxeles indexada por una tabla hash de tamaño fijo.
+ * Una consulta solo recorre las celdas que toca la caja pedida, así que su costo no depende
+ * de cuántas entidades hay en el resto del nivel, y no reserva memoria.
+ */
+class MundoColisiones
+{
+public:
+    static const int tamCelda = 128;      // ~12x6 celdas cubren la vista de 1536x784
+    static const int numCubetas = 1024;   // Potencia de 2 para indexar con una máscara
+
+    static MundoColisiones* instancia();
+
+    int agregar(QGraphicsItem* item, quint32 categoria, quint32 mascara, QObject* dueno = nullptr);
+    void actualizar(int cuerpo);           // Recalcula la caja después de mover el item
+    void quitar(int cuerpo);
+    void setCategoria(int cuerpo, quint32 categoria);
+    void setMascara(int cuerpo, quint32 mascara);
+
+    QGraphicsItem* item(int cuerpo) const { return cuerpos[cuerpo].item; }
+    QObject* dueno(int cuerpo) const { return cuerpos[cuerpo].dueno; }
+    quint32 categoria(int cuerpo) const { return cuerpos[cuerpo].categoria; }   // Bit de TipoEntidad
+    quint32 mascara(int cuerpo) const { return cuerpos[cuerpo].mascara; }       // Tipos con los que choca
+    QRectF caja(int cuerpo) const { return cuerpos[cuerpo].caja; }
+    int cantidad() const { return activos; }
+
+    /*
+     * Llama a visitar(cuerpo) por cada cuerpo visible cuya caja se superpone con `zona` y cuya
+     * categoría está en `mascaraTipos`. Cada cuerpo se visita una sola vez. Si visitar devuelve
+     * false la consulta termina. El callback no debe agregar, quitar ni mover cuerpos.
+     */
+    template <typename Visitante>
+    void consultar(const QRectF& zona, quint32 mascaraTipos, Visitante&& visitar, int ignorar = -1);
+
+    // Igual que consultar() pero copia los cuerpos a un buffer fijo; devuelve cuántos escribió
+    int recolectar(const QRectF& zona, quint32 mascaraTipos, int* salida, int maximo, int ignorar = -1);
+
+private:
+    MundoColisiones();
+
+    struct Cuerpo {
+        QGraphicsItem* item = nullptr;
+        QObject* dueno = nullptr;
+        quint32 categoria = EntidadNinguna;   // Tipo del cuerpo (un bit)
+        quint32 mascara = EntidadNinguna;     // Tipos que busca al consultar
+        QRectF caja;
+        int celdaX0 = 0, celdaY0 = 0, celdaX1 = -1, celdaY1 = -1;   // Celdas ocupadas
+        quint32 sello = 0;                                          // Última consulta que lo visitó
+        bool enUso = false;
+    };
+
+    static int celda(qreal coordenada) { return static_cast<int>(std::floor(coordenada / tamCelda)); }
+    static int cubeta(int cx, int cy)
+    {
+        const quint32 h = (static_cast<quint32>(cx) * 73856093u) ^ (static_cast<quint32>(cy) * 19349663u);
+        return static_cast<int>(h & (numCubetas - 1));
+    }
+
+    void insertarEnCeldas(int cuerpo);
+    void quitarDeCeldas(int cuerpo);
+    void reiniciarSellos();
+
+    std::vector<Cuerpo> cuerpos;
+    std::vector<int> libres;                 // Índices de cuerpos reutilizables
+    std::vector<int> cubetas[numCubetas];
+    quint32 selloConsulta = 0;
+    int activos = 0;
+
+    // Bloqueamos copia y asignación
+    MundoColisiones(const MundoColisiones&) = delete;
+    MundoColisiones& operator=(const MundoColisiones&) = delete;
+};
+
+template <typename Visitante>
+void MundoColisiones::consultar(const QRectF& zona, quint32 mascaraTipos, Visitante&& visitar, int ignorar)
+{
+    ZONA_PERFIL("colisiones");
+    if (++selloConsulta == 0)
+        reiniciarSellos();
+    const quint32 sello = selloConsulta;
+    const int x0 = celda(zona.left()), x1 = celda(zona.right());
+    const int y0 = celda(zona.top()),  y1 = celda(zona.bottom());
+
+    for (int cy = y0; cy <= y1; ++cy) {
+        for (int cx = x0; cx <= x1; ++cx) {
+            const std::vector<int>& lista = cubetas[cubeta(cx, cy)];
+            for (int id : lista) {
+                Cuerpo& c = cuerpos[id];
+                if (c.sello == sello || id == ignorar) continue;
+                c.sello = sello;
+
+                if (!(c.categoria & mascaraTipos)) continue;
+                if (!c.item->isVisible() || !c.caja.intersects(zona)) continue;
+
+                if (!visitar(id)) return;
+            }
+        }
+    }
+}
+
+#endif // MUNDOCOLISIONES_H
@@ -1,5 +1,8 @@
 #include "nivel.h"
-#include <QRandomGenerator>
+#include "spritecache.h"
+#include "azarjuego.h"
+#include "perfilador.h"
+#include "rastreomemoria.h"
 #include <QGraphicsPixmapItem>
 #include <stdexcept>  // Para lanzar excepciones estándar
 #include <QDebug>
@@ -14,35 +17,40 @@ int Nivel::contador = 0;
 
 Inicializa los recursos comunes a todos los niveles, como la escena, vista y temporizador principal del juego.
 
-- Valida que `escena` y `view` no sean nulos.
-- Inicializa un temporizador (`timerNivel`) que llama al método virtual `actualizarNivel()` cada 20 ms, permitiendo la ejecución periódica de lógica personalizada en subclases (`Nivel1`, `Nivel2`).
+- Valida que `escena` no sea nula. La vista puede ser nula para ejecutar el nivel sin ventana (simulador).
+- Registra en el bucle central una tarea (`tareaNivel`) que llama al método virtual `actualizarNivel()` cada 20 ms, permitiendo la ejecución periódica de lógica personalizada en subclases (`Nivel1`, `Nivel2`).
 - Almacena el número del nivel (`numeroNivel`) para identificar el nivel cargado.
+- Crea la capa del HUD (`hud`) donde las subclases agregan la vida y el progreso.
 
 @param escena Puntero a la escena gráfica donde se dibujan los objetos del juego.
-@param view Puntero a la vista (`QGraphicsView`) que muestra la escena.
+@param view Puntero a la vista (`QGraphicsView`) que muestra la escena, o `nullptr` para simular sin vista.
 @param parent Widget padre opcional.
 @param numero Número que identifica el nivel (1, 2, etc.).
 
-@throw std::invalid_argument Si `escena` o `view` son nulos.
+@throw std::invalid_argument Si `escena` es nula.
 */
 Nivel::Nivel(QGraphicsScene *escena, QGraphicsView *view, QWidget *parent, int numero)
     : QWidget(parent), vista(view), escena(escena), numeroNivel(numero)
 {
-    // Validación de parámetros críticos (¡Ahora más robusta!)
-    if (!escena || !view) {
-        qCritical() << "Nivel: La escena o la vista son nulas. Nivel:" << numero;
-        throw std::invalid_argument("Nivel: La escena o la vista no pueden ser nulas.");
+    // Validación de parámetros críticos; la vista es opcional (modo sin vista)
+    if (!escena) {
+        qCritical() << "Nivel: La escena es nula. Nivel:" << numero;
+        throw std::invalid_argument("Nivel: La escena no puede ser nula.");
     }
 
-    // Inicializa el temporizador principal del nivel (actualiza la lógica cada 20 ms)
-    // Timer ahora se desconecta explícitamente en destructor
-    timerNivel = new QTimer(this);
-    connect(timerNivel, &QTimer::timeout, this, [=]() {
+    // Tarea principal del nivel en el bucle central (actualiza la lógica cada 20 ms)
+    // La tarea se quita del bucle explícitamente en el destructor
+    tareaNivel = new TareaBucle(BucleJuego::FaseNivel, [this]() {
 
         //qDebug() << "timer nivel en nivel  llamado  "<<contador++;
+        ZONA_PERFIL("actualizarNivel");
+        ETIQUETA_MEMORIA(MemoriaNivel);
         this->actualizarNivel();  // Llama al método virtual (definido por subclases)
-    });
-    timerNivel->start(20);
+    }, this, "actualizarNivel");
+    tareaNivel->iniciar(20);
+
+    // Capa del HUD: la vista la encuentra en la escena y la dibuja sobre todo lo demás
+    hud = new CapaHud(escena, this);
 
     qDebug() << "Nivel" << numero << "creado correctamente en nivel Padre";
 }
@@ -52,10 +60,10 @@ Nivel::Nivel(QGraphicsScene *escena, QGraphicsView *view, QWidget *parent, int n
 
 Este método garantiza una limpieza segura y ordenada al destruir un nivel, ejecutando las siguientes acciones:
 
-1. Detiene y desconecta todos los temporizadores (`timerNivel`, `timerNubes`).
-2. Elimina objetos gráficos directamente relacionados, como `goku`, `nubes`, y fondos (`listaNubes`, `listaFondos`).
-3. Libera la barra de vida y la barra de progreso si existen, y las desvincula de sus vistas correspondientes.
-4. Libera la memoria de los temporizadores y de la superposición de “Game Over” si está activa.
+1. Detiene y quita del bucle central todas las tareas del nivel (`tareaNivel`, `tareaNubes`).
+2. Elimina objetos gráficos directamente relacionados, como `goku`, la capa de nubes (`capaNubes`) y los fondos (`listaFondos`).
+3. Libera la barra de vida, la barra de progreso y la capa del HUD que las dibuja.
+4. Libera la memoria de las tareas y de la superposición de “Game Over” si está activa.
 
 Este destructor debe ser invocado automáticamente al eliminar un objeto `Nivel`, o de forma indirecta al eliminar `Nivel1` o `Nivel2`.
 
@@ -65,16 +73,9 @@ Nivel::~Nivel()
 {
     qDebug() << "Destructor de Nivel padre llamado para destruir el nivel" << numeroNivel;
 
-    // 1. Detener todos los timers primero (¡CRÍTICO!)
-    if (timerNivel) {
-        timerNivel->stop();
-        disconnect(timerNivel, nullptr, this, nullptr);
-    }
-
-    if (timerNubes) {
-        timerNubes->stop();
-        disconnect(timerNubes, nullptr, this, nullptr);
-    }
+    // 1. Detener todas las tareas primero (¡CRÍTICO!)
+    if (tareaNivel) tareaNivel->detener();
+    if (tareaNubes) tareaNubes->detener();
 
     // 2. Limpieza directa de items gráficos (sin llamada virtual)
     if (goku && escena) {
@@ -83,11 +84,11 @@ Nivel::~Nivel()
         goku = nullptr;
     }
 
-    for (auto* nube : listaNubes) {
-        if (nube && escena) escena->removeItem(nube);
-        delete nube;
+    if (capaNubes) {
+        if (escena) escena->removeItem(capaNubes);
+        delete capaNubes;
+        capaNubes = nullptr;
     }
-    listaNubes.clear();
 
     for (auto* fondo : listaFondos) {
         if (fondo && escena) escena->removeItem(fondo);
@@ -97,23 +98,20 @@ Nivel::~Nivel()
 
     // 3. Eliminar otros objetos (orden inverso al de creación)
 
-    if (barraVida && barraVida->parent() == this) {
-        delete barraVida;
-        barraVida = nullptr;
-    }
+    delete barraVida;
+    barraVida = nullptr;
 
-    if (barraProgreso) {
-        barraProgreso->setParent(nullptr);  // Desvincula de la vista
-        barraProgreso->hide();              // Evita que quede visible si tarda en destruirse
-        delete barraProgreso;
-        barraProgreso = nullptr;
-    }
+    delete barraProgreso;
+    barraProgreso = nullptr;
+
+    delete hud;
+    hud = nullptr;
 
-    delete timerNivel;
-    timerNivel = nullptr;
+    delete tareaNivel;
+    tareaNivel = nullptr;
 
-    delete timerNubes;
-    timerNubes = nullptr;
+    delete tareaNubes;
+    tareaNubes = nullptr;
 
     if (overlayGameOver) {
         overlayGameOver->deleteLater();
@@ -129,7 +127,7 @@ Nivel::~Nivel()
 Este método borra todos los elementos gráficos agregados por el nivel a la escena, sin destruir el objeto `Nivel` en sí.
 Está diseñado para usarse durante el transcurso del juego cuando se requiere un reinicio visual sin invocar el destructor.
 
-- Elimina a `goku`, las nubes (`listaNubes`), y los fondos (`listaFondos`) de la escena.
+- Elimina a `goku`, la capa de nubes (`capaNubes`) y los fondos (`listaFondos`) de la escena.
 - Oculta y programa la eliminación de la superposición de "Game Over" si está activa.
 
 @note Este método es útil para reiniciar o recargar un nivel mientras el objeto `Nivel` sigue existiendo.
@@ -145,11 +143,11 @@ void Nivel::limpiarEscena()
         goku = nullptr;
     }
 
-    for (auto* nube : listaNubes) {
-        if (nube && escena) escena->removeItem(nube);
-        delete nube;
+    if (capaNubes) {
+        if (escena) escena->removeItem(capaNubes);
+        delete capaNubes;
+        capaNubes = nullptr;
     }
-    listaNubes.clear();
 
     for (auto* fondo : listaFondos) {
         if (fondo && escena) escena->removeItem(fondo);
@@ -175,6 +173,37 @@ int Nivel::getMargenHUD() const {
     return margenHUD;
 }
 
+/**
+@brief Devuelve el número que identifica al nivel.
+
+@return 1, 2, etc.
+*/
+int Nivel::getNumero() const
+{
+    return numeroNivel;
+}
+
+/**
+@brief Devuelve la escena donde se dibuja el nivel.
+
+@return Puntero a la escena (nunca nulo: el constructor lo valida).
+*/
+QGraphicsScene* Nivel::getEscena() const
+{
+    return escena;
+}
+
+/**
+@brief Devuelve el alto del área visible del nivel.
+
+@return Alto de la vista, o alto de la escena si el nivel se ejecuta sin vista.
+*/
+int Nivel::altoVisible() const
+{
+    if (vista) return vista->height();
+    return static_cast<int>(escena->height());
+}
+
 /**
 @brief Genera y anima múltiples nubes en la escena del nivel como fondo dinámico.
 
@@ -182,8 +211,8 @@ Este método carga una imagen de nube desde los recursos y genera instancias esc
 a lo largo de la escena. Las nubes se colocan en distintas posiciones y tamaños para crear un efecto visual de profundidad.
 
 - Se generan 35 columnas de nubes, cada una con 3 nubes de distinta escala.
-- Las nubes se agregan a la escena y se almacenan en `listaNubes`.
-- Se inicia un temporizador (`timerNubes`) que las moverá lateralmente mediante `moverNubes()`.
+- Todas las nubes van a una sola `CapaNubes` (`capaNubes`), que comparte las tres imágenes escaladas.
+- Se registra una tarea en el bucle central (`tareaNubes`) que las moverá lateralmente mediante `moverNubes()`.
 
 @throw std::runtime_error Si no se puede cargar la imagen de la nube.
 
@@ -191,8 +220,9 @@ a lo largo de la escena. Las nubes se colocan en distintas posiciones y tamaños
 */
 void Nivel::generarNubes()
 {
-    // Carga la imagen de la nube desde recursos
-    nube = QPixmap(":/images/nube.png");
+    // Carga la imagen de la nube desde la caché compartida
+    SpriteCache* cache = SpriteCache::instancia();
+    nube = cache->hoja(":/images/nube.png");
 
     // Validación más explícita
     if (nube.isNull()) {
@@ -200,40 +230,45 @@ void Nivel::generarNubes()
         throw std::runtime_error("Nivel: No se pudo cargar la imagen de la nube.");
     }
 
+    // Solo hay tres escalas: cada una se calcula una vez y la comparten todas las nubes
+    // (índice 0 = la más chica, 2 = la más grande)
+    QVector<QPixmap> escalas;
+    for (int j = 1; j <= 3; ++j) {
+        float escala = j * 0.05f;
+        escalas.append(cache->escalado(nube, nube.width() * escala, nube.height() * escala));
+    }
+
+    capaNubes = new CapaNubes(escalas, escena->width());
+    capaNubes->setZValue(-5);   // Delante del fondo, detrás de todo lo demás
+    escena->addItem(capaNubes);
+
     // Genera múltiples nubes distribuidas horizontalmente
     for (int i = 0; i < 35; i++) {
         for (int j = 3; j > 0; --j) {
-            float escala = j * 0.05f;
-            int ancho = nube.width() * escala;
-            int alto  = nube.height() * escala;
-
-            QPixmap nubeEscalada = nube.scaled(ancho, alto, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-            int x = i * 250 + QRandomGenerator::global()->bounded(-60, 100);
-            int y = QRandomGenerator::global()->bounded(0, 80);
+            const QPixmap& nubeEscalada = escalas[j - 1];
+            int x = i * 250 + AzarJuego::generador()->bounded(-60, 100);
+            int y = AzarJuego::generador()->bounded(0, 80);
 
             if (x + nubeEscalada.width() <= escena->width()) {
                 contNubes += 1;
-                QGraphicsPixmapItem *_nube = new QGraphicsPixmapItem(nubeEscalada);
-                _nube->setPos(x, y);
-                escena->addItem(_nube);
-                listaNubes.push_back(_nube);
+                capaNubes->agregar(x, y, j - 1);
             }
         }
     }
 
-    // Timer ahora se desconecta en destructor
-    timerNubes = new QTimer(this);
-    connect(timerNubes, &QTimer::timeout, this, &Nivel::moverNubes);
-    timerNubes->start(45);
+    // La tarea se quita del bucle en el destructor
+    tareaNubes = new TareaBucle(BucleJuego::FaseEscenario, [this]() { moverNubes(); }, this, "moverNubes");
+    tareaNubes->iniciar(45);
 }
 
 /**
 @brief Mueve todas las nubes del fondo hacia la izquierda y las reposiciona cuando salen de la escena.
 
-Este método es llamado periódicamente por el temporizador `timerNubes` y da la ilusión de movimiento continuo en el cielo del nivel.
+Este método es llamado periódicamente por la tarea `tareaNubes` del bucle central y da la ilusión de movimiento continuo en el cielo del nivel.
 
-- Desplaza cada nube `velocidadNube` píxeles hacia la izquierda.
+- Desplaza cada nube `velocidadNube` píxeles hacia la izquierda, todas en un solo recorrido de `CapaNubes::avanzar`.
 - Si una nube sale completamente del borde izquierdo, se reposiciona al borde derecho con una nueva altura aleatoria.
+- La escena recibe una sola actualización por tick, la del item de la capa.
 
 @note Este efecto mejora la ambientación visual del juego sin afectar la jugabilidad.
 
@@ -243,19 +278,11 @@ void Nivel::moverNubes()
 {
 
     //qDebug() << "timermover nubes en nivel llamado  "<<contador++;
+    ZONA_PERFIL("moverNubes");
     const int velocidadNube = 2;
 
-    for (auto *nubeItem : listaNubes) {
-        if (!nubeItem || !escena) continue;  // Validación defensiva
-
-        nubeItem->setPos(nubeItem->x() - velocidadNube, nubeItem->y());
-
-        if (nubeItem->x() + nubeItem->pixmap().width() < 0) {
-            int nuevaX = escena->width();
-            int nuevaY = QRandomGenerator::global()->bounded(0, 100);
-            nubeItem->setPos(nuevaX, nuevaY);
-        }
-    }
+    if (capaNubes)
+        capaNubes->avanzar(velocidadNube);
 }
 
 /**
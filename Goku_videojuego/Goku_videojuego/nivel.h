@@ -6,11 +6,15 @@
 #include <QGraphicsPixmapItem>
 #include <QGraphicsScene>
 #include <QGraphicsView>
+#include <QLabel>
 #include <vector>
 #include "goku.h"
 #include "obstaculo.h"
 #include "vida.h"
 #include "progreso.h"
+#include "buclejuego.h"
+#include "capanubes.h"
+#include "capahud.h"
 
 /**
  * Clase base abstracta para los niveles del juego.
@@ -38,6 +42,8 @@ public:
 
     // Métodos comunes
     int getMargenHUD() const;
+    int getNumero() const;
+    QGraphicsScene* getEscena() const;
     virtual Goku* getGoku() const = 0;
     virtual bool haTerminado() const = 0;
 
@@ -57,16 +63,17 @@ protected:
 
     // Componentes del juego
     Goku* goku = nullptr;
+    CapaHud* hud = nullptr;                  // La vista la dibuja en drawForeground()
     Vida* barraVida = nullptr;
     Progreso* barraProgreso = nullptr;
 
-    // Temporizadores
-    QTimer* timerNivel = nullptr;
-    QTimer* timerNubes = nullptr;
+    // Tareas del bucle central
+    TareaBucle* tareaNivel = nullptr;
+    TareaBucle* tareaNubes = nullptr;
 
     // Elementos visuales
     std::vector<QGraphicsPixmapItem*> listaFondos;
-    std::vector<QGraphicsPixmapItem*> listaNubes;
+    CapaNubes* capaNubes = nullptr;          // Todas las nubes en un solo item
     std::vector<obstaculo*> listaObstaculos;
     QLabel* overlayGameOver = nullptr;
 
@@ -79,6 +86,7 @@ protected:
     const int margenHUD = 70;
 
     // Métodos protegidos
+    int altoVisible() const;    // Alto de la vista, o de la escena sin vista
     void generarNubes();
     void mostrarGameOver();
     void moverNubes();
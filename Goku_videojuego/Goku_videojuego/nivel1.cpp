@@ -2,8 +2,10 @@
 #include "goku1.h"
 #include "robot.h"
 #include "obstaculo.h"
-#include <QRandomGenerator>
+#include "spritecache.h"
 #include <QMessageBox>
+#include <QDebug>
+#include <stdexcept>
 
 // Inicialización del contador
 int Nivel1::contador = 0;
@@ -33,9 +35,10 @@ Nivel1::Nivel1(QGraphicsScene* escena, QGraphicsView* vista, QWidget* parent)
 
 Este método complementa al destructor de la clase base `Nivel` y realiza las siguientes tareas adicionales:
 
-- Detiene y elimina la cámara (`camara`) si fue creada.
-- Detiene y desconecta el temporizador de nivel (`timerNivel`) si sigue activo.
-- Elimina el carro final, los tres robots (`r1`, `r2`, `r3`) y todos los obstáculos agregados a la escena mediante `getSprite()`.
+- Elimina el fondo por capas (`fondo`) y luego la cámara (`camara`) si fue creada.
+- Detiene la tarea de nivel (`tareaNivel`) si sigue activa.
+- Elimina la secuencia de llegada de los robots y luego el carro final y los tres robots (`r1`, `r2`, `r3`) mediante `getSprite()`.
+- Elimina la cinta de obstáculos, que destruye los obstáculos de su ventana.
 
 @note Este destructor garantiza que todos los elementos visuales y lógicos específicos del Nivel 1 se liberen correctamente.
 
@@ -45,16 +48,17 @@ Nivel1::~Nivel1()
 {
     //qDebug() << "Destructor de Nivel1 llamado";
 
+    // El fondo consulta a la cámara al pintarse: se va antes que ella
+    delete fondo;
+    fondo = nullptr;
+
     // Limpiar la cámara
     if (camara) {
         camara->detenerMovimiento();
         delete camara;
     }
 
-    if (timerNivel) {
-        timerNivel->stop();
-        disconnect(timerNivel, nullptr, this, nullptr);
-    }
+    if (tareaNivel) tareaNivel->detener();
 
     // Eliminar carro (usando getSprite())
     if (carroFinal) {
@@ -62,19 +66,18 @@ Nivel1::~Nivel1()
         delete carroFinal;
     }
 
+    // La secuencia usa a los robots: se va antes que ellos
+    delete secuenciaRobots;
+    secuenciaRobots = nullptr;
+
     // Eliminar robots (usando getSprite())
     if (r1) { escena->removeItem(r1->getSprite()); delete r1; }
     if (r2) { escena->removeItem(r2->getSprite()); delete r2; }
     if (r3) { escena->removeItem(r3->getSprite()); delete r3; }
 
-    // Eliminar obstáculos (usando getSprite())
-    for (auto* obs : listaObstaculos) {
-        if (obs) {
-            escena->removeItem(obs->getSprite());
-            delete obs;
-        }
-    }
-    listaObstaculos.clear();
+    // Eliminar la cinta y con ella los obstáculos reciclados
+    delete cintaObstaculos;
+    cintaObstaculos = nullptr;
 }
 
 /**
@@ -85,7 +88,7 @@ Este método prepara el entorno de juego para el primer nivel realizando los sig
 - Carga el fondo del nivel (`cargarFondoNivel()`).
 - Genera nubes en movimiento y agrega al personaje principal (`Goku`), el carro final y los obstáculos.
 - Crea una cámara lógica (`camaraLogica`) que sigue al personaje mientras avanza.
-- Inicializa y activa un temporizador (`timerNivel`) que ejecuta periódicamente `actualizarNivel()` para controlar la lógica del nivel.
+- La lógica del nivel (`actualizarNivel()`) la ejecuta periódicamente la tarea `tareaNivel` registrada por la clase base en el bucle central.
 
 @see Nivel1::actualizarNivel
 @see Nivel1::agregarGoku
@@ -99,41 +102,47 @@ void Nivel1::iniciarNivel()
     generarNubes();
     agregarGoku();
     agregarCarroFinal();
-    agregarObstaculos();
 
+    // La cámara se crea antes que los obstáculos: la cinta recicla según lo que ella muestra
     camara = new camaraLogica(vista, this);
     camara->seguirAGoku(goku);
     camara->iniciarMovimiento();
+    fondo->setCamara(camara);
 
-    // 4) Arrancamos el timer del nivel como antes
-    timerNivel = new QTimer(this);
-    connect(timerNivel, &QTimer::timeout, this, &Nivel1::actualizarNivel);
-    timerNivel->start(20);
+    agregarObstaculos();
 }
 
 /**
-@brief Carga y posiciona múltiples copias del fondo para crear un escenario horizontal extendido.
+@brief Arma el fondo del nivel como tres capas de paralaje de la misma imagen.
 
-Este método utiliza la imagen especificada en `ruta` para crear un fondo repetido que cubre un área amplia del nivel.
+El fondo ya no agrega items a la escena: `FondoParalaje` lo dibuja desde `drawBackground()` de la
+vista, repitiendo cada franja a lo ancho tantas veces como haga falta, así que sirve para un
+nivel de cualquier largo. La imagen se corta en tres franjas horizontales:
 
-- Inserta 5 instancias del fondo (`cantidad = 5`) una al lado de la otra.
-- Cada fondo se coloca con `setZValue(-10)` para asegurar que permanezca detrás de los elementos del juego.
-- Los objetos creados se almacenan en `listaFondos` para su posterior gestión y limpieza.
+- Cielo (filas 0 a 219, por encima de las mesetas): queda fijo en pantalla; es un degradado vertical, uniforme a lo ancho.
+- Mesetas del horizonte (filas 220 a 429): avanzan al 35% de la cámara.
+- Suelo (filas 430 en adelante): se mueve con el mundo, igual que Goku y los obstáculos.
 
 @param ruta Ruta al recurso gráfico del fondo (por ejemplo, `:/images/background1.png`).
+
+@throw std::runtime_error Si no se puede cargar la imagen.
 */
 void Nivel1::cargarFondoNivel(const QString &ruta)
 {
-    QPixmap fondo(ruta);
-    int ancho = fondo.width();
-    int cantidad = 5;
-
-    for (int i = 0; i < cantidad; ++i) {
-        QGraphicsPixmapItem* fondoItem = escena->addPixmap(fondo);
-        fondoItem->setZValue(-10);
-        fondoItem->setPos(i * ancho, 0);
-        listaFondos.push_back(fondoItem);
+    QPixmap imagen = SpriteCache::instancia()->hoja(ruta);
+    if (imagen.isNull()) {
+        qCritical() << "Nivel1: no se pudo cargar el fondo" << ruta;
+        throw std::runtime_error("Nivel1: No se pudo cargar la imagen del fondo.");
     }
+
+    const int ancho = imagen.width();
+    const int horizonte = 220;
+    const int suelo = 430;
+
+    fondo = new FondoParalaje(escena, this);
+    fondo->agregarCapa(imagen, QRect(0, 0, ancho, horizonte), 0.0, 0, true);
+    fondo->agregarCapa(imagen, QRect(0, horizonte, ancho, suelo - horizonte), 0.35, horizonte);
+    fondo->agregarCapa(imagen, QRect(0, suelo, ancho, imagen.height() - suelo), 1.0, suelo);
 }
 
 /**
@@ -144,7 +153,7 @@ Este método crea e inicializa los componentes principales del jugador para el N
 - Coloca la barra de vida en la parte superior izquierda de la vista.
 - Agrega una barra de progreso que representa el avance hacia el carro final.
 - Crea una instancia de `Goku1`, carga su imagen, asocia la barra de vida y lo posiciona en la escena.
-- Inicia un temporizador que actualiza visualmente la barra de progreso a medida que Goku avanza.
+- Registra una tarea en el bucle central que actualiza visualmente la barra de progreso a medida que Goku avanza.
 
 @note La barra de progreso usa el ícono del carro (`:/images/icono_carro.png`) y se actualiza cada 50 ms.
 
@@ -158,14 +167,12 @@ void Nivel1::agregarGoku()
     int velocidad = 6;
 
     // Barra de vida en la esquina superior izquierda
-    barraVida = new Vida(vista);
-    barraVida->move(20, 20);
-    barraVida->show();
+    barraVida = new Vida(hud);
+    barraVida->setPosicion(QPoint(20, 20));
 
     // Nueva barra de progreso usando el ícono del carro y tipo Horizontal
-    barraProgreso = new Progreso(Horizontal, ":/images/icono_carro.png", vista);
-    barraProgreso->move(20, 60);
-    barraProgreso->show();
+    barraProgreso = new Progreso(Horizontal, ":/images/icono_carro.png", hud);
+    barraProgreso->setPosicion(QPoint(20, 60));
 
     // Goku nivel 1
     goku = new Goku1(escena, velocidad, 200, 249, this);
@@ -173,17 +180,16 @@ void Nivel1::agregarGoku()
     goku->setBarraVida(barraVida);
     goku->iniciar(posX, posY);
 
-    // Timer para actualizar el progreso de avance
-    QTimer* timerProgreso = new QTimer(this);
-    connect(timerProgreso, &QTimer::timeout, this, [=]() {
+    // Tarea para actualizar el progreso de avance
+    TareaBucle* tareaProgreso = new TareaBucle(BucleJuego::FaseHud, [this]() {
         //qDebug() << "timer progreso en nivel1 llamado  "<<contador++;
         if (goku && carroFinal && barraProgreso) {
             float inicio = 0;
             float fin = carroFinal->getSprite()->x();
             barraProgreso->actualizarProgreso(goku->x(), inicio, fin);
         }
-    });
-    timerProgreso->start(50);
+    }, this, "actualizarProgreso");
+    tareaProgreso->iniciar(50);
 }
 
 /**
@@ -204,60 +210,38 @@ void Nivel1::agregarCarroFinal()
 }
 
 /**
-@brief Agrega múltiples obstáculos al Nivel 1 de forma aleatoria y escalonada.
+@brief Pone en marcha la cinta de obstáculos del Nivel 1.
+
+En lugar de crear todos los obstáculos del recorrido, se crea una ventana fija de `ventanaObstaculos`
+obstáculos que la cinta recicla: cuando uno sale de la vista por la izquierda vuelve a colocarse
+delante con un tipo y una altura nuevos. El primero aparece en `x = 1500`.
 
-Este método genera 18 obstáculos a lo largo del recorrido del personaje, con posiciones iniciales a partir de `x = 1500`.
 Cada obstáculo puede ser de uno de los siguientes tipos seleccionados aleatoriamente:
 
 - `Ave`: se posiciona en una altura aleatoria entre 100 y 150.
 - `Montania`: se coloca en la base de la escena y se escala en altura.
 - `Roca`: se ubica entre 350 y 550 píxeles de altura.
 
-Cada obstáculo es inicializado con una velocidad fija de desplazamiento y espaciado horizontal variable para dar variedad al nivel.
+El recorrido tiene `totalObstaculos` obstáculos (18), los mismos que tenía el nivel original.
 
-@see obstaculo::iniciar
-@see obstaculo::cargarImagenes
+@see CintaObstaculos
 */
 void Nivel1::agregarObstaculos()
 {
-    int x = 1500;
     int velocidad = 10;
 
-    for (int i = 0; i < 18; ++i) {
-        int tipo = QRandomGenerator::global()->bounded(0, 3);
-        obstaculo* obs = nullptr;
-
-        switch (tipo) {
-        case 0:
-            obs = new obstaculo(escena, obstaculo::Ave, velocidad, this);
-            obs->iniciar(x, QRandomGenerator::global()->bounded(100, 150));
-            x += 500;
-            break;
-        case 1:
-            obs = new obstaculo(escena, obstaculo::Montania, velocidad, this);
-            obs->cargarImagenes();
-            obs->iniciar(x, escena->height() - obs->getAltura());
-            x += 600;
-            break;
-        case 2:
-            obs = new obstaculo(escena, obstaculo::Roca, velocidad, this);
-            obs->iniciar(x, QRandomGenerator::global()->bounded(350, 550));
-            x += 700;
-            break;
-        }
-
-        listaObstaculos.push_back(obs);
-    }
+    cintaObstaculos = new CintaObstaculos(escena, camara, ventanaObstaculos, velocidad, this);
+    cintaObstaculos->iniciar(1500, totalObstaculos);
 }
 
 /**
-@brief Lógica principal de actualización del Nivel 1, ejecutada periódicamente por un temporizador.
+@brief Lógica principal de actualización del Nivel 1, ejecutada periódicamente por el bucle central.
 
 Este método gestiona el avance del nivel verificando el estado del personaje, las colisiones y la progresión de los eventos:
 
 - Si Goku pierde toda la vida, se marca el nivel como perdido (`perdioGoku`) y se llama a `gameOver()`.
 - Si Goku alcanza el carro y no ha ejecutado aún la patada, se reproduce la animación de ataque y se inicia el movimiento en espiral del carro.
-- Una vez que el carro termina su caída (espiral completada y llega al suelo), se agregan los robots enemigos y se elimina el carro.
+- Una vez que el carro termina su caída (espiral completada y llega al suelo), se emite `carroAterrizo()`, se agregan los robots enemigos y se elimina el carro.
 - Después de 5 segundos, se emite la señal `nivelCompletado()` para continuar el flujo del juego.
 
 @see Goku1::haTocadoCarro
@@ -288,11 +272,12 @@ void Nivel1::actualizarNivel()
     }
 
     if (carroFinal->espiralHecha && carroFinal->haLlegadoAlSuelo()) {
+        emit carroAterrizo();
         agregarRobots();
         quitarCarroVista();
 
         // Espera 5 segundos antes de emitir la señal
-        QTimer::singleShot(5000, this, [this]() {
+        BucleJuego::instancia()->programar(5000, this, [this]() {
 
             //qDebug() << "timer single shot mostrar nivelcompletado en nivel 1 llamado  " <<contador++;
             emit nivelCompletado();
@@ -304,7 +289,7 @@ void Nivel1::actualizarNivel()
 @brief Agrega y despliega tres robots enemigos en el Nivel 1 después de que el carro cae al suelo.
 
 Este método crea tres instancias de `Robot` con velocidades y posiciones específicas,
-y las introduce de forma escalonada usando temporizadores para crear una secuencia de aparición dinámica.
+y las introduce de forma escalonada con una `SecuenciaAcciones` (`secuenciaRobots`) que avanza con el bucle central.
 
 - Los robots se despliegan con un retardo de 0 ms, 600 ms y 1200 ms respectivamente.
 - Después de 1800 ms, se detiene el movimiento de los tres robots con `detenerMvtoRobot()`.
@@ -329,30 +314,28 @@ void Nivel1::agregarRobots()
     r2 = new Robot(escena, velocidad, 2, this);
     r3 = new Robot(escena, velocidad, 3, this);
 
-    r1->iniciar(5000, ySuelo, 5300);
-    r1->desplegarRobot();
-
-    QTimer::singleShot(600, this, [=]() {
-
-        //qDebug() << "timer singles  robots 1 nivel1 llamado  "<<contador++;
-        r2->iniciar(5300, ySuelo, 5600);
-        r2->desplegarRobot();
-    });
-
-    QTimer::singleShot(1200, this, [=]() {
-
-        //qDebug() << "timer singles  robots 2 nivel1 llamado  "<<contador++;
-        r3->iniciar(5600, ySuelo, 5900);
-        r3->desplegarRobot();
-    });
-
-    QTimer::singleShot(1800, this, [=]() {
-
-        //qDebug() << "timer singles  robots 3 nivel1 llamado  "<<contador++;
-        r1->detenerMvtoRobot();
-        r2->detenerMvtoRobot();
-        r3->detenerMvtoRobot();
-    });
+    secuenciaRobots = new SecuenciaAcciones(this, BucleJuego::FaseNivel, "agregarRobots");
+    secuenciaRobots->hacer([=]() {
+            r1->iniciar(5000, ySuelo, 5300);
+            r1->desplegarRobot();
+        })
+        .esperar(600)
+        .hacer([=]() {
+            r2->iniciar(5300, ySuelo, 5600);
+            r2->desplegarRobot();
+        })
+        .esperar(600)
+        .hacer([=]() {
+            r3->iniciar(5600, ySuelo, 5900);
+            r3->desplegarRobot();
+        })
+        .esperar(600)
+        .hacer([=]() {
+            r1->detenerMvtoRobot();
+            r2->detenerMvtoRobot();
+            r3->detenerMvtoRobot();
+        });
+    secuenciaRobots->iniciar();
 }
 
 /**
@@ -380,7 +363,7 @@ void Nivel1::quitarCarroVista()
 Este método asegura que el proceso de derrota solo se ejecute una vez mediante la bandera `gameOverProcesado`.
 Realiza las siguientes acciones:
 
-- Detiene y desconecta el temporizador principal del nivel (`timerNivel`).
+- Detiene la tarea principal del nivel (`tareaNivel`).
 - Llama a `mostrarGameOver()` para mostrar visualmente la pantalla de derrota.
 - Emite la señal `gokuMurio()` para notificar al juego que Goku ha sido derrotado.
 
@@ -396,10 +379,7 @@ void Nivel1::gameOver()
     //pasamos a estado verdadero si ya se llamo
     gameOverProcesado = true;
 
-    if (timerNivel) {
-        timerNivel->stop();
-        disconnect(timerNivel, nullptr, this, nullptr);  //desconexión explícita
-    }
+    if (tareaNivel) tareaNivel->detener();
     mostrarGameOver();
     emit gokuMurio();
 }
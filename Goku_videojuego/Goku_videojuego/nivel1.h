@@ -5,6 +5,8 @@
 #include "robot.h"
 #include "carro.h"
 #include "camaralogica.h"
+#include "cintaobstaculos.h"
+#include "fondoparalaje.h"
 
 class Nivel1 : public Nivel
 {
@@ -31,16 +33,26 @@ public:
     void quitarCarroVista();
     bool getPerdioGoku() const;
 
+signals:
+    void carroAterrizo();   // El carro cayó; a partir de aquí solo queda la llegada de los robots
+
 private slots:
     void agregarRobots(); // Crea los robots enemigos cuando el carro aterriza
 
 private:
     // Elementos del nivel
-    camaraLogica* camara;
+    camaraLogica* camara = nullptr;
+    FondoParalaje* fondo = nullptr;      // Cielo, mesetas y suelo; lo pinta la vista
+    CintaObstaculos* cintaObstaculos = nullptr;
     Carro* carroFinal = nullptr;
     Robot* r1 = nullptr;
     Robot* r2 = nullptr;
     Robot* r3 = nullptr;
+    SecuenciaAcciones* secuenciaRobots = nullptr;   // Llegada escalonada de los robots
+
+    // Configuración
+    const int totalObstaculos = 18;    // Largo del recorrido
+    const int ventanaObstaculos = 5;   // Obstáculos vivos a la vez
 
     // Estados del nivel
     bool gokuYaPateo = false;
@@ -2,8 +2,10 @@
 #include "pocion.h"
 #include "goku2.h"
 #include "robot.h"
+#include "spritecache.h"
+#include "azarjuego.h"
+#include "rastreomemoria.h"
 #include <QMessageBox>
-#include <QRandomGenerator>
 #include <QTimer>
 #include <QDebug>
 #include <stdexcept>
@@ -17,7 +19,7 @@ int Nivel2::contador = 0;
 
 Inicializa los componentes y banderas internas específicas del segundo nivel, utilizando el constructor de la clase base `Nivel`.
 
-- Inicializa punteros clave como `robot`, `barraProgreso` y `temporizadorPociones` en `nullptr`.
+- Inicializa punteros clave como `robot` y `tareaPociones` en `nullptr`.
 - Establece las banderas de control en `false` (`robotInicialCreado`, `pocionesAgregadas`, `perdioGoku`).
 - No realiza acciones adicionales dentro del cuerpo del constructor para evitar llamadas inseguras a métodos virtuales.
 
@@ -28,8 +30,7 @@ Inicializa los componentes y banderas internas específicas del segundo nivel, u
 Nivel2::Nivel2(QGraphicsScene* escena, QGraphicsView* vista, QWidget* parent)
     : Nivel(escena, vista, parent, 2),
     robot(nullptr),
-    barraProgreso(nullptr),
-    temporizadorPociones(nullptr),
+    tareaPociones(nullptr),
     robotInicialCreado(false),
     pocionesAgregadas(false),
     perdioGoku(false)
@@ -42,7 +43,7 @@ Nivel2::Nivel2(QGraphicsScene* escena, QGraphicsView* vista, QWidget* parent)
 
 Este método complementa al destructor de la clase base `Nivel` realizando la limpieza de los siguientes elementos:
 
-1. Detiene, desconecta y elimina el `temporizadorPociones` que controla la aparición periódica de pociones.
+1. Detiene y elimina la tarea `tareaPociones` que controla la aparición periódica de pociones.
 2. Elimina todas las instancias de `Pocion` agregadas a la escena y limpia la lista `listaPociones`.
 3. Elimina el objeto `robot`, desconectando previamente todas sus señales y removiendo su sprite de la escena.
 
@@ -54,12 +55,11 @@ Nivel2::~Nivel2()
 {
     qDebug() << "Destructor de Nivel2 llamado";
 
-    // 1. Detener y desconectar timers primero
-    if (temporizadorPociones) {
-        temporizadorPociones->stop();
-        disconnect(temporizadorPociones, nullptr, this, nullptr);
-        delete temporizadorPociones;
-        temporizadorPociones = nullptr;
+    // 1. Detener y quitar del bucle las tareas primero
+    if (tareaPociones) {
+        tareaPociones->detener();
+        delete tareaPociones;
+        tareaPociones = nullptr;
     }
     //qDebug() << "Destructor nivel 2 destruyo el temporizador pociones correctamente";
 
@@ -88,6 +88,34 @@ Nivel2::~Nivel2()
     // NOTA: goku, barraVida y barraProgreso son liberados por la clase base Nivel
 }
 
+/**
+@brief Devuelve las hojas de sprites que usa el Nivel 2.
+
+`juego` las entrega a `PrecargaNivel` mientras se juega el final del Nivel 1, para que
+construir este nivel no tenga que decodificar ninguna imagen. Si se agrega una hoja a una
+entidad del nivel, conviene sumarla aquí.
+
+@return Rutas de recursos del fondo, HUD, Goku2, robot y pociones.
+*/
+QStringList Nivel2::recursos()
+{
+    return {
+        ":/images/background2.png",
+        ":/images/nube.png",
+        ":/images/icono_pocion.png",
+        ":/images/pocion.png",
+        ":/images/Goku_caminando.png",
+        ":/images/Goku_saltando.png",
+        ":/images/Goku_muere.png",
+        ":/images/Goku_kam1.png",
+        ":/images/Goku_kam2.png",
+        ":/images/robots1.png",
+        ":/images/robot.png",
+        ":/images/murioRobot.png",
+        ":/images/explosion.png"
+    };
+}
+
 /**
 @brief Inicia el Nivel 2, configurando el fondo, HUD, personajes y elementos interactivos.
 
@@ -95,7 +123,7 @@ Este método se encarga de preparar el entorno gráfico y lógico del segundo ni
 
 - Carga el fondo específico del nivel (`background2.png`) y genera nubes decorativas.
 - Crea e inserta la barra de vida y una barra de progreso basada en la recolección de pociones.
-- Inicializa un temporizador (`temporizadorPociones`) que genera nuevas pociones cada 2.5 segundos.
+- Registra una tarea en el bucle central (`tareaPociones`) que genera nuevas pociones cada 2.5 segundos.
 - Agrega a Goku, el robot enemigo y un conjunto inicial de pociones interactivas.
 
 @see Nivel2::agregarPocionAleatoria
@@ -108,19 +136,19 @@ void Nivel2::iniciarNivel()
     generarNubes();
 
     // Configuración del HUD (la liberación lo hace la clase base)
-    barraVida = new Vida(vista);
-    barraVida->move(20, 20);
-    barraVida->show();
+    barraVida = new Vida(hud);
+    barraVida->setPosicion(QPoint(20, 20));
 
-    barraProgreso = new Progreso(Pociones, ":/images/icono_pocion.png", vista);
-    barraProgreso->move(20, 60);
+    barraProgreso = new Progreso(Pociones, ":/images/icono_pocion.png", hud);
+    barraProgreso->setPosicion(QPoint(20, 60));
     barraProgreso->setTotalPociones(totalPociones);
-    barraProgreso->show();
 
-    // Temporizador de pociones (con parent QObject para auto-liberación)
-    temporizadorPociones = new QTimer(this);
-    connect(temporizadorPociones, &QTimer::timeout, this, &Nivel2::agregarPocionAleatoria);
-    temporizadorPociones->start(2500);
+    // Tarea de pociones (con parent QObject para auto-liberación)
+    tareaPociones = new TareaBucle(BucleJuego::FaseNivel, [this]() {
+        ETIQUETA_MEMORIA(MemoriaNivel);
+        agregarPocionAleatoria();
+    }, this, "agregarPocionAleatoria");
+    tareaPociones->iniciar(2500);
 
     // Elementos del juego
     agregarPociones();
@@ -144,7 +172,7 @@ Este método realiza las siguientes acciones:
 */
 void Nivel2::cargarFondoNivel(const QString &ruta)
 {
-    QPixmap fondo(ruta);
+    QPixmap fondo = SpriteCache::instancia()->hoja(ruta);
     if (fondo.isNull()) {
         throw std::runtime_error("Nivel2: no se pudo cargar el fondo del nivel.");
     }
@@ -157,7 +185,7 @@ void Nivel2::cargarFondoNivel(const QString &ruta)
     listaFondos.clear();
 
     // Crear nuevo fondo
-    QGraphicsPixmapItem* fondoItem = new QGraphicsPixmapItem(fondo);
+    QGraphicsPixmapItem* fondoItem = new PixmapNivel(fondo);
     fondoItem->setPos(0, 0);
     escena->addItem(fondoItem);
     listaFondos.push_back(fondoItem);
@@ -171,7 +199,7 @@ correctamente con la física del nivel:
 
 - Define las dimensiones del sprite (218x298 píxeles) y la velocidad de movimiento.
 - Carga su imagen inicial con `cargarImagen()`.
-- Establece el nivel del suelo (`setSueloY`) basado en la altura de la vista.
+- Establece el nivel del suelo (`setSueloY`) basado en la altura de la vista (o de la escena si no hay vista).
 - Posiciona a Goku2 en la escena en la coordenada `(100, ySuelo)`.
 
 @see Goku2::setSueloY
@@ -186,7 +214,7 @@ void Nivel2::agregarGoku()
     goku2->cargarImagen();
     goku2->setBarraVida(barraVida);
 
-    int ySuelo = vista->height() - altoFrame - 30;
+    int ySuelo = altoVisible() - altoFrame - 30;
     goku2->setSueloY(ySuelo);
     goku2->iniciar(100, ySuelo); // Posición inicial
 }
@@ -196,8 +224,7 @@ void Nivel2::agregarGoku()
 
 Este método realiza lo siguiente:
 
-- Carga la hoja de sprites `:/images/pocion.png`.
-- Extrae 6 frames individuales de tamaño 65x64 píxeles y los almacena en `framesPocion`.
+- Obtiene de `SpriteCache` los 6 frames de tamaño 65x64 píxeles de `:/images/pocion.png` y los almacena en `framesPocion`.
 - Crea una instancia de `Pocion` utilizando los frames y la posiciona en la escena.
 - La poción se agrega también a la lista `listaPociones` para su posterior gestión.
 
@@ -207,16 +234,10 @@ Este método realiza lo siguiente:
 */
 void Nivel2::agregarPociones()
 {
-    QPixmap hojaSprites(":/images/pocion.png");
-    if (hojaSprites.isNull()) {
-        throw std::runtime_error("Nivel2: imagen de poción no encontrada.");
-    }
-
-    framesPocion.clear(); // Limpiar frames existentes
-
     int anchoSprite = 65, altoSprite = 64;
-    for (int i = 0; i < 6; ++i) {
-        framesPocion.push_back(hojaSprites.copy(i * anchoSprite, 0, anchoSprite, altoSprite));
+    framesPocion = SpriteCache::instancia()->frames(":/images/pocion.png", anchoSprite, altoSprite, 6);
+    if (framesPocion.isEmpty()) {
+        throw std::runtime_error("Nivel2: imagen de poción no encontrada.");
     }
 
     // Primera poción
@@ -228,9 +249,9 @@ void Nivel2::agregarPociones()
 /**
 @brief Agrega una nueva poción en una posición aleatoria dentro de una grilla lógica en la escena del Nivel 2.
 
-Este método es llamado periódicamente por un temporizador (`temporizadorPociones`) para generar nuevas pociones durante el nivel.
+Este método es llamado periódicamente por la tarea `tareaPociones` del bucle central para generar nuevas pociones durante el nivel.
 
-- Si la barra de progreso indica que se han recolectado todas las pociones (`getPorcentaje() >= 1.0f`), se detiene el temporizador.
+- Si la barra de progreso indica que se han recolectado todas las pociones (`getPorcentaje() >= 1.0f`), se detiene la tarea.
 - Selecciona aleatoriamente una fila (0 a 1) y una columna (0 a 6) para colocar la poción.
 - Crea una nueva instancia de `Pocion` con los frames previamente cargados y la inserta en la escena y en `listaPociones`.
 
@@ -242,12 +263,12 @@ void Nivel2::agregarPocionAleatoria()
 
     //qDebug() << "timer pociones nivel2 llamado  "<<contador++;
     if (!barraProgreso || barraProgreso->getPorcentaje() >= 1.0f) {
-        temporizadorPociones->stop();
+        tareaPociones->detener();
         return;
     }
 
-    int fila = QRandomGenerator::global()->bounded(0, 2);
-    int columna = QRandomGenerator::global()->bounded(0, 7);
+    int fila = AzarJuego::generador()->bounded(0, 2);
+    int columna = AzarJuego::generador()->bounded(0, 7);
     Pocion* nuevaPocion = new Pocion(framesPocion, fila, columna, 7);
     escena->addItem(nuevaPocion);
     listaPociones.push_back(nuevaPocion);
@@ -270,15 +291,15 @@ void Nivel2::pocionRecolectada()
 }
 
 /**
-@brief Lógica principal de actualización del Nivel 2, ejecutada periódicamente por un temporizador.
+@brief Lógica principal de actualización del Nivel 2, ejecutada periódicamente por el bucle central.
 
 Este método controla la progresión del nivel verificando condiciones de derrota o victoria:
 
 - **Derrota:** Si la vida de Goku llega a 0, se marca el estado como perdido (`perdioGoku`) y se llama a `gameOver()`.
-- **Victoria:** Si la barra de progreso llega al 100%, se detienen los ataques del robot, los temporizadores relevantes,
+- **Victoria:** Si la barra de progreso llega al 100%, se detienen los ataques del robot, las tareas relevantes,
   y tras 1 segundo se inicia la animación de ataque Kamehameha de Goku2. Si el robot muere, se emite la señal `nivelCompletado`.
 
-@note Usa `QTimer::singleShot` para introducir una pausa antes de lanzar el ataque final.
+@note Usa `BucleJuego::programar` para introducir una pausa (en tiempo simulado) antes de lanzar el ataque final.
 
 @see Nivel2::gameOver
 @see Goku2::iniciarKamehameha
@@ -297,11 +318,11 @@ void Nivel2::actualizarNivel()
 
     // Verificar victoria (con QPointer para seguridad)
     if (barraProgreso && barraProgreso->getPorcentaje() >= 1.0f) {
-        temporizadorPociones->stop();
-        if (timerNivel) timerNivel->stop();
+        tareaPociones->detener();
+        if (tareaNivel) tareaNivel->detener();
         if (robot) robot->detenerAtaques();
 
-        QTimer::singleShot(1000, this, [this]() {
+        BucleJuego::instancia()->programar(1000, this, [this]() {
             //qDebug() << "timer antes iniciar kameja en nivel2 llamado  "<<contador++;
             Goku2* goku2 = static_cast<Goku2*>(goku);
             if (goku2 && robot) {
@@ -341,7 +362,7 @@ void Nivel2::agregarRobot()
 
 Este método se encarga de:
 
-- Detener el temporizador principal del nivel (`timerNivel`) y el temporizador de aparición de pociones.
+- Detener la tarea principal del nivel (`tareaNivel`) y la tarea de aparición de pociones.
 - Mostrar visualmente la pantalla de derrota llamando a `mostrarGameOver()`.
 - Emitir la señal `gokuMurio()` para notificar al sistema que el jugador ha perdido.
 
@@ -349,8 +370,8 @@ Este método se encarga de:
 @see Nivel::mostrarGameOver
 */
 void Nivel2::gameOver() {
-    if (timerNivel) timerNivel->stop();
-    if (temporizadorPociones) temporizadorPociones->stop();
+    if (tareaNivel) tareaNivel->detener();
+    if (tareaPociones) tareaPociones->detener();
     mostrarGameOver();
     emit gokuMurio();
 }
@@ -4,6 +4,7 @@
 #include "nivel.h"
 #include "pocion.h"
 #include "robot.h"
+#include <QStringList>
 #include <QVector>
 
 class Nivel2 : public Nivel
@@ -25,6 +26,8 @@ public:
     bool haTerminado() const override;
     Goku* getGoku() const override;
 
+    static QStringList recursos();   // Hojas que usa el nivel, para precargarlas
+
     // Métodos específicos del nivel 2
     void pocionRecolectada();
 
@@ -39,10 +42,9 @@ private:
     QVector<QPixmap> framesPocion;
     QVector<Pocion*> listaPociones;
     Robot* robot = nullptr;
-    Progreso* barraProgreso = nullptr;
 
-    // Temporizadores
-    QTimer* temporizadorPociones = nullptr;
+    // Tareas del bucle central
+    TareaBucle* tareaPociones = nullptr;
 
     // Estados del nivel
     bool robotInicialCreado = false;
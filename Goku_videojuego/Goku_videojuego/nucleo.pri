@@ -0,0 +1,96 @@
+# Núcleo del juego: entidades, niveles y bucle central.
+# Lo comparten el juego (Goku_videojuego.pro), el simulador sin vista (simulador/simulador.pro)
+# y las mediciones (benchmarks/benchmarks.pro y benchmarks/render/render.pro).
+
+QT += core gui
+QT += multimedia multimediawidgets
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+CONFIG += c++17
+
+# Zonas del perfilador (ZONA_PERFIL): solo en depuración, en release no generan código
+CONFIG(debug, debug|release): DEFINES += PERFILADOR_ACTIVO
+
+# AlmacenEntidades integra con SSE2 (siempre presente en x86-64). Para 8 entidades por vuelta
+# con AVX2, en equipos que lo tengan:  qmake "QMAKE_CXXFLAGS += -mavx2"
+
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+SOURCES += \
+    $$PWD/almacenentidades.cpp \
+    $$PWD/arenanivel.cpp \
+    $$PWD/azarjuego.cpp \
+    $$PWD/buclejuego.cpp \
+    $$PWD/camaralogica.cpp \
+    $$PWD/capahud.cpp \
+    $$PWD/capanubes.cpp \
+    $$PWD/carro.cpp \
+    $$PWD/cintaobstaculos.cpp \
+    $$PWD/estresnivel.cpp \
+    $$PWD/explosion.cpp \
+    $$PWD/fondoparalaje.cpp \
+    $$PWD/goku.cpp \
+    $$PWD/goku1.cpp \
+    $$PWD/goku2.cpp \
+    $$PWD/grabadorentradas.cpp \
+    $$PWD/mundocolisiones.cpp \
+    $$PWD/nivel.cpp \
+    $$PWD/nivel1.cpp \
+    $$PWD/nivel2.cpp \
+    $$PWD/obstaculo.cpp \
+    $$PWD/perfilador.cpp \
+    $$PWD/poolexplosiones.cpp \
+    $$PWD/pocion.cpp \
+    $$PWD/precarganivel.cpp \
+    $$PWD/progreso.cpp \
+    $$PWD/rastreomemoria.cpp \
+    $$PWD/registroentradas.cpp \
+    $$PWD/reproductorentradas.cpp \
+    $$PWD/robot.cpp \
+    $$PWD/secuenciaacciones.cpp \
+    $$PWD/spritecache.cpp \
+    $$PWD/tipoentidad.cpp \
+    $$PWD/trazaeventos.cpp \
+    $$PWD/vida.cpp
+
+HEADERS += \
+    $$PWD/almacenentidades.h \
+    $$PWD/arenanivel.h \
+    $$PWD/azarjuego.h \
+    $$PWD/buclejuego.h \
+    $$PWD/camaralogica.h \
+    $$PWD/capahud.h \
+    $$PWD/capanubes.h \
+    $$PWD/carro.h \
+    $$PWD/cintaobstaculos.h \
+    $$PWD/estresnivel.h \
+    $$PWD/explosion.h \
+    $$PWD/fondoparalaje.h \
+    $$PWD/goku.h \
+    $$PWD/goku1.h \
+    $$PWD/goku2.h \
+    $$PWD/grabadorentradas.h \
+    $$PWD/mundocolisiones.h \
+    $$PWD/nivel.h \
+    $$PWD/nivel1.h \
+    $$PWD/nivel2.h \
+    $$PWD/obstaculo.h \
+    $$PWD/perfilador.h \
+    $$PWD/poolexplosiones.h \
+    $$PWD/pocion.h \
+    $$PWD/precarganivel.h \
+    $$PWD/progreso.h \
+    $$PWD/rastreomemoria.h \
+    $$PWD/registroentradas.h \
+    $$PWD/reproductorentradas.h \
+    $$PWD/robot.h \
+    $$PWD/secuenciaacciones.h \
+    $$PWD/spritecache.h \
+    $$PWD/tipoentidad.h \
+    $$PWD/trazaeventos.h \
+    $$PWD/vida.h
+
+RESOURCES += \
+    $$PWD/resources.qrc
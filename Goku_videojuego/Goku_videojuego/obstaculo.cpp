@@ -1,7 +1,9 @@
 #include "obstaculo.h"
 #include "qgraphicsitem.h"
-#include "qtimer.h"
-#include <QRandomGenerator>
+#include "spritecache.h"
+#include "azarjuego.h"
+#include <limits>
+#include <stdexcept>  // Excepciones estándar
 
 // Inicialización del contador
 int obstaculo::contador = 0;
@@ -24,7 +26,9 @@ Crea el sprite gráfico del obstáculo y lo añade a la escena.
 
 Carga automáticamente las imágenes adecuadas según el tipo del obstáculo.
 
-Configura temporizadores internos para manejar el desplazamiento horizontal y la animación en caso del tipo Ave.
+Registra el sprite en el `MundoColisiones` (tipo `EntidadObstaculo`, o `EntidadExplosion` si es una explosión).
+
+Registra el sprite en el `AlmacenEntidades` de su clase (obstáculos, o proyectiles si es una explosión), que se encarga del desplazamiento y, en el caso del tipo Ave, de la animación.
 
 Incrementa un contador interno para llevar registro de los obstáculos existentes.
 */
@@ -33,9 +37,9 @@ obstaculo::obstaculo(QGraphicsScene *scene, Tipo tipo, int velocidad, QObject *p
     sprite(nullptr),
     scene(scene),
     frames(),
-    timerAnimacion(nullptr),
-    timerMovimiento(nullptr),
-    frameActual(0),
+    cuerpo(-1),
+    almacen(nullptr),
+    entrada(-1),
     velocidad(velocidad),
     coordX(0),
     coordY(0),
@@ -44,21 +48,23 @@ obstaculo::obstaculo(QGraphicsScene *scene, Tipo tipo, int velocidad, QObject *p
     tipo(tipo)
 {
     // Crear el objeto gráfico (sprite del obstáculo)
-    sprite = new QGraphicsPixmapItem();
+    sprite = new PixmapNivel();
     scene->addItem(sprite);  // Agregar el sprite a la escena para hacerlo visible
 
     cargarImagenes();  // Cargar la imagen correspondiente según el tipo
 
-    sprite->setData(0, "obstaculo");
-    // Crear temporizador para mover el obstáculo y conectar su señal al slot mover()
-    timerMovimiento = new QTimer(this);
-    connect(timerMovimiento, &QTimer::timeout, this, &obstaculo::mover);
+    // Registro en el mundo de colisiones; las explosiones son las únicas que buscan al jugador
+    if (tipo == Explosion)
+        cuerpo = MundoColisiones::instancia()->agregar(sprite, EntidadExplosion, EntidadJugador, this);
+    else
+        cuerpo = MundoColisiones::instancia()->agregar(sprite, EntidadObstaculo, EntidadNinguna, this);
 
-    // Si el tipo es Ave, necesita un temporizador adicional para animar los frames
-    if (tipo == Ave) {
-        timerAnimacion = new QTimer(this);
-        connect(timerAnimacion, &QTimer::timeout, this, &obstaculo::actualizar);
-    }
+    // Registro en el almacén: las explosiones definen sus propios avisos al terminar el vuelo
+    almacen = AlmacenEntidades::de(tipo == Explosion ? AlmacenEntidades::ClaseProyectil
+                                                     : AlmacenEntidades::ClaseObstaculo);
+    entrada = almacen->agregar(sprite, &frames, cuerpo);
+    if (tipo != Explosion)
+        almacen->setAlSalir(entrada, [this]() { retirar(); });   // Salió por el borde izquierdo
 
     contObsta +=1;
 
@@ -68,27 +74,80 @@ obstaculo::obstaculo(QGraphicsScene *scene, Tipo tipo, int velocidad, QObject *p
 /**
 @brief Inicializa la posición y comienza el movimiento y animación del obstáculo.
 
-Establece la posición inicial del sprite del obstáculo en la escena e inicia los temporizadores necesarios para controlar su desplazamiento horizontal y, si es un ave, la animación de sus frames.
+Establece la posición inicial del sprite del obstáculo en la escena y pone en marcha su entrada del almacén: desplazamiento horizontal y, si es un ave, la animación de sus frames.
 
 @param x Coordenada horizontal inicial del obstáculo.
 @param y Coordenada vertical inicial del obstáculo.
 
 @details
 
-Posiciona el sprite en las coordenadas dadas.
+Posiciona el sprite en las coordenadas dadas y lo muestra (un obstáculo reciclado llega oculto).
 
-Activa un temporizador que mueve horizontalmente el obstáculo cada 60 ms.
+Mueve el obstáculo `velocidad` píxeles a la izquierda cada 60 ms. Sale cuando su borde derecho pasa el borde izquierdo de la escena; en ese momento se retira (se detiene y se oculta).
 
-Si el obstáculo es del tipo Ave, inicia otro temporizador adicional que cambia la imagen del sprite cada 100 ms para simular el movimiento de alas.
+Si el obstáculo es del tipo Ave, cambia además la imagen del sprite cada 100 ms para simular el movimiento de alas.
 */
 void obstaculo::iniciar(int x, int y)
 {
-    sprite->setPos(x, y);  // Posicionar el sprite
+    sprite->show();        // Un obstáculo reciclado llega oculto
+    almacen->colocar(entrada, x, y);   // Posiciona el sprite y su cuerpo
 
-    timerMovimiento->start(60);  // Inicia el movimiento del obstáculo
+    const qreal ancho = sprite->pixmap().width();
+    almacen->setLimites(entrada, -ancho, std::numeric_limits<qreal>::infinity(),
+                        std::numeric_limits<qreal>::infinity());
+    almacen->mover(entrada, QPointF(-velocidad, 0), 0, 60);   // Inicia el movimiento del obstáculo
 
     if (tipo == Ave)
-        timerAnimacion->start(100);  // Inicia la animación de frames si es un ave
+        almacen->animar(entrada, 100, true);  // Inicia la animación de frames si es un ave
+}
+
+/**
+@brief Cambia el tipo del obstáculo para volver a usarlo en otra parte del nivel.
+
+Lo usa la cinta de obstáculos del Nivel 1 para reciclar un obstáculo que ya salió de la vista en
+lugar de crear uno nuevo. El obstáculo queda detenido; hay que llamar a `iniciar()` para colocarlo.
+
+@param nuevoTipo Tipo que tendrá el obstáculo (Ave, Montania o Roca).
+
+@details
+
+Lo detiene y vuelve a cargar las imágenes, lo que también sortea una altura nueva para
+montañas y rocas.
+
+@throw std::invalid_argument Si se intenta convertir en Explosion o reconfigurar una explosión.
+*/
+void obstaculo::reconfigurar(Tipo nuevoTipo)
+{
+    if (nuevoTipo == Explosion || tipo == Explosion)
+        throw std::invalid_argument("obstaculo::reconfigurar - las explosiones no se reciclan como obstáculos.");
+
+    retirar();
+
+    tipo = nuevoTipo;
+    frames.clear();
+    cargarImagenes();
+}
+
+/**
+@brief Detiene el obstáculo y lo oculta.
+
+Un obstáculo oculto no participa en las colisiones; vuelve a mostrarse con `iniciar()`.
+*/
+void obstaculo::retirar()
+{
+    almacen->detener(entrada);
+    sprite->hide();
+}
+
+/**
+@brief Indica si el obstáculo está en movimiento dentro del nivel.
+
+@return `true` mientras su entrada del almacén esté en movimiento; `false` si nunca se inició, si
+salió por el borde izquierdo de la escena o si fue retirado.
+*/
+bool obstaculo::estaActivo() const
+{
+    return almacen->enMovimiento(entrada);
 }
 
 /**
@@ -100,13 +159,13 @@ Este método inicializa los recursos gráficos adecuados dependiendo del tipo de
 
 Para el tipo Ave:
 
-Carga una hoja de sprites y extrae cuatro frames individuales para simular el vuelo mediante animación.
+Obtiene de la caché de sprites los cuatro frames individuales que simulan el vuelo mediante animación.
 
 Verifica que la imagen haya cargado correctamente antes de usarla.
 
 Para los tipos Montaña y Roca:
 
-Carga una imagen única del tipo respectivo y escala su altura de manera aleatoria para generar obstáculos visualmente diversos.
+Usa la imagen única del tipo respectivo y escala su altura de manera aleatoria para generar obstáculos visualmente diversos. Cada altura se escala una sola vez y se comparte entre los obstáculos que la repiten.
 
 @note Es fundamental que las imágenes estén correctamente ubicadas en la ruta de recursos para evitar errores.
 
@@ -117,40 +176,31 @@ void obstaculo::cargarImagenes()
         fotogWidth = 90;
         fotogHeight = 180;
 
-        QPixmap spriteSheet(":/images/pajaro.png");  // Hoja de sprites
+        // 4 frames de la hoja de sprites (uno por ala), compartidos por todas las aves
+        frames = SpriteCache::instancia()->frames(":/images/pajaro.png", fotogWidth, fotogHeight, 4);
 
-        if (spriteSheet.isNull()) {
+        if (frames.isEmpty()) {
             qWarning() << "No se pudo cargar pajaro.png";
             return;
         }
 
-        frames.clear();  // Limpiar cualquier frame anterior
-
-        // Extraer 4 frames de la hoja de sprites (uno por ala)
-        for (int i = 0; i < 4; ++i) {
-            frames.append(spriteSheet.copy(i * fotogWidth, 0, fotogWidth, fotogHeight));
-        }
-
-        if (!frames.isEmpty()) {
-            sprite->setPixmap(frames[0]);  // Mostrar el primer frame
-            frameActual = 0;
-        }
+        sprite->setPixmap(frames[0]);  // Mostrar el primer frame
     }
     else if (tipo == Montania) {
-        QPixmap montanaPixmap(":/images/montania.png");
+        SpriteCache* cache = SpriteCache::instancia();
 
         // Altura aleatoria para hacer la montaña más variada
-        int alturaMontana = 200 + QRandomGenerator::global()->bounded(100, 200);
-        QPixmap montanaEscalada = montanaPixmap.scaledToHeight(alturaMontana, Qt::SmoothTransformation);
+        int alturaMontana = 200 + AzarJuego::generador()->bounded(100, 200);
+        QPixmap montanaEscalada = cache->escaladoAlto(cache->hoja(":/images/montania.png"), alturaMontana);
 
         sprite->setPixmap(montanaEscalada);  // Asignar imagen escalada al sprite
     }
     else if (tipo == Roca) {
-        QPixmap rocaPixmap(":/images/roca.png");
+        SpriteCache* cache = SpriteCache::instancia();
 
         // Altura aleatoria para hacer la roca más variada
-        int alturaRoca = QRandomGenerator::global()->bounded(80, 200);
-        QPixmap rocaEscalada = rocaPixmap.scaledToHeight(alturaRoca, Qt::SmoothTransformation);
+        int alturaRoca = AzarJuego::generador()->bounded(80, 200);
+        QPixmap rocaEscalada = cache->escaladoAlto(cache->hoja(":/images/roca.png"), alturaRoca);
 
         sprite->setPixmap(rocaEscalada);  // Asignar imagen escalada al sprite
     }
@@ -159,11 +209,11 @@ void obstaculo::cargarImagenes()
 /**
 @brief Destructor de la clase obstaculo.
 
-Gestiona la liberación segura de recursos asociados al obstáculo, incluyendo gráficos (sprite) y temporizadores. Garantiza que todos los objetos dinámicos sean destruidos y que se detengan correctamente las animaciones y movimientos activos.
+Gestiona la liberación segura de recursos asociados al obstáculo, incluyendo gráficos (sprite), su cuerpo de colisión y su entrada en el almacén de entidades.
 
 @details
 
-Detiene y desconecta los temporizadores activos (timerMovimiento y timerAnimacion).
+Quita la entrada del almacén antes de destruir el sprite, que es su representante.
 
 Elimina el sprite gráfico del obstáculo y lo retira de la escena para evitar fugas de memoria.
 
@@ -172,25 +222,16 @@ Reduce el contador global de obstáculos activos para mantener la coherencia int
 obstaculo::~obstaculo()
 {
     //qDebug() << "Destructor de obs llamado";
-    delete sprite;
-    sprite = nullptr;
+    almacen->quitar(entrada);
+    entrada = -1;
 
-    // 1. Detener y desconectar timers
-    if (timerMovimiento) {
-        disconnect(timerMovimiento, nullptr, this, nullptr);
-        timerMovimiento->stop();
-        delete timerMovimiento;
-        timerMovimiento = nullptr;
-    }
+    MundoColisiones::instancia()->quitar(cuerpo);
+    cuerpo = -1;
 
-    if (timerAnimacion) {
-        disconnect(timerAnimacion, nullptr, this, nullptr);
-        timerAnimacion->stop();
-        delete timerAnimacion;
-        timerAnimacion = nullptr;
-    }
+    delete sprite;
+    sprite = nullptr;
 
-    // 2. Remover sprite de la escena si ambos existen
+    // Remover sprite de la escena si ambos existen
     if (scene && sprite) {
         scene->removeItem(sprite);
         delete sprite;
@@ -201,57 +242,6 @@ obstaculo::~obstaculo()
     //qDebug() << "obstaculos restantes" << contObsta;
 }
 
-/**
-@brief Mueve horizontalmente el obstáculo hacia la izquierda.
-
-Desplaza el sprite del obstáculo a la izquierda en función de la velocidad configurada. Este método es llamado periódicamente por un temporizador.
-
-@details
-
-Si el obstáculo alcanza el borde izquierdo de la pantalla (desaparece del área visible), se detienen los temporizadores de movimiento y animación (si aplica), y el sprite se oculta para optimizar el rendimiento.
-
-@note El desplazamiento negativo indica movimiento hacia la izquierda.
-*/
-void obstaculo::mover()
-{
-
-    //qDebug() << "timer mvto en obstaculo llamado  "<<contador++;
-    sprite->moveBy(-velocidad, 0);  // Desplazar el sprite a la izquierda
-
-    // Si ya salió de la pantalla, detener timers y ocultar el sprite
-    if (sprite->x() + sprite->pixmap().width() < 0) {
-        timerMovimiento->stop();
-
-        if (tipo == Ave)
-            timerAnimacion->stop();
-
-        sprite->hide();
-    }
-}
-
-/**
-@brief Actualiza el frame del sprite para animar el obstáculo tipo Ave.
-
-Este método se llama periódicamente mediante un temporizador para cambiar cíclicamente entre distintos frames almacenados, simulando el movimiento o animación visual del obstáculo Ave.
-
-@details
-
-Verifica primero que haya frames disponibles para la animación.
-
-Incrementa el índice del frame actual de forma cíclica.
-
-Actualiza el sprite con el nuevo frame correspondiente al índice actual.
-*/
-void obstaculo::actualizar()
-{
-
-    //qDebug() << "timer animacion ave obstaculo llamado   "<<contador++;
-    if (frames.isEmpty()) return;
-
-    frameActual = (frameActual + 1) % frames.size();  // Avanzar al siguiente frame
-    sprite->setPixmap(frames[frameActual]);           // Actualizar el sprite con el nuevo frame
-}
-
 /**
 @brief Devuelve la altura actual del sprite del obstáculo.
 
@@ -4,13 +4,17 @@
 #include <QObject>
 #include <QGraphicsScene>
 #include <QGraphicsPixmapItem>
-#include <QTimer>
+#include "buclejuego.h"
+#include "mundocolisiones.h"
+#include "almacenentidades.h"
+#include "arenanivel.h"
 
 
 class obstaculo : public QObject
 {
     Q_OBJECT
 public:
+    ENTIDAD_DE_NIVEL   // Se reserva en la arena del nivel (también Carro y Explosion)
     static int contador;
 
     static int contObsta;
@@ -20,6 +24,10 @@ public:
 
     void cargarImagenes();
     virtual void iniciar(int x = -1, int y = -1);
+    void reconfigurar(Tipo nuevoTipo);   // Reutiliza el obstáculo con otro tipo e imagen
+    void retirar();                      // Lo detiene y oculta hasta el próximo iniciar()
+    bool estaActivo() const;
+    Tipo getTipo() const { return tipo; }
     int getAltura() const;
     QGraphicsPixmapItem* getSprite() const { return sprite; }
 
@@ -27,16 +35,12 @@ public:
     QGraphicsPixmapItem *sprite;
     QGraphicsScene *scene;
     QVector<QPixmap> frames;  // Para almacenar los fotogramas del sprite del ave
-    QTimer *timerAnimacion;
-
-private slots:
-    void mover();
-    void actualizar();
+    int cuerpo;               // Cuerpo en el mundo de colisiones
+    AlmacenEntidades *almacen;   // Mueve y anima el sprite (obstáculos o proyectiles)
+    int entrada;              // Entrada en el almacén
 
 private:
 
-    QTimer *timerMovimiento;
-    int frameActual;
     int velocidad;
     int coordX;
     int coordY;
@@ -0,0 +1,153 @@
+#include "perfilador.h"
+#include <QDebug>
+#include <algorithm>
+#include <cstring>
+
+/**
+@brief Constructor privado. Empieza a medir el tiempo.
+*/
+Perfilador::Perfilador()
+{
+    reloj.start();
+}
+
+/**
+@brief Devuelve la instancia única del perfilador.
+
+No depende de la aplicación de Qt, así que se puede usar desde cualquier zona, incluso antes de
+crear la ventana.
+
+@return Puntero al perfilador.
+*/
+Perfilador* Perfilador::instancia()
+{
+    static Perfilador unico;
+    return &unico;
+}
+
+/**
+@brief Registra una zona con nombre.
+
+Cada ZONA_PERFIL llama a este método una sola vez (la primera vez que se ejecuta). Las zonas con
+el mismo nombre, por ejemplo las de una plantilla instanciada varias veces, comparten el id.
+
+@param nombre Nombre de la zona; debe ser un literal o tener vida estática.
+@return Identificador de la zona. Si ya no hay lugar, se reutiliza la última.
+*/
+int Perfilador::registrarZona(const char* nombre)
+{
+    for (int i = 0; i < zonas; ++i) {
+        if (std::strcmp(nombres[i], nombre) == 0) return i;
+    }
+
+    if (zonas == maxZonas) {
+        qWarning() << "Perfilador: no hay lugar para la zona" << nombre;
+        return maxZonas - 1;
+    }
+
+    nombres[zonas] = nombre;
+    return zonas++;
+}
+
+/**
+@brief Cierra el frame en curso.
+
+Guarda el tiempo real desde el cierre anterior y lo que sumó cada zona, y deja las zonas en cero
+para el frame siguiente. El primer cierre solo marca el inicio.
+*/
+void Perfilador::cerrarFrame()
+{
+    const qint64 ahora = ahoraNs();
+    if (ultimoFrameNs < 0) {
+        ultimoFrameNs = ahora;
+        std::fill(acumuladoNs, acumuladoNs + maxZonas, 0);
+        return;
+    }
+
+    msFrames[posicion] = static_cast<float>((ahora - ultimoFrameNs) / 1e6);
+    for (int i = 0; i < zonas; ++i) {
+        msZonas[i][posicion] = static_cast<float>(acumuladoNs[i] / 1e6);
+        acumuladoNs[i] = 0;
+    }
+
+    ultimoFrameNs = ahora;
+    posicion = (posicion + 1) % ventanaFrames;
+    llenos = qMin(llenos + 1, ventanaFrames);
+}
+
+/**
+@brief Descarta la historia; el próximo frame vuelve a ser el primero.
+
+Se usa al arrancar el bucle para no mezclar el tiempo que estuvo detenido con los frames.
+*/
+void Perfilador::reiniciar()
+{
+    ultimoFrameNs = -1;
+    posicion = 0;
+    llenos = 0;
+    std::fill(acumuladoNs, acumuladoNs + maxZonas, 0);
+}
+
+/**
+@brief Calcula los percentiles de la duración de los frames de la ventana.
+
+@return Estadísticas en milisegundos; todo en cero si todavía no hay frames.
+*/
+Perfilador::Estadisticas Perfilador::estadisticas() const
+{
+    Estadisticas resultado;
+    float ordenados[ventanaFrames];
+    const int cantidad = historial(ordenados, ventanaFrames);
+    if (cantidad == 0) return resultado;
+
+    resultado.frames = cantidad;
+    resultado.ultimo = ordenados[cantidad - 1];
+
+    double suma = 0;
+    for (int i = 0; i < cantidad; ++i) suma += ordenados[i];
+    resultado.promedio = suma / cantidad;
+
+    std::sort(ordenados, ordenados + cantidad);
+    auto percentil = [&](double p) {
+        const int indice = qMin(cantidad - 1, static_cast<int>(p * cantidad));
+        return static_cast<double>(ordenados[indice]);
+    };
+    resultado.p50 = percentil(0.50);
+    resultado.p95 = percentil(0.95);
+    resultado.p99 = percentil(0.99);
+    resultado.maximo = ordenados[cantidad - 1];
+    return resultado;
+}
+
+/**
+@brief Copia la duración de los frames de la ventana en orden cronológico.
+
+@param salida Buffer de destino.
+@param maximo Capacidad del buffer.
+@return Cantidad de valores escritos.
+*/
+int Perfilador::historial(float* salida, int maximo) const
+{
+    const int cantidad = qMin(llenos, maximo);
+    int indice = (posicion - cantidad + ventanaFrames) % ventanaFrames;
+    for (int i = 0; i < cantidad; ++i) {
+        salida[i] = msFrames[indice];
+        indice = (indice + 1) % ventanaFrames;
+    }
+    return cantidad;
+}
+
+/**
+@brief Tiempo promedio por frame de una zona en la ventana.
+
+@param zona Identificador devuelto por `registrarZona`.
+@return Milisegundos por frame.
+*/
+double Perfilador::msZona(int zona) const
+{
+    if (zona < 0 || zona >= zonas || llenos == 0) return 0;
+
+    double suma = 0;
+    for (int i = 0; i < llenos; ++i) suma += msZonas[zona][i];
+    return suma / llenos;
+}
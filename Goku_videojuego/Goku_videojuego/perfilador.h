@@ -0,0 +1,98 @@
+#ifndef PERFILADOR_H
+#define PERFILADOR_H
+
+#include <QElapsedTimer>
+#include <QtGlobal>
+
+/**
+ * Perfilador de frames del juego.
+ * Mide el tiempo real entre frames del BucleJuego y, dentro de cada frame, el tiempo gastado en
+ * las zonas marcadas con ZONA_PERFIL. Guarda los últimos `ventanaFrames` frames para calcular
+ * percentiles y promedios por zona, que VistaJuego muestra con F3.
+ *
+ * Las zonas solo existen en las compilaciones de depuración (PERFILADOR_ACTIVO); en release la
+ * macro no genera código y el perfilador solo registra la duración de los frames.
+ */
+class Perfilador
+{
+public:
+    static constexpr int maxZonas = 32;
+    static constexpr int ventanaFrames = 240;    // ~4 s a 60 FPS
+
+    // Resumen de la ventana de frames, en milisegundos
+    struct Estadisticas {
+        int frames = 0;
+        double ultimo = 0;
+        double promedio = 0;
+        double p50 = 0, p95 = 0, p99 = 0;
+        double maximo = 0;
+    };
+
+    static Perfilador* instancia();
+
+    int registrarZona(const char* nombre);   // Devuelve el id; el mismo nombre da el mismo id
+    void sumar(int zona, qint64 ns) { acumuladoNs[zona] += ns; }
+    qint64 ahoraNs() const { return reloj.nsecsElapsed(); }
+
+    void cerrarFrame();                      // Lo llama el bucle al terminar cada frame
+    void reiniciar();
+
+    Estadisticas estadisticas() const;
+    int historial(float* salida, int maximo) const;   // Duración de los frames, del más viejo al último
+
+    int numZonas() const { return zonas; }
+    const char* nombreZona(int zona) const { return nombres[zona]; }
+    double msZona(int zona) const;           // Promedio por frame en la ventana
+
+private:
+    Perfilador();
+
+    QElapsedTimer reloj;
+    qint64 ultimoFrameNs = -1;
+
+    const char* nombres[maxZonas] = {};
+    qint64 acumuladoNs[maxZonas] = {};       // Frame en curso
+    int zonas = 0;
+
+    float msFrames[ventanaFrames] = {};      // Buffer circular de duraciones de frame
+    float msZonas[maxZonas][ventanaFrames] = {};
+    int posicion = 0;                        // Próxima posición a escribir
+    int llenos = 0;
+
+    // Bloqueamos copia y asignación
+    Perfilador(const Perfilador&) = delete;
+    Perfilador& operator=(const Perfilador&) = delete;
+};
+
+/**
+ * Zona medida por el perfilador: suma a su zona el tiempo entre su construcción y su destrucción.
+ * No se usa directamente sino a través de ZONA_PERFIL.
+ */
+class ZonaPerfil
+{
+public:
+    explicit ZonaPerfil(int zona) : zona(zona), inicio(Perfilador::instancia()->ahoraNs()) {}
+    ~ZonaPerfil()
+    {
+        Perfilador* perfilador = Perfilador::instancia();
+        perfilador->sumar(zona, perfilador->ahoraNs() - inicio);
+    }
+
+private:
+    int zona;
+    qint64 inicio;
+};
+
+#define ZONA_PERFIL_UNIR_(a, b) a##b
+#define ZONA_PERFIL_UNIR(a, b) ZONA_PERFIL_UNIR_(a, b)
+
+// Mide el resto del bloque actual bajo el nombre indicado (un literal de cadena)
+#ifdef PERFILADOR_ACTIVO
+#define ZONA_PERFIL(nombre) \
+    static const int ZONA_PERFIL_UNIR(idZonaPerfil_, __LINE__) = Perfilador::instancia()->registrarZona(nombre); \
+    ZonaPerfil ZONA_PERFIL_UNIR(zonaPerfil_, __LINE__)(ZONA_PERFIL_UNIR(idZonaPerfil_, __LINE__))
+#else
+#define ZONA_PERFIL(nombre) do {} while (false)
+#endif
+
+#endif // PERFILADOR_H
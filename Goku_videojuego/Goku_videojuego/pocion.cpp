@@ -1,7 +1,9 @@
 #include "pocion.h"
-#include <QRandomGenerator>
+#include "spritecache.h"
+#include "azarjuego.h"
 #include <QGraphicsScene>
 #include <QDebug>
+#include <limits>
 #include <stdexcept>  // Para lanzar excepciones
 
 // Inicialización del contador
@@ -27,13 +29,17 @@ Verifica que los parámetros sean válidos, lanzando excepciones si no se cumple
 
 Posiciona la poción horizontalmente de forma aleatoria dentro de su columna asignada, y verticalmente según la fila y un desplazamiento adicional aleatorio.
 
-Inicia un temporizador interno que controla la animación y desplazamiento vertical de la poción cada 100 ms.
+Registra la poción en el `MundoColisiones` con el tipo `EntidadPocion`.
+
+Registra la poción en el `AlmacenEntidades` de pociones, que la hace caer 3 píxeles y cambia su frame cada 100 ms. El límite inferior se fija al agregarla a la escena (ver `itemChange()`).
 
 Aplica un valor Z (profundidad gráfica) que asegura que la poción esté visualmente sobre otros elementos del fondo.
 */
 Pocion::Pocion(const QVector<QPixmap>& framesOriginales, int fila, int columna, int columnas, QGraphicsItem* parent)
     : QGraphicsPixmapItem(parent),   // Establece el padre gráfico
-    indiceFrame(0),                  // Comienza en el primer frame
+    cuerpo(-1),                      // Aún no registrada en el mundo de colisiones
+    almacen(AlmacenEntidades::de(AlmacenEntidades::ClasePocion)),
+    entrada(-1),                     // Aún no registrada en el almacén
     fila(fila),                      // Fila lógica en la grilla
     columna(columna),                // Columna lógica
     columnasTotales(columnas)        // Total de columnas disponibles
@@ -48,13 +54,8 @@ Pocion::Pocion(const QVector<QPixmap>& framesOriginales, int fila, int columna,
         throw std::invalid_argument("Pocion: el número de columnas debe ser mayor que cero.");
     }
 
-    // Escala cada imagen de la animación al 80% de su tamaño original
-    for (const QPixmap& original : framesOriginales) {
-        frames.append(original.scaled(original.width() * 0.8,
-                                      original.height() * 0.8,
-                                      Qt::KeepAspectRatio,
-                                      Qt::SmoothTransformation));
-    }
+    // Frames al 80% de su tamaño original; la caché los escala una sola vez para todas las pociones
+    frames = SpriteCache::instancia()->escalados(framesOriginales, 0.8);
 
     setPixmap(frames[0]); // Establece el primer frame como imagen inicial
     setZValue(1);         // Aparece por encima de otros elementos del fondo
@@ -71,19 +72,23 @@ Pocion::Pocion(const QVector<QPixmap>& framesOriginales, int fila, int columna,
         throw std::runtime_error("Pocion: los márgenes de posicionamiento horizontal son inválidos.");
     }
 
-    int x = QRandomGenerator::global()->bounded(minX, maxX + 1);  // Posición X aleatoria
+    int x = AzarJuego::generador()->bounded(minX, maxX + 1);  // Posición X aleatoria
 
     // Posición Y determinada por su fila, con variación aleatoria
     int espacioY = 300;
-    int offsetY = QRandomGenerator::global()->bounded(-300, 300);
+    int offsetY = AzarJuego::generador()->bounded(-300, 300);
     int y = -400 + fila * espacioY + offsetY;       // Inicia fuera del área visible
 
     setPos(x, y);                                   // Posiciona la poción en la escena
 
-    // Crea el temporizador de animación
-    timer = new QTimer(this);                       // Qt se encargará de destruirlo
-    connect(timer, &QTimer::timeout, this, &Pocion::moverYAnimar);
-    timer->start(100);    // Llama moverYAnimar() cada 100 ms
+    // Registro en el mundo de colisiones para que Goku2 la pueda recolectar
+    cuerpo = MundoColisiones::instancia()->agregar(this, EntidadPocion, EntidadNinguna, this);
+
+    // Caída y animación desde el almacén: 3 px hacia abajo y un frame nuevo cada 100 ms
+    entrada = almacen->agregar(this, &frames, cuerpo);
+    almacen->setAlSalir(entrada, [this]() { reaparecer(); });
+    almacen->mover(entrada, QPointF(0, 3), 0, 100);
+    almacen->animar(entrada, 100, true);
 
     //contador+=1;
     //qDebug() << "Pociones creadas  "<<contador;
@@ -92,74 +97,66 @@ Pocion::Pocion(const QVector<QPixmap>& framesOriginales, int fila, int columna,
 /**
 @brief Destructor de la clase Pocion.
 
-Libera los recursos utilizados por la poción, principalmente el temporizador encargado de la animación y el movimiento vertical del objeto gráfico.
-
-@details
-
-Detiene y desconecta de forma segura el temporizador interno si está activo.
-
-Libera la memoria utilizada por dicho temporizador, garantizando la correcta gestión de recursos.
+Quita la poción del almacén de entidades, que deja de moverla y animarla, y del mundo de colisiones.
 */
 Pocion::~Pocion(){
     //qDebug() << "Destructor de Pocion llamado";
-    if (timer) {
-        disconnect(timer, nullptr, this, nullptr);
-        timer->stop();
-        delete timer;
-        timer = nullptr;
-    }
+    almacen->quitar(entrada);
+    entrada = -1;
+
+    MundoColisiones::instancia()->quitar(cuerpo);
 
     //contador-=1;
     //qDebug() << "Pociones eliminadas  "<<contador;
 }
 
 /**
-@brief Desplaza verticalmente y anima la poción en la escena.
+@brief Fija el límite inferior de la caída cuando la poción entra en una escena.
 
-Este método se ejecuta periódicamente mediante un temporizador interno para producir el movimiento descendente y la animación cíclica del sprite. Además, reposiciona la poción cuando esta desaparece por la parte inferior del área visible.
+La poción se crea antes de agregarse a la escena, así que el alto recién se conoce aquí. Sin
+escena no tiene límite y sigue cayendo.
 
-@details
+@param cambio Tipo de cambio que notifica Qt.
+@param valor Valor asociado al cambio.
+@return El valor que devuelve `QGraphicsPixmapItem::itemChange()`.
+*/
+QVariant Pocion::itemChange(GraphicsItemChange cambio, const QVariant& valor)
+{
+    if (cambio == ItemSceneHasChanged && entrada >= 0) {
+        const qreal infinito = std::numeric_limits<qreal>::infinity();
+        const qreal abajo = scene() ? scene()->height() + 1 : infinito;   // Sale cuando y > alto
+        almacen->setLimites(entrada, -infinito, infinito, abajo);
+    }
 
-Mueve la poción hacia abajo 3 píxeles en cada llamada.
+    return QGraphicsPixmapItem::itemChange(cambio, valor);
+}
 
-Cambia cíclicamente el frame de animación del sprite.
+/**
+@brief Recoloca la poción arriba después de salir por la parte inferior de la escena.
 
-Si la poción sale del límite inferior de la pantalla, reaparece en una posición horizontal aleatoria dentro de su columna asignada y con una nueva posición vertical superior, proporcionando así un comportamiento continuo.
+El almacén la llama cuando la caída cruza el límite inferior. Reaparece en una posición horizontal aleatoria dentro de su columna asignada y con una nueva posición vertical superior, proporcionando así un comportamiento continuo; la caída y la animación siguen sin reiniciarse.
 */
-void Pocion::moverYAnimar()
+void Pocion::reaparecer()
 {
-    //qDebug() << "timer animar en pocion llamado  "<<contador++;
-
-    moveBy(0, 3);  // Desplaza hacia abajo.
-
-    // Animación cíclica.
-    indiceFrame = (indiceFrame + 1) % frames.size();
-    setPixmap(frames[indiceFrame]);
-
-    // Reaparecer si sale de la pantalla.
-    if (y() > scene()->height()) {
-        int anchoSprite = frames[0].width();
-        int espacioX = LimiteAnchoX / columnasTotales;
-        int baseX = columna * espacioX;
-        int minX = std::max(0, baseX - 15);
-        int maxX = std::min(LimiteAnchoX - anchoSprite, baseX + 15);
-
-        if (minX < maxX) {  // Validación adicional.
-            int x = QRandomGenerator::global()->bounded(minX, maxX + 1);
-            int yNuevo = -400 + fila * 100 + QRandomGenerator::global()->bounded(-200, 200);
-            setPos(x, yNuevo);
-        }
+    int anchoSprite = frames[0].width();
+    int espacioX = LimiteAnchoX / columnasTotales;
+    int baseX = columna * espacioX;
+    int minX = std::max(0, baseX - 15);
+    int maxX = std::min(LimiteAnchoX - anchoSprite, baseX + 15);
+
+    if (minX < maxX) {  // Validación adicional.
+        int x = AzarJuego::generador()->bounded(minX, maxX + 1);
+        int yNuevo = -400 + fila * 100 + AzarJuego::generador()->bounded(-200, 200);
+        almacen->colocar(entrada, x, yNuevo);
     }
 }
 
 /**
 @brief Detiene la animación y el movimiento de la poción.
 
-Este método detiene el temporizador interno que controla el desplazamiento y la animación de la poción, congelando su estado visual y posicional.
+Este método detiene la entrada del almacén que controla el desplazamiento y la animación de la poción, congelando su estado visual y posicional.
 */
 void Pocion::detener()
 {
-    if (timer) {
-        timer->stop();  // Detiene el movimiento y animación
-    }
+    almacen->detener(entrada);  // Detiene el movimiento y animación
 }
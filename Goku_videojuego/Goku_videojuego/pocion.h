@@ -2,32 +2,40 @@
 #define POCION_H
 
 #include <QGraphicsPixmapItem>
-#include <QTimer>
 #include <QVector>
 #include <QObject>
+#include "buclejuego.h"
+#include "mundocolisiones.h"
+#include "almacenentidades.h"
+#include "arenanivel.h"
 
 /**
  * Clase gráfica animada que representa una poción en la escena del juego.
  * Hereda de QObject para usar señales/slots y de QGraphicsPixmapItem para renderizado.
+ * La caída y la animación las hace su entrada en el almacén de pociones; el item solo se dibuja.
  */
 class Pocion : public QObject, public QGraphicsPixmapItem
 {
     Q_OBJECT
 
 public:
+    ENTIDAD_DE_NIVEL   // Se reserva en la arena del nivel
     static int contador;
 
     Pocion(const QVector<QPixmap>& framesOriginales, int fila, int columna, int columnas, QGraphicsItem* parent = nullptr);
     ~Pocion();
     void detener();
 
-private slots:
-    void moverYAnimar();         // Slot que mueve y cambia el frame de la poción.
+protected:
+    QVariant itemChange(GraphicsItemChange cambio, const QVariant& valor) override;   // Límite inferior al entrar en la escena
 
 private:
+    void reaparecer();           // Vuelve a caer desde arriba al salir por abajo.
+
     QVector<QPixmap> frames;     //Frames animados escalados.
-    int indiceFrame;             // Índice actual del frame mostrado.
-    QTimer* timer;               // Temporizador que controla la animación.
+    int cuerpo;                  // Cuerpo en el mundo de colisiones (tipo poción).
+    AlmacenEntidades* almacen;   // Almacén de pociones: caída y animación.
+    int entrada;                 // Entrada en el almacén.
 
     int fila;                    // Posición lógica (grilla) en Y.
     int columna;                 // Posición lógica (grilla) en X.
@@ -0,0 +1,127 @@
+#include "poolexplosiones.h"
+#include "explosion.h"
+#include "rastreomemoria.h"
+#include <QDebug>
+#include <stdexcept>  // Excepciones estándar
+
+/**
+@brief Constructor de la reserva de explosiones.
+
+Crea de una vez `capacidadInicial` explosiones ocultas en la escena, de modo que los primeros
+disparos del combate no necesiten crear objetos ni cargar frames.
+
+@param scene Escena donde viven las explosiones. No puede ser nula.
+@param capacidadInicial Explosiones creadas en el constructor.
+@param tamBloque Cuántas explosiones se agregan cada vez que la reserva se queda sin libres.
+@param capacidadMaxima Límite total de explosiones; al alcanzarlo `adquirir()` devuelve nullptr.
+@param parent Objeto padre en la jerarquía de Qt.
+
+@throw std::invalid_argument Si la escena es nula o los tamaños no son positivos.
+*/
+PoolExplosiones::PoolExplosiones(QGraphicsScene* scene, int capacidadInicial, int tamBloque,
+                                 int capacidadMaxima, QObject* parent)
+    : QObject(parent),
+    scene(scene),
+    tamBloque(tamBloque),
+    capacidadMaxima(capacidadMaxima)
+{
+    if (!scene)
+        throw std::invalid_argument("PoolExplosiones: la escena no puede ser nula.");
+
+    if (capacidadInicial < 0 || tamBloque <= 0 || capacidadMaxima <= 0)
+        throw std::invalid_argument("PoolExplosiones: capacidades no válidas.");
+
+    todas.reserve(capacidadMaxima);
+    libres.reserve(capacidadMaxima);
+    crecer(qMin(capacidadInicial, capacidadMaxima));
+}
+
+/**
+@brief Destructor de la reserva.
+
+Destruye todas las explosiones creadas, estén libres o en vuelo, desconectando antes sus señales
+para que ninguna intente volver a una reserva que ya no existe. Si se omitió más de un disparo,
+avisa el total.
+*/
+PoolExplosiones::~PoolExplosiones()
+{
+    for (Explosion* e : std::as_const(todas)) {
+        e->disconnect();
+        delete e;
+    }
+    todas.clear();
+    libres.clear();
+
+    if (disparosOmitidos > 1)
+        qWarning() << "PoolExplosiones: se omitieron" << disparosOmitidos << "disparos por la capacidad máxima.";
+
+    //qDebug() << "Reserva de explosiones destruida";
+}
+
+/**
+@brief Entrega una explosión libre, creando un bloque nuevo si no queda ninguna.
+
+La explosión devuelta está oculta y detenida; quien la pide debe configurarla con
+`setTipoMovimiento()` y `setPosicionInicial()` y luego llamar a `lanzar()`. Cuando termine su
+vuelo vuelve sola a la reserva.
+
+Si se alcanzó `capacidadMaxima` el disparo se omite. Solo el primero se avisa en el registro; los
+demás se cuentan en `omitidos()` y el total se avisa al destruir la reserva, para no llenar el
+registro cuando muchos enemigos disparan a la vez (por ejemplo, en el modo estrés).
+
+@return Explosión lista para lanzarse, o nullptr si se alcanzó `capacidadMaxima`.
+*/
+Explosion* PoolExplosiones::adquirir()
+{
+    if (libres.isEmpty() && !crecer(tamBloque)) {
+        if (disparosOmitidos++ == 0)
+            qWarning() << "PoolExplosiones: capacidad máxima alcanzada (" << capacidadMaxima << "), se omiten los disparos.";
+        return nullptr;
+    }
+
+    return libres.takeLast();
+}
+
+/**
+@brief Devuelve una explosión a la reserva.
+
+Detiene sus tareas y la oculta (las explosiones ocultas no participan en las colisiones).
+Liberar dos veces la misma explosión o una que no pertenece a esta reserva no tiene efecto.
+
+@param explosion Explosión obtenida con `adquirir()`.
+*/
+void PoolExplosiones::liberar(Explosion* explosion)
+{
+    if (!explosion || libres.contains(explosion) || !todas.contains(explosion))
+        return;
+
+    explosion->recoger();
+    libres.append(explosion);
+}
+
+/**
+@brief Crea un bloque de explosiones nuevas y las agrega a la lista de libres.
+
+Cada explosión se conecta a `liberar()` mediante su señal `terminada()`, así vuelve a la
+reserva en cuanto choca o sale de la pantalla.
+
+@param cantidad Número de explosiones a crear; se recorta para no superar `capacidadMaxima`.
+@return `true` si se creó al menos una explosión.
+*/
+bool PoolExplosiones::crecer(int cantidad)
+{
+    ETIQUETA_MEMORIA(MemoriaExplosiones);
+    cantidad = qMin(cantidad, capacidadMaxima - static_cast<int>(todas.size()));
+    if (cantidad <= 0) return false;
+
+    for (int i = 0; i < cantidad; ++i) {
+        Explosion* e = new Explosion(scene, this);
+        e->recoger();
+        connect(e, &Explosion::terminada, this, [this, e]() { liberar(e); });
+        todas.append(e);
+        libres.append(e);
+    }
+
+    //qDebug() << "Reserva de explosiones ampliada a" << todas.size();
+    return true;
+}
@@ -0,0 +1,50 @@
+#ifndef POOLEXPLOSIONES_H
+#define POOLEXPLOSIONES_H
+
+#include <QObject>
+#include <QGraphicsScene>
+#include <QVector>
+
+class Explosion;
+
+/**
+ * Reserva de explosiones reutilizables de un enemigo.
+ * Las explosiones se crean por bloques y nunca se destruyen mientras el dueño vive: al terminar
+ * su vuelo vuelven a la lista de libres y el siguiente disparo las reinicia con
+ * setPosicionInicial()/setTipoMovimiento(). Así la memoria y la cantidad de items de la escena
+ * quedan fijas aunque el combate dure mucho.
+ */
+class PoolExplosiones : public QObject
+{
+    Q_OBJECT
+
+public:
+    PoolExplosiones(QGraphicsScene* scene, int capacidadInicial = 4, int tamBloque = 4,
+                    int capacidadMaxima = 32, QObject* parent = nullptr);
+    ~PoolExplosiones();
+
+    Explosion* adquirir();                 // nullptr si se llegó a la capacidad máxima
+    void liberar(Explosion* explosion);    // La oculta y la deja lista para reutilizarse
+
+    int capacidad() const { return todas.size(); }
+    int disponibles() const { return libres.size(); }
+    int enUso() const { return todas.size() - libres.size(); }
+    int omitidos() const { return disparosOmitidos; }   // Pedidos rechazados por la capacidad máxima
+
+private:
+    bool crecer(int cantidad);
+
+    QGraphicsScene* scene;
+    int tamBloque;
+    int capacidadMaxima;
+
+    QVector<Explosion*> todas;     // Dueño de todas las explosiones creadas
+    QVector<Explosion*> libres;    // Pila de explosiones sin usar
+    int disparosOmitidos = 0;      // Solo el primero se avisa al momento; el total, al destruirse
+
+    // Bloqueamos copia y asignación
+    PoolExplosiones(const PoolExplosiones&) = delete;
+    PoolExplosiones& operator=(const PoolExplosiones&) = delete;
+};
+
+#endif // POOLEXPLOSIONES_H
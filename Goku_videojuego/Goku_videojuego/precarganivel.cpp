@@ -0,0 +1,135 @@
+#include "precarganivel.h"
+#include "spritecache.h"
+#include "trazaeventos.h"
+#include "rastreomemoria.h"
+#include <QElapsedTimer>
+#include <QMutexLocker>
+#include <QThread>
+#include <QDebug>
+#include <QLoggingCategory>
+
+// Avance de cada precarga; se ve con QT_LOGGING_RULES="goku.precarga.debug=true"
+Q_LOGGING_CATEGORY(registroPrecarga, "goku.precarga", QtInfoMsg)
+
+/**
+@brief Constructor de la precarga.
+
+Descarta de entrada las hojas que `SpriteCache` ya tiene, de modo que solo se decodifica lo que
+el nivel todavía no usó.
+
+@param rutas Rutas de recursos de las hojas del nivel (por ejemplo `Nivel2::recursos()`).
+@param parent Objeto padre en la jerarquía de Qt.
+*/
+PrecargaNivel::PrecargaNivel(const QStringList& rutas, QObject* parent)
+    : QObject(parent)
+{
+    SpriteCache* cache = SpriteCache::instancia();
+    for (const QString& ruta : rutas) {
+        if (!cache->contiene(ruta) && !this->rutas.contains(ruta))
+            this->rutas.append(ruta);
+    }
+
+    // Unas 2 vueltas por frame: deja tiempo al resto del juego mientras llegan hojas
+    timerConversion.setInterval(8);
+    connect(&timerConversion, &QTimer::timeout, this, &PrecargaNivel::convertir);
+}
+
+/**
+@brief Destructor de la precarga.
+
+Si el hilo de trabajo sigue decodificando, se le pide que termine y se lo espera; como mucho
+termina la imagen que tenía entre manos.
+*/
+PrecargaNivel::~PrecargaNivel()
+{
+    cancelada = true;
+    timerConversion.stop();
+
+    if (hilo) {
+        hilo->wait();
+        delete hilo;
+        hilo = nullptr;
+    }
+}
+
+/**
+@brief Arranca el hilo de trabajo y la conversión por tramos.
+
+Si no hay nada que decodificar, la precarga queda lista de inmediato y `terminada()` se emite
+en la siguiente vuelta del bucle de eventos. Llamarlo más de una vez no tiene efecto.
+*/
+void PrecargaNivel::iniciar()
+{
+    if (hilo || lista) return;
+
+    qCDebug(registroPrecarga) << "PrecargaNivel: decodificando" << rutas.size() << "hojas en segundo plano";
+    TrazaEventos::instancia()->instante("PrecargaNivel::iniciar", "recursos");
+
+    hilo = QThread::create([this]() { decodificar(); });
+    hilo->setObjectName("precarga");
+    hilo->start(QThread::LowPriority);
+
+    timerConversion.start();
+}
+
+/**
+@brief Decodifica cada hoja a `QImage` y la deja en la cola de `decodificadas`.
+
+Corre en el hilo de trabajo, por lo que solo usa `QImage` (los `QPixmap` deben crearse en el
+hilo de la interfaz). Las hojas que no se pueden leer se encolan nulas para que la cuenta cierre.
+*/
+void PrecargaNivel::decodificar()
+{
+    for (const QString& ruta : std::as_const(rutas)) {
+        if (cancelada) return;
+
+        QImage imagen;
+        {
+            TRAZA_EVENTO("PrecargaNivel::decodificar", "recursos");
+            imagen = SpriteCache::leerImagen(ruta);
+        }
+
+        QMutexLocker bloqueo(&mutex);
+        decodificadas.append(qMakePair(ruta, imagen));
+    }
+}
+
+/**
+@brief Convierte a `QPixmap` las hojas ya decodificadas, sin pasar de `presupuestoMs`.
+
+Se ejecuta en cada vuelta del bucle de eventos mientras falten hojas. Siempre convierte al
+menos una, aunque sola supere el presupuesto. Al completar todas, detiene el temporizador y
+emite `terminada()`.
+*/
+void PrecargaNivel::convertir()
+{
+    ETIQUETA_MEMORIA(MemoriaSprites);
+    SpriteCache* cache = SpriteCache::instancia();
+
+    QElapsedTimer reloj;
+    reloj.start();
+
+    do {
+        QPair<QString, QImage> siguiente;
+        {
+            QMutexLocker bloqueo(&mutex);
+            if (decodificadas.isEmpty()) break;
+            siguiente = decodificadas.takeFirst();
+        }
+
+        if (siguiente.second.isNull()) {
+            qWarning() << "PrecargaNivel: no se pudo decodificar" << siguiente.first;
+        } else {
+            TRAZA_EVENTO("PrecargaNivel::convertir", "recursos");
+            cache->agregarHoja(siguiente.first, QPixmap::fromImage(std::move(siguiente.second)));
+        }
+        ++convertidas;
+    } while (reloj.elapsed() < presupuestoMs);
+
+    if (convertidas < rutas.size()) return;
+
+    timerConversion.stop();
+    lista = true;
+    qCDebug(registroPrecarga) << "PrecargaNivel: hojas listas en" << rutas.size() << "conversiones";
+    emit terminada();
+}
@@ -0,0 +1,57 @@
+#ifndef PRECARGANIVEL_H
+#define PRECARGANIVEL_H
+
+#include <QObject>
+#include <QImage>
+#include <QMutex>
+#include <QPair>
+#include <QStringList>
+#include <QTimer>
+#include <QVector>
+#include <atomic>
+
+class QThread;
+
+/**
+ * Precarga en segundo plano de las imágenes de un nivel.
+ * Un hilo de trabajo decodifica los PNG a QImage; el hilo de la interfaz los convierte a QPixmap
+ * de a poco (como mucho `presupuestoMs` por vuelta) y los deja en SpriteCache. Cuando el nivel
+ * se construye, todas sus hojas ya están en la caché y no hay que decodificar nada.
+ */
+class PrecargaNivel : public QObject
+{
+    Q_OBJECT
+
+public:
+    static const int presupuestoMs = 4;     // Tiempo de conversión por vuelta del hilo de la interfaz
+
+    explicit PrecargaNivel(const QStringList& rutas, QObject* parent = nullptr);
+    ~PrecargaNivel();
+
+    void iniciar();
+    bool estaLista() const { return lista; }
+
+signals:
+    void terminada();                       // Todas las hojas están en SpriteCache
+
+private:
+    void decodificar();                     // Corre en el hilo de trabajo
+    void convertir();                       // Corre en el hilo de la interfaz
+
+    QStringList rutas;                      // Solo las que la caché todavía no tiene
+    QThread* hilo = nullptr;
+    QTimer timerConversion;
+    std::atomic<bool> cancelada{false};
+
+    QMutex mutex;
+    QVector<QPair<QString, QImage>> decodificadas;   // Protegido por mutex
+
+    int convertidas = 0;
+    bool lista = false;
+
+    // Bloqueamos copia y asignación
+    PrecargaNivel(const PrecargaNivel&) = delete;
+    PrecargaNivel& operator=(const PrecargaNivel&) = delete;
+};
+
+#endif // PRECARGANIVEL_H
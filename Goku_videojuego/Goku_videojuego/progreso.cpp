@@ -1,4 +1,6 @@
 #include "progreso.h"
+#include "rastreomemoria.h"
+#include "spritecache.h"
 #include <QPainter>
 #include <QPixmap>
 #include <QDebug>
@@ -7,34 +9,32 @@
 /**
 @brief Constructor de la clase Progreso.
 
-Crea un widget gráfico que muestra una barra de progreso junto con un ícono representativo. Puede funcionar para mostrar progreso horizontal o avance en recolección de pociones.
+Crea un elemento del HUD que muestra una barra de progreso junto con un ícono representativo. Puede funcionar para mostrar progreso horizontal o avance en recolección de pociones.
 
 @param tipo Tipo de progreso que se mostrará (Horizontal o Pociones).
 @param rutaIcono Ruta del archivo de imagen que se usará como ícono del progreso.
-@param parent Puntero al widget padre.
+@param capa Capa del HUD donde se dibuja el progreso. No puede ser nula.
 
 @details
 
-Establece un tamaño fijo para el widget que contiene la barra y el ícono.
+El elemento ocupa un tamaño fijo (`tamano`) que contiene la barra y el ícono.
 
-Carga y valida la imagen del ícono, lanzando excepción si falla la carga.
+Carga y valida la imagen del ícono, lanzando excepción si falla la carga o si la capa es nula.
 
-Escala el ícono manteniendo la proporción para ajustarlo al tamaño del widget.
-
-Centra verticalmente el ícono dentro del área del widget.
+Escala el ícono una sola vez, manteniendo la proporción para ajustarlo al alto del elemento.
 */
-Progreso::Progreso(TipoProgreso tipo, const QString& rutaIcono, QWidget *parent)
-    : QWidget(parent),
+Progreso::Progreso(TipoProgreso tipo, const QString& rutaIcono, CapaHud *capa)
+    : ElementoHud(capa),
     tipo(tipo),
     porcentaje(0.0f),
     totalPociones(0),
     pocionesRecolectadas(0)
 {
-    setFixedSize(220, 25); // Tamaño fijo del widget, para contener barra e ícono
+    ETIQUETA_MEMORIA(MemoriaHud);
+    if (!capa)
+        throw std::invalid_argument("Progreso: la capa del HUD no puede ser nula.");
 
-    // Crear ícono del progreso
-    icono = new QLabel(this);
-    QPixmap pixmap(rutaIcono);
+    QPixmap pixmap = SpriteCache::instancia()->hoja(rutaIcono);
 
     // Validar que la imagen se haya cargado correctamente
     if (pixmap.isNull()) {
@@ -42,23 +42,19 @@ Progreso::Progreso(TipoProgreso tipo, const QString& rutaIcono, QWidget *parent)
     }
 
     // Redimensionar ícono con buena calidad
-    icono->setPixmap(pixmap.scaled(35, 25, Qt::KeepAspectRatio, Qt::SmoothTransformation));
+    icono = SpriteCache::instancia()->escalado(pixmap, 35, tamano.height());
 
-    // Centrar verticalmente el ícono dentro del widget
-    icono->move(0, (height() - icono->height()) / 2);
-    icono->show();
+    capa->agregar(this);
 }
 
 /**
 @brief Destructor de la clase Progreso.
 
-Libera los recursos asociados al widget.
-No requiere eliminación explícita de los objetos hijos, ya que Qt gestiona automáticamente la memoria de los widgets con padres asignados.
+No requiere acciones explícitas: la capa del HUD deja de dibujar el progreso sola cuando se destruye.
 */
 Progreso::~Progreso()
 {
     //qDebug() << "Destructor de progreso llamado";
-    // No se necesita delete explícito: QLabel tiene parent (this)
 }
 
 /**
@@ -78,7 +74,7 @@ Calcula el porcentaje como proporción normalizada dentro del rango [inicio, fin
 
 Usa qBound para asegurar que el porcentaje esté entre 0.0 y 1.0.
 
-Solicita el repintado del widget para reflejar visualmente el nuevo progreso.
+Se llama cada 50 ms, pero la imagen solo se regenera cuando el relleno cambia al menos un píxel.
 */
 void Progreso::actualizarProgreso(float posicionGoku, float inicio, float fin)
 {
@@ -86,9 +82,8 @@ void Progreso::actualizarProgreso(float posicionGoku, float inicio, float fin)
     if (tipo != Horizontal || fin == inicio)
         return;
 
-    porcentaje = (posicionGoku - inicio) / (fin - inicio);   // Calcular progreso como proporción entre 0 y 1
-    porcentaje = qBound(0.0f, porcentaje, 1.0f);             // Limitar entre 0% y 100% usando función de Qt
-    update();                                                // Solicita repintado del widget
+    float nuevo = (posicionGoku - inicio) / (fin - inicio);  // Calcular progreso como proporción entre 0 y 1
+    cambiarPorcentaje(qBound(0.0f, nuevo, 1.0f));            // Limitar entre 0% y 100% usando función de Qt
 }
 
 /**
@@ -104,7 +99,7 @@ Valida que el total sea un número positivo, lanzando una excepción si no lo es
 
 Reinicia el contador de pociones recolectadas y el porcentaje de progreso.
 
-Actualiza la visualización del widget para reflejar los cambios.
+Marca la imagen del HUD para regenerarla.
 */
 void Progreso::setTotalPociones(int total)
 {
@@ -118,7 +113,7 @@ void Progreso::setTotalPociones(int total)
         totalPociones = total;
         pocionesRecolectadas = 0;
         porcentaje = 0.0f;
-        update();
+        invalidar();
     }
 }
 
@@ -133,7 +128,7 @@ Incrementa el contador interno de pociones recolectadas siempre que no se haya a
 
 Calcula el nuevo porcentaje de progreso basado en la proporción entre pociones recolectadas y el total.
 
-Solicita la actualización visual del widget para reflejar el nuevo estado.
+Marca la imagen del HUD para regenerarla si el relleno cambió.
 */
 void Progreso::sumarPocion()
 {
@@ -142,17 +137,43 @@ void Progreso::sumarPocion()
 
         // Incrementa la cuenta y actualiza porcentaje
         ++pocionesRecolectadas;
-        porcentaje = static_cast<float>(pocionesRecolectadas) / totalPociones;
-        update();
+        cambiarPorcentaje(static_cast<float>(pocionesRecolectadas) / totalPociones);
     }
 }
 
 /**
-@brief Método de evento que dibuja la barra de progreso personalizada.
+@brief Cambia el porcentaje y, solo si cambia el ancho del relleno, marca la imagen como sucia.
 
-Se encarga de renderizar el widget, incluyendo el fondo, el relleno que representa el avance actual y el borde de la barra de progreso.
+@param nuevo Porcentaje entre 0.0 y 1.0.
+*/
+void Progreso::cambiarPorcentaje(float nuevo)
+{
+    const bool cambiaRelleno = anchoRelleno(nuevo) != anchoRelleno(porcentaje);
+    porcentaje = nuevo;
+    if (cambiaRelleno)
+        invalidar();
+}
 
-@param event Evento de pintura (no utilizado explícitamente).
+/**
+@brief Ancho en píxeles del relleno para un porcentaje dado.
+
+@param valor Porcentaje entre 0.0 y 1.0.
+@return Ancho redondeado del relleno dentro de la barra.
+*/
+int Progreso::anchoRelleno(float valor) const
+{
+    const int margen = 5;
+    const int anchoBarra = tamano.width() - icono.width() - margen;
+    return qRound(anchoBarra * valor);
+}
+
+/**
+@brief Genera la imagen de la barra de progreso personalizada.
+
+Se encarga de dibujar el ícono, el fondo, el relleno que representa el avance actual y el borde de la barra de progreso.
+Solo se llama cuando el relleno cambió; el resto de los frames se reutiliza la imagen guardada.
+
+@return Imagen lista para copiar a la vista.
 
 @details
 
@@ -166,20 +187,24 @@ Dibuja un rectángulo redondeado azul que representa el porcentaje de progreso a
 
 Dibuja el borde negro alrededor de la barra para definir visualmente su contorno.
 */
-void Progreso::paintEvent(QPaintEvent *event)
+QPixmap Progreso::renderizar() const
 {
-    Q_UNUSED(event); // No se utiliza el evento
+    QPixmap imagen(tamano);
+    imagen.fill(Qt::transparent);
 
-    QPainter painter(this);
+    QPainter painter(&imagen);
     painter.setRenderHint(QPainter::Antialiasing, true); // Borde suave
 
+    // Ícono centrado verticalmente a la izquierda
+    painter.drawPixmap(0, (tamano.height() - icono.height()) / 2, icono);
+
     // Margen entre ícono y barra
     int margen = 5;
-    int xInicioBarra = icono->width() + margen;
+    int xInicioBarra = icono.width() + margen;
 
     // Cálculo del tamaño de la barra
-    int anchoBarra = width() - xInicioBarra;
-    int altoBarra = height();
+    int anchoBarra = tamano.width() - xInicioBarra;
+    int altoBarra = tamano.height();
 
     // Dibujo del fondo de la barra
     painter.setBrush(Qt::lightGray);
@@ -189,12 +214,14 @@ void Progreso::paintEvent(QPaintEvent *event)
     // Dibujo del relleno (avance) de la barra
     QColor colorRelleno = Qt::blue;
     painter.setBrush(colorRelleno);
-    painter.drawRoundedRect(xInicioBarra, 2, anchoBarra * porcentaje, altoBarra - 4, 5, 5);
+    painter.drawRoundedRect(xInicioBarra, 2, anchoRelleno(porcentaje), altoBarra - 4, 5, 5);
 
     // Dibujo del borde final
     painter.setPen(QPen(Qt::black, 1));
     painter.setBrush(Qt::NoBrush);
     painter.drawRoundedRect(xInicioBarra, 2, anchoBarra, altoBarra - 4, 5, 5);
+
+    return imagen;
 }
 
 /**
@@ -1,20 +1,21 @@
 #ifndef PROGRESO_H
 #define PROGRESO_H
 
-#include <QWidget>
-#include <QLabel>
+#include <QPixmap>
+#include <QSize>
+#include "capahud.h"
 
 enum TipoProgreso {
     Horizontal,
     Pociones
 };
 
-class Progreso : public QWidget
+class Progreso : public ElementoHud
 {
     Q_OBJECT
 
 public:
-    Progreso(TipoProgreso tipo, const QString& rutaIcono, QWidget *parent = nullptr);
+    Progreso(TipoProgreso tipo, const QString& rutaIcono, CapaHud *capa);
     ~Progreso();
 
     void actualizarProgreso(float posicionGoku, float inicio, float fin);
@@ -23,12 +24,16 @@ public:
     float getPorcentaje() const;
 
 protected:
-    void paintEvent(QPaintEvent *event) override;
+    QPixmap renderizar() const override;   // Ícono y barra
 
 private:
+    void cambiarPorcentaje(float nuevo);   // Invalida solo si cambia algún píxel del relleno
+    int anchoRelleno(float valor) const;
+
     TipoProgreso tipo;
     float porcentaje;
-    QLabel *icono;
+    QPixmap icono;
+    const QSize tamano{220, 25};           // Ícono y barra juntos
     int totalPociones;
     int pocionesRecolectadas;
 };
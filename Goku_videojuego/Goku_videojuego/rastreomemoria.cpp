@@ -0,0 +1,351 @@
+#include "rastreomemoria.h"
+#include <QStringList>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Todo el estado es de almacenamiento estático inicializado en cero: los operadores new/delete
+// se usan desde antes de main() y no pueden depender de constructores dinámicos.
+
+namespace {
+
+// Cabecera delante de cada bloque; 16 bytes conservan la alineación que garantiza malloc
+struct alignas(16) Cabecera {
+    std::size_t tamano;
+    quint32 etiqueta;
+    quint32 ranura;
+};
+
+// Contadores de un hilo, en su propia línea de caché para no compartirla con otros hilos
+struct alignas(64) ContadoresHilo {
+    std::atomic<qint64> reservas;
+    std::atomic<qint64> liberaciones;
+    std::atomic<qint64> bytesReservados;
+    std::atomic<qint64> bytesVivos;          // Netos: lo que reservó menos lo que liberó este hilo
+    std::atomic<qint64> pico;
+    std::atomic<qint64> histograma[RastreoMemoria::numCubetas];
+};
+
+struct ContadoresEtiqueta {
+    std::atomic<qint64> reservas;
+    std::atomic<qint64> bytesReservados;
+    std::atomic<qint64> bytesVivos;
+    std::atomic<qint64> pico;
+};
+
+ContadoresHilo hilos[RastreoMemoria::maxHilos];
+ContadoresEtiqueta etiquetas[NumEtiquetasMemoria];
+std::atomic<int> ranurasUsadas;
+std::atomic<qint64> vivosTotales;
+std::atomic<qint64> picoTotal;
+
+thread_local int ranuraHilo = -1;
+thread_local int etiquetaHilo = MemoriaGeneral;
+
+// Estado del periodo y de los frames (solo desde el hilo principal)
+qint64 reservasInicioPeriodo[RastreoMemoria::maxHilos];
+qint64 bytesInicioPeriodo[RastreoMemoria::maxHilos];
+qint64 histogramaInicioPeriodo[RastreoMemoria::numCubetas];
+qint64 reservasEtiquetaInicio[NumEtiquetasMemoria];
+qint64 bytesEtiquetaInicio[NumEtiquetasMemoria];
+qint64 reservasFrameAnterior = -1;
+qint64 reservasUltimoFrame = 0;
+qint64 reservasMaxFrame = 0;
+qint64 framesPeriodo = 0;
+qint64 reservasFramesPeriodo = 0;
+
+void actualizarPico(std::atomic<qint64>& pico, qint64 valor)
+{
+    qint64 actual = pico.load(std::memory_order_relaxed);
+    while (valor > actual && !pico.compare_exchange_weak(actual, valor, std::memory_order_relaxed)) {}
+}
+
+int ranuraActual()
+{
+    if (ranuraHilo < 0)
+        ranuraHilo = qMin(ranurasUsadas.fetch_add(1, std::memory_order_relaxed), RastreoMemoria::maxHilos - 1);
+    return ranuraHilo;
+}
+
+int cubeta(std::size_t tamano)
+{
+    int indice = 0;
+    std::size_t limite = 16;
+    while (tamano > limite && indice < RastreoMemoria::numCubetas - 1) {
+        limite <<= 1;
+        ++indice;
+    }
+    return indice;
+}
+
+qint64 totalReservas()
+{
+    qint64 total = 0;
+    const int usadas = qMin(ranurasUsadas.load(std::memory_order_relaxed), RastreoMemoria::maxHilos);
+    for (int i = 0; i < usadas; ++i)
+        total += hilos[i].reservas.load(std::memory_order_relaxed);
+    return total;
+}
+
+QString kb(qint64 bytes)
+{
+    return QString::number(bytes / 1024.0, 'f', 1) + " KB";
+}
+
+} // namespace
+
+/**
+@brief Reserva un bloque con cabecera y lo anota en los contadores del hilo y de la etiqueta.
+
+@param tamano Bytes pedidos.
+@return Puntero al bloque utilizable, o `nullptr` si `malloc` falla.
+*/
+void* RastreoMemoria::asignar(std::size_t tamano)
+{
+    Cabecera* cabecera = static_cast<Cabecera*>(std::malloc(sizeof(Cabecera) + tamano));
+    if (!cabecera) return nullptr;
+
+    const int ranura = ranuraActual();
+    cabecera->tamano = tamano;
+    cabecera->etiqueta = static_cast<quint32>(etiquetaHilo);
+    cabecera->ranura = static_cast<quint32>(ranura);
+
+    const qint64 bytes = static_cast<qint64>(tamano);
+    ContadoresHilo& hilo = hilos[ranura];
+    hilo.reservas.fetch_add(1, std::memory_order_relaxed);
+    hilo.bytesReservados.fetch_add(bytes, std::memory_order_relaxed);
+    hilo.histograma[cubeta(tamano)].fetch_add(1, std::memory_order_relaxed);
+    actualizarPico(hilo.pico, hilo.bytesVivos.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+
+    ContadoresEtiqueta& etiqueta = etiquetas[etiquetaHilo];
+    etiqueta.reservas.fetch_add(1, std::memory_order_relaxed);
+    etiqueta.bytesReservados.fetch_add(bytes, std::memory_order_relaxed);
+    actualizarPico(etiqueta.pico, etiqueta.bytesVivos.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+
+    actualizarPico(picoTotal, vivosTotales.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+
+    return cabecera + 1;
+}
+
+/**
+@brief Libera un bloque reservado con `asignar`, descontándolo de la etiqueta con la que se reservó.
+
+Los bytes vivos se descuentan del hilo que libera, así que un hilo que libera memoria de otro
+puede quedar con un saldo negativo; la suma de todos los hilos es la correcta.
+
+@param bloque Puntero devuelto por `asignar`, o `nullptr`.
+*/
+void RastreoMemoria::liberar(void* bloque)
+{
+    if (!bloque) return;
+
+    Cabecera* cabecera = static_cast<Cabecera*>(bloque) - 1;
+    const qint64 bytes = static_cast<qint64>(cabecera->tamano);
+
+    ContadoresHilo& hilo = hilos[ranuraActual()];
+    hilo.liberaciones.fetch_add(1, std::memory_order_relaxed);
+    hilo.bytesVivos.fetch_sub(bytes, std::memory_order_relaxed);
+
+    etiquetas[cabecera->etiqueta].bytesVivos.fetch_sub(bytes, std::memory_order_relaxed);
+    vivosTotales.fetch_sub(bytes, std::memory_order_relaxed);
+
+    std::free(cabecera);
+}
+
+/**
+@brief Cambia la etiqueta a la que se cargan las reservas del hilo actual.
+
+@param etiqueta Nueva etiqueta.
+@return La etiqueta que estaba activa.
+*/
+EtiquetaMemoria RastreoMemoria::cambiarEtiqueta(EtiquetaMemoria etiqueta)
+{
+    const EtiquetaMemoria anterior = static_cast<EtiquetaMemoria>(etiquetaHilo);
+    etiquetaHilo = etiqueta;
+    return anterior;
+}
+
+/**
+@brief Empieza un periodo de medición nuevo (normalmente, un nivel).
+
+Guarda los contadores actuales como referencia, reinicia los picos al valor vivo de ahora y
+reinicia las estadísticas por frame.
+*/
+void RastreoMemoria::iniciarPeriodo()
+{
+    for (int i = 0; i < maxHilos; ++i) {
+        reservasInicioPeriodo[i] = hilos[i].reservas.load(std::memory_order_relaxed);
+        bytesInicioPeriodo[i] = hilos[i].bytesReservados.load(std::memory_order_relaxed);
+        hilos[i].pico.store(hilos[i].bytesVivos.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    for (int c = 0; c < numCubetas; ++c) {
+        histogramaInicioPeriodo[c] = 0;
+        for (int i = 0; i < maxHilos; ++i)
+            histogramaInicioPeriodo[c] += hilos[i].histograma[c].load(std::memory_order_relaxed);
+    }
+
+    for (int e = 0; e < NumEtiquetasMemoria; ++e) {
+        reservasEtiquetaInicio[e] = etiquetas[e].reservas.load(std::memory_order_relaxed);
+        bytesEtiquetaInicio[e] = etiquetas[e].bytesReservados.load(std::memory_order_relaxed);
+        etiquetas[e].pico.store(etiquetas[e].bytesVivos.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    picoTotal.store(vivosTotales.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    reservasFrameAnterior = -1;
+    reservasUltimoFrame = 0;
+    reservasMaxFrame = 0;
+    framesPeriodo = 0;
+    reservasFramesPeriodo = 0;
+}
+
+/**
+@brief Cierra un frame: cuenta las reservas hechas (en todos los hilos) desde el frame anterior.
+*/
+void RastreoMemoria::cerrarFrame()
+{
+    const qint64 total = totalReservas();
+    if (reservasFrameAnterior >= 0) {
+        reservasUltimoFrame = total - reservasFrameAnterior;
+        reservasMaxFrame = qMax(reservasMaxFrame, reservasUltimoFrame);
+        reservasFramesPeriodo += reservasUltimoFrame;
+        ++framesPeriodo;
+    }
+    reservasFrameAnterior = total;
+}
+
+/**
+@brief Bytes reservados y todavía no liberados, sumando todos los hilos.
+*/
+qint64 RastreoMemoria::bytesVivos()
+{
+    return vivosTotales.load(std::memory_order_relaxed);
+}
+
+/**
+@brief Reservas hechas durante el último frame cerrado.
+*/
+qint64 RastreoMemoria::ultimoFrame()
+{
+    return reservasUltimoFrame;
+}
+
+/**
+@brief Mayor cantidad de reservas en un frame desde que empezó el periodo.
+*/
+qint64 RastreoMemoria::maximoPorFrame()
+{
+    return reservasMaxFrame;
+}
+
+/**
+@brief Nombre legible de una etiqueta.
+*/
+const char* RastreoMemoria::nombreEtiqueta(EtiquetaMemoria etiqueta)
+{
+    switch (etiqueta) {
+    case MemoriaNivel:       return "nivel";
+    case MemoriaSprites:     return "sprites";
+    case MemoriaHud:         return "hud";
+    case MemoriaExplosiones: return "explosiones";
+    default:                 return "general";
+    }
+}
+
+/**
+@brief Arma un informe del periodo actual.
+
+Incluye los bytes vivos y el pico, las reservas del periodo y por frame, el desglose por
+etiqueta y por hilo, y el histograma de tamaños de las reservas del periodo.
+
+@param titulo Encabezado del informe (por ejemplo, el nivel que terminó).
+@return Texto de varias líneas.
+*/
+QString RastreoMemoria::informe(const QString& titulo)
+{
+    QStringList lineas;
+    lineas << QString("== Memoria: %1 ==").arg(titulo);
+    lineas << QString("vivos %1, pico del periodo %2")
+                  .arg(kb(bytesVivos()), kb(picoTotal.load(std::memory_order_relaxed)));
+
+    qint64 reservasPeriodo = totalReservas();
+    for (int i = 0; i < maxHilos; ++i)
+        reservasPeriodo -= reservasInicioPeriodo[i];
+
+    lineas << QString("reservas del periodo %1; por frame: promedio %2, máximo %3 (%4 frames)")
+                  .arg(reservasPeriodo)
+                  .arg(framesPeriodo > 0 ? double(reservasFramesPeriodo) / framesPeriodo : 0.0, 0, 'f', 1)
+                  .arg(reservasMaxFrame)
+                  .arg(framesPeriodo);
+
+    lineas << "por etiqueta:";
+    for (int e = 0; e < NumEtiquetasMemoria; ++e) {
+        const ContadoresEtiqueta& c = etiquetas[e];
+        lineas << QString("  %1 reservas %2, reservado %3, vivos %4, pico %5")
+                      .arg(QString::fromLatin1(nombreEtiqueta(static_cast<EtiquetaMemoria>(e))), -12)
+                      .arg(c.reservas.load(std::memory_order_relaxed) - reservasEtiquetaInicio[e], 8)
+                      .arg(kb(c.bytesReservados.load(std::memory_order_relaxed) - bytesEtiquetaInicio[e]))
+                      .arg(kb(c.bytesVivos.load(std::memory_order_relaxed)))
+                      .arg(kb(c.pico.load(std::memory_order_relaxed)));
+    }
+
+    lineas << "por hilo (vivos netos: reservado menos liberado por el hilo):";
+    const int usadas = qMin(ranurasUsadas.load(std::memory_order_relaxed), maxHilos);
+    for (int i = 0; i < usadas; ++i) {
+        const ContadoresHilo& h = hilos[i];
+        const qint64 reservas = h.reservas.load(std::memory_order_relaxed) - reservasInicioPeriodo[i];
+        if (reservas == 0) continue;
+        lineas << QString("  hilo %1 reservas %2, reservado %3, vivos %4, pico %5")
+                      .arg(i, 2)
+                      .arg(reservas, 8)
+                      .arg(kb(h.bytesReservados.load(std::memory_order_relaxed) - bytesInicioPeriodo[i]))
+                      .arg(kb(h.bytesVivos.load(std::memory_order_relaxed)))
+                      .arg(kb(h.pico.load(std::memory_order_relaxed)));
+    }
+
+    lineas << "tamaños:";
+    std::size_t limite = 16;
+    for (int c = 0; c < numCubetas; ++c, limite <<= 1) {
+        qint64 cantidad = -histogramaInicioPeriodo[c];
+        for (int i = 0; i < maxHilos; ++i)
+            cantidad += hilos[i].histograma[c].load(std::memory_order_relaxed);
+        if (cantidad == 0) continue;
+
+        const QString rango = c == numCubetas - 1 ? QString("> %1 B").arg(limite / 2)
+                                                  : QString("<= %1 B").arg(limite);
+        lineas << QString("  %1 %2").arg(rango, -12).arg(cantidad);
+    }
+
+    return lineas.join('\n');
+}
+
+// Reemplazo de los operadores globales: todas las reservas del programa pasan por el rastreo
+
+void* operator new(std::size_t tamano)
+{
+    if (void* bloque = RastreoMemoria::asignar(tamano)) return bloque;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t tamano)
+{
+    if (void* bloque = RastreoMemoria::asignar(tamano)) return bloque;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t tamano, const std::nothrow_t&) noexcept
+{
+    return RastreoMemoria::asignar(tamano);
+}
+
+void* operator new[](std::size_t tamano, const std::nothrow_t&) noexcept
+{
+    return RastreoMemoria::asignar(tamano);
+}
+
+void operator delete(void* bloque) noexcept { RastreoMemoria::liberar(bloque); }
+void operator delete[](void* bloque) noexcept { RastreoMemoria::liberar(bloque); }
+void operator delete(void* bloque, std::size_t) noexcept { RastreoMemoria::liberar(bloque); }
+void operator delete[](void* bloque, std::size_t) noexcept { RastreoMemoria::liberar(bloque); }
+void operator delete(void* bloque, const std::nothrow_t&) noexcept { RastreoMemoria::liberar(bloque); }
+void operator delete[](void* bloque, const std::nothrow_t&) noexcept { RastreoMemoria::liberar(bloque); }
@@ -0,0 +1,74 @@
+#ifndef RASTREOMEMORIA_H
+#define RASTREOMEMORIA_H
+
+#include <QString>
+#include <QtGlobal>
+#include <cstddef>
+
+// Subsistema al que se cargan las reservas de memoria del hilo actual
+enum EtiquetaMemoria {
+    MemoriaGeneral,
+    MemoriaNivel,
+    MemoriaSprites,
+    MemoriaHud,
+    MemoriaExplosiones,
+    NumEtiquetasMemoria
+};
+
+/**
+ * Instrumentación de la memoria dinámica del juego.
+ * Reemplaza los operadores globales new/delete: cada bloque lleva una cabecera con su tamaño
+ * y su etiqueta, y cada hilo acumula en su propia ranura contadores atómicos (reservas,
+ * liberaciones, bytes vivos, pico e histograma de tamaños). Las reservas se cargan a la
+ * etiqueta activa en el hilo (ETIQUETA_MEMORIA), así se ve qué subsistema reserva.
+ *
+ * Los contadores del "periodo" se reinician al empezar cada nivel; el informe muestra lo
+ * ocurrido desde entonces y las reservas por frame del BucleJuego.
+ */
+class RastreoMemoria
+{
+public:
+    static constexpr int maxHilos = 64;      // Los hilos que sobran comparten la última ranura
+    static constexpr int numCubetas = 16;    // <=16 B, <=32 B, ... <=256 KB, más grandes
+
+    static void* asignar(std::size_t tamano);   // nullptr si no hay memoria
+    static void liberar(void* bloque);
+
+    static EtiquetaMemoria cambiarEtiqueta(EtiquetaMemoria etiqueta);   // Devuelve la anterior
+
+    static void iniciarPeriodo();            // Al empezar un nivel
+    static void cerrarFrame();               // Al terminar cada frame del bucle
+
+    static qint64 bytesVivos();
+    static qint64 ultimoFrame();             // Reservas hechas en el último frame
+    static qint64 maximoPorFrame();          // En el periodo
+    static QString informe(const QString& titulo);
+
+    static const char* nombreEtiqueta(EtiquetaMemoria etiqueta);
+
+private:
+    RastreoMemoria() = delete;
+};
+
+/**
+ * Cambia la etiqueta de memoria del hilo durante el resto del bloque y la restaura al salir.
+ * No se usa directamente sino a través de ETIQUETA_MEMORIA.
+ */
+class AmbitoMemoria
+{
+public:
+    explicit AmbitoMemoria(EtiquetaMemoria etiqueta) : anterior(RastreoMemoria::cambiarEtiqueta(etiqueta)) {}
+    ~AmbitoMemoria() { RastreoMemoria::cambiarEtiqueta(anterior); }
+
+private:
+    EtiquetaMemoria anterior;
+};
+
+#define ETIQUETA_MEMORIA_UNIR_(a, b) a##b
+#define ETIQUETA_MEMORIA_UNIR(a, b) ETIQUETA_MEMORIA_UNIR_(a, b)
+
+// Carga a `etiqueta` las reservas del hilo hasta el final del bloque actual
+#define ETIQUETA_MEMORIA(etiqueta) \
+    AmbitoMemoria ETIQUETA_MEMORIA_UNIR(ambitoMemoria_, __LINE__)(etiqueta)
+
+#endif // RASTREOMEMORIA_H
@@ -0,0 +1,177 @@
+#include "registroentradas.h"
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+#include <QDebug>
+#include <cstring>
+#include <stdexcept>  // Excepciones estándar
+
+Q_LOGGING_CATEGORY(registroEntradas, "goku.entradas", QtInfoMsg)
+
+// Firma al inicio de cada grabación
+static const char firma[4] = {'G', 'K', 'R', 'P'};
+
+// Teclas grabadas, en el orden de sus bits
+static const int teclas[RegistroEntradas::NumTeclas] = {Qt::Key_W, Qt::Key_A, Qt::Key_S, Qt::Key_D};
+
+/**
+@brief Indica qué bit del estado corresponde a una tecla.
+
+@param tecla Código de tecla de Qt.
+@return Índice del bit (0 a `NumTeclas - 1`), o -1 si la tecla no se graba.
+*/
+int RegistroEntradas::bitTecla(int tecla)
+{
+    for (int i = 0; i < NumTeclas; ++i) {
+        if (teclas[i] == tecla) return i;
+    }
+    return -1;
+}
+
+/**
+@brief Devuelve la tecla de Qt asociada a un bit del estado.
+
+@param bit Índice del bit (0 a `NumTeclas - 1`).
+@return Código de tecla de Qt.
+*/
+int RegistroEntradas::teclaBit(int bit)
+{
+    return teclas[bit];
+}
+
+/**
+@brief Abre un bloque nuevo al comenzar un nivel.
+
+@param nivel Número del nivel.
+@param semilla Semilla con la que se sembró `AzarJuego` antes de construir el nivel.
+@param sostenidas Teclas que ya estaban apretadas al empezar (bits 0-3).
+@return Índice del bloque creado.
+*/
+int RegistroEntradas::agregarBloque(int nivel, quint32 semilla, quint8 sostenidas)
+{
+    BloqueNivel bloque;
+    bloque.nivel = nivel;
+    bloque.semilla = semilla;
+    bloque.sostenidasIniciales = sostenidas;
+    bloques.push_back(bloque);
+    return bloques.size() - 1;
+}
+
+/**
+@brief Escribe la grabación en disco.
+
+El archivo se reemplaza de forma atómica, así que una grabación anterior no queda a medias si
+el guardado falla.
+
+@param ruta Ruta del archivo de salida.
+
+@throw std::runtime_error Si el archivo no se puede escribir.
+*/
+void RegistroEntradas::guardar(const QString& ruta) const
+{
+    QSaveFile archivo(ruta);
+    if (!archivo.open(QIODevice::WriteOnly))
+        throw std::runtime_error(("RegistroEntradas: no se pudo abrir " + ruta).toStdString());
+
+    QDataStream salida(&archivo);
+    salida.setVersion(QDataStream::Qt_6_0);
+    salida.writeRawData(firma, sizeof(firma));
+    salida << version << static_cast<quint16>(bloques.size());
+
+    for (const BloqueNivel& bloque : bloques) {
+        salida << static_cast<quint8>(bloque.nivel) << bloque.semilla << bloque.sostenidasIniciales
+               << static_cast<quint32>(bloque.cambios.size());
+        for (const CambioTeclas& cambio : bloque.cambios)
+            salida << cambio.paso << cambio.estado;
+    }
+
+    if (salida.status() != QDataStream::Ok || !archivo.commit())
+        throw std::runtime_error(("RegistroEntradas: no se pudo escribir " + ruta).toStdString());
+}
+
+/**
+@brief Lee una grabación desde disco.
+
+@param ruta Ruta del archivo.
+@return Registro con todos los bloques de la grabación.
+
+@throw std::runtime_error Si el archivo no existe, no es una grabación o está truncado.
+*/
+RegistroEntradas RegistroEntradas::cargar(const QString& ruta)
+{
+    QFile archivo(ruta);
+    if (!archivo.open(QIODevice::ReadOnly))
+        throw std::runtime_error(("RegistroEntradas: no se pudo abrir " + ruta).toStdString());
+
+    QDataStream entrada(&archivo);
+    entrada.setVersion(QDataStream::Qt_6_0);
+
+    char leida[sizeof(firma)] = {};
+    quint16 versionArchivo = 0, cantidad = 0;
+    entrada.readRawData(leida, sizeof(leida));
+    entrada >> versionArchivo >> cantidad;
+
+    if (memcmp(leida, firma, sizeof(firma)) != 0 || versionArchivo != version) {
+        qCritical() << "RegistroEntradas:" << ruta << "no es una grabación compatible";
+        throw std::runtime_error("RegistroEntradas: formato de grabación no reconocido.");
+    }
+
+    RegistroEntradas registro;
+    for (quint16 i = 0; i < cantidad; ++i) {
+        quint8 nivel = 0;
+        quint32 numCambios = 0;
+        BloqueNivel bloque;
+        entrada >> nivel >> bloque.semilla >> bloque.sostenidasIniciales >> numCambios;
+        bloque.nivel = nivel;
+
+        // Cada cambio ocupa 5 bytes: evita reservar memoria por un tamaño corrupto
+        if (entrada.status() != QDataStream::Ok || numCambios > archivo.bytesAvailable() / 5)
+            break;
+
+        bloque.cambios.resize(numCambios);
+        for (CambioTeclas& cambio : bloque.cambios)
+            entrada >> cambio.paso >> cambio.estado;
+
+        registro.bloques.push_back(bloque);
+    }
+
+    if (entrada.status() != QDataStream::Ok || registro.bloques.size() != cantidad)
+        throw std::runtime_error(("RegistroEntradas: grabación truncada " + ruta).toStdString());
+
+    return registro;
+}
+
+/**
+@brief Traduce los cambios de un bloque a la secuencia de teclas que recibió Goku.
+
+En cada paso con cambios, primero se repiten las pulsaciones y después se sueltan las teclas que
+quedaron libres (estaban apretadas antes o se pulsaron y soltaron dentro del mismo paso).
+
+@param bloque Bloque de un nivel.
+@return Eventos ordenados por paso, listos para `Goku::enviarTecla`.
+*/
+QVector<EventoTecla> RegistroEntradas::eventos(const BloqueNivel& bloque)
+{
+    QVector<EventoTecla> resultado;
+    quint8 anteriores = bloque.sostenidasIniciales & 0x0F;
+
+    for (const CambioTeclas& cambio : bloque.cambios) {
+        const quint8 sostenidas = cambio.estado & 0x0F;
+        const quint8 pulsadas = cambio.estado >> 4;
+
+        for (int i = 0; i < NumTeclas; ++i) {
+            const quint8 bit = 1u << i;
+            if (pulsadas & bit)
+                resultado.push_back({cambio.paso, teclas[i], true});
+        }
+        for (int i = 0; i < NumTeclas; ++i) {
+            const quint8 bit = 1u << i;
+            if (!(sostenidas & bit) && ((anteriores | pulsadas) & bit))
+                resultado.push_back({cambio.paso, teclas[i], false});
+        }
+
+        anteriores = sostenidas;
+    }
+
+    return resultado;
+}
@@ -0,0 +1,67 @@
+#ifndef REGISTROENTRADAS_H
+#define REGISTROENTRADAS_H
+
+#include <QLoggingCategory>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+// Mensajes de la grabación y la repetición; se ven con QT_LOGGING_RULES="goku.entradas.debug=true"
+Q_DECLARE_LOGGING_CATEGORY(registroEntradas)
+
+// Una tecla pulsada o soltada en un paso concreto del nivel
+struct EventoTecla {
+    qint64 paso = 0;
+    int tecla = 0;
+    bool presionada = true;
+};
+
+// Estado del teclado en un paso donde hubo cambios.
+// Bits 0-3: teclas sostenidas después de los eventos del paso. Bits 4-7: teclas que recibieron una pulsación
+// (incluidas las repeticiones automáticas, que Goku2 usa para volver a saltar).
+struct CambioTeclas {
+    quint32 paso = 0;
+    quint8 estado = 0;
+};
+
+// Entradas de un nivel jugado, relativas al paso en que empezó
+struct BloqueNivel {
+    int nivel = 0;
+    quint32 semilla = 0;                 // Semilla de AzarJuego con la que se generó el nivel
+    quint8 sostenidasIniciales = 0;      // Teclas que ya estaban apretadas al empezar
+    QVector<CambioTeclas> cambios;       // Ordenados por paso, uno por paso como máximo
+};
+
+/**
+ * Grabación binaria de una partida: por cada nivel jugado, su semilla y los cambios del teclado
+ * paso a paso. Solo se guardan los pasos donde algo cambió (5 bytes cada uno), así que una
+ * partida completa ocupa unos pocos KB.
+ *
+ * Formato: "GKRP", versión (quint16), cantidad de bloques (quint16) y por bloque
+ * nivel (quint8), semilla (quint32), sostenidas iniciales (quint8), cantidad de cambios (quint32)
+ * y los cambios como pares paso (quint32) + estado (quint8).
+ */
+class RegistroEntradas
+{
+public:
+    static const int NumTeclas = 4;          // W, A, S, D
+    static const quint16 version = 1;
+
+    static int bitTecla(int tecla);          // Índice de la tecla en el estado, -1 si no se graba
+    static int teclaBit(int bit);
+
+    int agregarBloque(int nivel, quint32 semilla, quint8 sostenidas);   // Devuelve su índice
+    BloqueNivel& getBloque(int indice) { return bloques[indice]; }
+    const QVector<BloqueNivel>& getBloques() const { return bloques; }
+
+    void guardar(const QString& ruta) const;
+    static RegistroEntradas cargar(const QString& ruta);
+
+    // Convierte los cambios de un bloque en pulsaciones y liberaciones para Goku::enviarTecla
+    static QVector<EventoTecla> eventos(const BloqueNivel& bloque);
+
+private:
+    QVector<BloqueNivel> bloques;
+};
+
+#endif // REGISTROENTRADAS_H
@@ -0,0 +1,118 @@
+#include "reproductorentradas.h"
+#include "goku.h"
+#include <QKeyEvent>
+#include <QDebug>
+#include <stdexcept>  // Excepciones estándar
+
+/**
+@brief Constructor del reproductor. Carga la grabación completa.
+
+@param ruta Archivo escrito por `GrabadorEntradas`.
+@param parent Objeto padre en la jerarquía de Qt.
+
+@throw std::runtime_error Si la grabación no se puede leer.
+*/
+ReproductorEntradas::ReproductorEntradas(const QString& ruta, QObject* parent)
+    : QObject(parent),
+    registro(RegistroEntradas::cargar(ruta)),
+    tarea(nullptr)
+{
+    // Primera fase del paso: Goku recibe las teclas antes de moverse, como con el teclado real
+    tarea = new TareaBucle(BucleJuego::FaseEntrada, [this]() { avanzar(); }, this, "avanzar");
+
+    qCDebug(registroEntradas) << "Repitiendo" << registro.getBloques().size() << "niveles desde" << ruta;
+}
+
+/**
+@brief Toma el siguiente bloque de la grabación para el nivel que se va a construir.
+
+@param numero Nivel que el juego está por construir.
+@param semilla Recibe la semilla grabada si el bloque corresponde a ese nivel.
+@return `true` si hay un bloque para el nivel; `false` si la grabación terminó o no coincide.
+*/
+bool ReproductorEntradas::prepararNivel(int numero, quint32& semilla)
+{
+    detener();
+
+    const QVector<BloqueNivel>& bloques = registro.getBloques();
+    if (siguienteBloque >= bloques.size())
+        return false;
+
+    const BloqueNivel& bloque = bloques[siguienteBloque];
+    if (bloque.nivel != numero) {
+        qWarning() << "La grabación sigue con el nivel" << bloque.nivel << "pero se cargó el nivel" << numero
+                   << "; se deja de repetir";
+        siguienteBloque = bloques.size();
+        return false;
+    }
+
+    ++siguienteBloque;
+    semilla = bloque.semilla;
+    eventos = RegistroEntradas::eventos(bloque);
+    siguienteEvento = 0;
+    activo = true;
+    return true;
+}
+
+/**
+@brief Empieza a entregar las teclas del bloque preparado.
+
+Debe llamarse entre dos pasos del bucle, justo después de iniciar el nivel, igual que
+`GrabadorEntradas::iniciarNivel`.
+
+@param goku Goku del nivel recién iniciado.
+*/
+void ReproductorEntradas::iniciarNivel(Goku* goku)
+{
+    if (!activo) return;
+
+    this->goku = goku;
+    pasoInicial = BucleJuego::instancia()->getPasosTotales();
+    tarea->iniciar(BucleJuego::pasoMs);
+}
+
+/**
+@brief Deja de repetir el nivel en curso; el teclado real vuelve a llegar a Goku.
+*/
+void ReproductorEntradas::detener()
+{
+    activo = false;
+    goku = nullptr;
+    if (tarea && tarea->estaActiva())
+        tarea->detener();
+}
+
+/**
+@brief Envía a Goku las teclas grabadas para el paso que está empezando.
+*/
+void ReproductorEntradas::avanzar()
+{
+    const qint64 paso = BucleJuego::instancia()->getPasosTotales() - pasoInicial;
+
+    while (siguienteEvento < eventos.size() && eventos[siguienteEvento].paso <= paso) {
+        const EventoTecla& evento = eventos[siguienteEvento++];
+        if (goku)
+            goku->enviarTecla(evento.tecla, evento.presionada);
+    }
+
+    // Fin del bloque: no hay más teclas, pero el teclado real sigue bloqueado hasta el próximo nivel
+    if (siguienteEvento >= eventos.size())
+        tarea->detener();
+}
+
+/**
+@brief Descarta las teclas grabables del teclado real mientras se repite un nivel.
+
+@param objeto Objeto que recibe el evento (la vista).
+@param evento Evento recibido.
+@return `true` si el evento se descartó.
+*/
+bool ReproductorEntradas::eventFilter(QObject* objeto, QEvent* evento)
+{
+    if (activo && (evento->type() == QEvent::KeyPress || evento->type() == QEvent::KeyRelease)) {
+        if (RegistroEntradas::bitTecla(static_cast<QKeyEvent*>(evento)->key()) >= 0)
+            return true;
+    }
+
+    return QObject::eventFilter(objeto, evento);
+}
@@ -0,0 +1,52 @@
+#ifndef REPRODUCTORENTRADAS_H
+#define REPRODUCTORENTRADAS_H
+
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QVector>
+#include "buclejuego.h"
+#include "registroentradas.h"
+
+class Goku;
+
+/**
+ * Repite una partida grabada por GrabadorEntradas.
+ * Antes de construir cada nivel entrega la semilla grabada y, durante el nivel, una tarea en
+ * la fase de entrada del bucle envía a Goku las mismas teclas en los mismos pasos. Mientras
+ * repite un nivel, el teclado real no llega a Goku. Al acabarse la grabación el juego sigue normalmente.
+ */
+class ReproductorEntradas : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ReproductorEntradas(const QString& ruta, QObject* parent = nullptr);
+
+    bool prepararNivel(int numero, quint32& semilla);   // false si la grabación no tiene ese nivel
+    void iniciarNivel(Goku* goku);
+    void detener();
+    bool estaActivo() const { return activo; }
+
+protected:
+    bool eventFilter(QObject* objeto, QEvent* evento) override;
+
+private:
+    void avanzar();
+
+    RegistroEntradas registro;
+    int siguienteBloque = 0;
+    bool activo = false;              // Hay un bloque en curso
+
+    QVector<EventoTecla> eventos;     // Teclas del bloque en curso
+    int siguienteEvento = 0;
+    qint64 pasoInicial = 0;
+    QPointer<Goku> goku;
+    TareaBucle* tarea;
+
+    // Bloqueamos copia y asignación
+    ReproductorEntradas(const ReproductorEntradas&) = delete;
+    ReproductorEntradas& operator=(const ReproductorEntradas&) = delete;
+};
+
+#endif // REPRODUCTORENTRADAS_H
@@ -1,7 +1,11 @@
 #include "robot.h"
 #include "explosion.h"
+#include "poolexplosiones.h"
+#include "spritecache.h"
 #include <QMessageBox>
+#include <QTimer>
 #include <QDebug>
+#include <iterator>  // std::size
 #include <stdexcept> // Excepciones estándar
 
 // Inicialización del contador
@@ -25,9 +29,9 @@ Crea el sprite gráfico y lo añade a la escena.
 
 Carga las imágenes correspondientes al robot según su número.
 
-Ajusta la escala visual del sprite y le asigna una etiqueta para colisiones.
+Ajusta la escala visual del sprite y lo registra en el mundo de colisiones con el tipo `EntidadRobot`.
 
-Configura temporizadores para controlar el movimiento horizontal y la animación del robot.
+Registra tareas en el bucle central para controlar el movimiento horizontal y la animación del robot.
 */
 Robot::Robot(QGraphicsScene *scene, int velocidad, int numeroRobot, QObject *parent)
     : QObject(parent), scene(scene), velocidad(velocidad)
@@ -35,21 +39,19 @@ Robot::Robot(QGraphicsScene *scene, int velocidad, int numeroRobot, QObject *par
     if (!scene)
         throw std::invalid_argument("Robot: la escena no puede ser nula.");
 
-    sprite = new QGraphicsPixmapItem;
+    sprite = new PixmapNivel;
     scene->addItem(sprite);
 
     cargarImagen(numeroRobot); // Carga sprites del robot desde una hoja
 
     sprite->setScale(5.0);     // Ajuste visual para este tipo
-    sprite->setData(0, "robot"); // Etiqueta de colisión
+    cuerpo = MundoColisiones::instancia()->agregar(sprite, EntidadRobot, EntidadNinguna, this);
 
-    // Timer que controla el movimiento horizontal
-    timerMovimiento = new QTimer(this);
-    connect(timerMovimiento, &QTimer::timeout, this, &Robot::mover);
+    // Tarea que controla el movimiento horizontal
+    tareaMovimiento = new TareaBucle(BucleJuego::FaseEnemigos, [this]() { mover(); }, this, "mover");
 
-    // Timer para animar el ciclo de sprites
-    timerAnimacion = new QTimer(this);
-    connect(timerAnimacion, &QTimer::timeout, this, &Robot::animar);
+    // Tarea para animar el ciclo de sprites
+    tareaAnimacion = new TareaBucle(BucleJuego::FaseEnemigos, [this]() { animar(); }, this, "animar");
 }
 
 /**
@@ -70,7 +72,7 @@ Carga los frames específicos para el robot del Nivel 2.
 
 Ajusta la escala del sprite para adecuarla al nivel.
 
-Asigna una etiqueta diferenciadora para colisiones y lógica de Nivel 2.
+Lo registra en el mundo de colisiones con el tipo `EntidadRobotNivel2`, distinto del robot del Nivel 1.
 */
 Robot::Robot(QGraphicsScene *scene, QObject *parent)
     : QObject(parent), scene(scene)
@@ -78,79 +80,76 @@ Robot::Robot(QGraphicsScene *scene, QObject *parent)
     if (!scene)
         throw std::invalid_argument("Robot (Nivel2): la escena no puede ser nula.");
 
-    sprite = new QGraphicsPixmapItem;
+    sprite = new PixmapNivel;
     scene->addItem(sprite);
 
     cargarRobot2();           // Carga frames para el robot de Nivel2
     sprite->setScale(0.5);    // Escalado diferente
-    sprite->setData(0, "robot_nivel2");
+    sprite->setTransformationMode(Qt::SmoothTransformation);   // Reducido: se suaviza solo este item
+    cuerpo = MundoColisiones::instancia()->agregar(sprite, EntidadRobotNivel2, EntidadNinguna, this);
 }
 
 /**
 @brief Destructor de la clase Robot.
 
-Libera todos los recursos asociados al robot, incluyendo temporizadores y objetos gráficos.
+Libera todos los recursos asociados al robot, incluyendo tareas del bucle central y objetos gráficos.
 
 @details
 
-Detiene y desconecta los temporizadores de movimiento, animación, ataque y muerte.
+Detiene y quita del bucle las tareas de movimiento, animación, ataque y muerte.
 
-Elimina y libera memoria de los temporizadores.
+Elimina y libera memoria de las tareas.
 
-Remueve el sprite gráfico de la escena y lo elimina.
+Quita su cuerpo del mundo de colisiones, remueve el sprite gráfico de la escena y lo elimina.
 
-Libera todas las explosiones asociadas al robot, desconectando señales para evitar referencias colgantes.
-
-Limpia la lista de explosiones para evitar fugas de memoria.
+Destruye la reserva de explosiones del robot, que libera todas sus explosiones (libres o en vuelo).
 */
 Robot::~Robot()
 {
     qDebug() << "Destructor de Robot llamado";
 
-    if (timerMovimiento) {
-        timerMovimiento->stop();
-        disconnect(timerMovimiento, nullptr, this, nullptr);
-        delete timerMovimiento;
-        timerMovimiento = nullptr;
+    if (tareaMovimiento) {
+        tareaMovimiento->detener();
+        delete tareaMovimiento;
+        tareaMovimiento = nullptr;
     }
 
-    if (timerAnimacion) {
-        timerAnimacion->stop();
-        disconnect(timerAnimacion, nullptr, this, nullptr);
-        delete timerAnimacion;
-        timerAnimacion = nullptr;
+    if (tareaAnimacion) {
+        tareaAnimacion->detener();
+        delete tareaAnimacion;
+        tareaAnimacion = nullptr;
     }
 
-    if (timerAtaque) {
-        timerAtaque->stop();
-        disconnect(timerAtaque, nullptr, this, nullptr);
-        delete timerAtaque;
-        timerAtaque = nullptr;
+    if (tareaAtaque) {
+        tareaAtaque->detener();
+        delete tareaAtaque;
+        tareaAtaque = nullptr;
     }
 
-    if (timerMuerte) {
-        timerMuerte->stop();
-        disconnect(timerMuerte, nullptr, this, nullptr);
-        delete timerMuerte;
-        timerMuerte = nullptr;
+    delete secuenciaDespliegue;
+    secuenciaDespliegue = nullptr;
+
+    delete secuenciaDisparo;
+    secuenciaDisparo = nullptr;
+
+    if (tareaMuerte) {
+        tareaMuerte->detener();
+        delete tareaMuerte;
+        tareaMuerte = nullptr;
     }
 
+    MundoColisiones::instancia()->quitar(cuerpo);
+    cuerpo = -1;
+
     if (sprite) {
         scene->removeItem(sprite);
         delete sprite;
         sprite = nullptr;
     }
 
-    //liberar explosiones en robot
-    for (Explosion* e : ListaExplosiones) {
-        if (e) {
-            e->disconnect();  // Previene que lambdas pendientes intenten usar el objeto destruido
-            //qDebug() << "Entro a desconectar explosion robot y lo logro";
-            delete e;
-            //qDebug() << "Entro a liberar explosion desde robot y lo logro";
-        }
-    }
-    ListaExplosiones.clear();
+    //liberar la reserva de explosiones (destruye también las que están en vuelo)
+    delete poolExplosiones;
+    poolExplosiones = nullptr;
 
 }
 
@@ -161,7 +160,7 @@ Robot::~Robot()
 
 @details
 
-Carga la imagen "robots1.png" desde los recursos o desde un archivo alternativo.
+Pide a `SpriteCache` la imagen "robots1.png" (desde los recursos o desde un archivo alternativo); la hoja se decodifica una sola vez para todos los robots.
 
 Valida que la imagen se haya cargado correctamente, lanzando excepción en caso contrario.
 
@@ -176,28 +175,20 @@ void Robot::cargarImagen(int numeroRobot)
     const int ancho = 50, alto = 56;
     const int framesPorRobot = 6;
 
-    QPixmap spriteSheet(":/images/robots1.png");
-    if (spriteSheet.isNull())
-        spriteSheet.load("imagenes/robots1.png");
-
-    if (spriteSheet.isNull())
-        throw std::runtime_error("Robot::cargarImagen - No se encontró robots1.png.");
-
     int bloque = qBound(0, numeroRobot - 1, 3); // Asegura que el índice esté entre 0-3
     const int frameInicial = bloque * framesPorRobot;
 
-    frames.clear();
-    for (int i = 0; i < framesPorRobot; ++i) {
-        int x = (frameInicial + i) * ancho;
-        frames.append(spriteSheet.copy(x, 0, ancho, alto));
-    }
+    frames = SpriteCache::instancia()->frames(":/images/robots1.png", ancho, alto, framesPorRobot, frameInicial);
+
+    if (frames.isEmpty())
+        throw std::runtime_error("Robot::cargarImagen - No se encontró robots1.png.");
 
     if (!frames.isEmpty())
         sprite->setPixmap(frames[0]); // Primer frame por defecto
 }
 
 /**
-@brief Inicializa la posición del robot y activa los temporizadores de movimiento y animación.
+@brief Inicializa la posición del robot y activa las tareas de movimiento y animación.
 
 @param x Coordenada horizontal inicial donde se posicionará el robot.
 @param y Coordenada vertical inicial donde se posicionará el robot.
@@ -209,16 +200,17 @@ Establece la posición inicial del sprite en la escena.
 
 Asigna el destino horizontal para controlar el movimiento.
 
-Inicia el temporizador que mueve el robot periódicamente cada 60 ms.
+Inicia la tarea que mueve el robot periódicamente cada 60 ms.
 
-Inicia el temporizador que actualiza la animación del robot cada 120 ms.
+Inicia la tarea que actualiza la animación del robot cada 120 ms.
 */
 void Robot::iniciar(int x, int y, int xDestino)
 {
     destinoX = xDestino;
     sprite->setPos(x, y);
-    timerMovimiento->start(60);
-    timerAnimacion->start(120);
+    MundoColisiones::instancia()->actualizar(cuerpo);
+    tareaMovimiento->iniciar(60);
+    tareaAnimacion->iniciar(120);
 }
 
 /**
@@ -230,15 +222,16 @@ Mueve el sprite del robot una cantidad fija en dirección negativa (izquierda) s
 
 Cuando la posición horizontal actual alcanza o pasa el destino definido, detiene el movimiento y resetea el sprite al frame inicial.
 
-@note El movimiento se realiza periódicamente mediante un temporizador.
+@note El movimiento se realiza periódicamente desde el bucle central.
 */
 void Robot::mover()
 {
     //qDebug() << "timer mover en robot llamado  "<<contador++;
     sprite->moveBy(-velocidad, 0);
+    MundoColisiones::instancia()->actualizar(cuerpo);
 
     if (destinoX >= 0 && sprite->x() <= destinoX) {
-        timerMovimiento->stop();
+        tareaMovimiento->detener();
         sprite->setPixmap(frames[0]);
     }
 }
@@ -278,9 +271,7 @@ Marca el robot como desplegado para evitar repeticiones.
 
 Utiliza una secuencia predefinida de índices de frames para mostrar diferentes poses o estados.
 
-Emplea temporizadores QTimer::singleShot para espaciar los cambios de frame con un retardo fijo (1500 ms) entre cada uno.
-
-Actualiza el sprite con el frame correspondiente en cada llamada retardada, creando una animación escalonada.
+Arma una `SecuenciaAcciones` que muestra cada frame de la secuencia y espera un retardo fijo (1500 ms) antes del siguiente, creando una animación escalonada que avanza con el bucle central.
 */
 void Robot::desplegarRobot()
 {
@@ -290,13 +281,14 @@ void Robot::desplegarRobot()
     static const QVector<int> orden = {0, 1, 3, 2, 5, 4};
     const int delay = 1500;
 
+    secuenciaDespliegue = new SecuenciaAcciones(this, BucleJuego::FaseEnemigos, "desplegar");
     for (int i = 0; i < orden.size(); ++i) {
-        QTimer::singleShot(i * delay, this, [this, i]() {
-
-            //qDebug() << "timer single shot de mostrar robot en robot llamado  "<<contador++;
+        if (i > 0) secuenciaDespliegue->esperar(delay);
+        secuenciaDespliegue->hacer([this, i]() {
             sprite->setPixmap(frames[orden[i]]);
         });
     }
+    secuenciaDespliegue->iniciar();
 }
 
 /**
@@ -304,25 +296,25 @@ void Robot::desplegarRobot()
 
 @details
 
-Si el temporizador de movimiento está activo, lo detiene.
+Si la tarea de movimiento está activa, la detiene.
 
 Cambia el modo a marcha, configurando el frame actual en 4 para comenzar la animación específica de marcha.
 
 Actualiza el sprite con el frame inicial de marcha.
 
-Si el temporizador de animación no está activo, lo inicia con un intervalo de 120 ms para actualizar los frames de marcha periódicamente.
+Si la tarea de animación no está activa, la inicia con un intervalo de 120 ms para actualizar los frames de marcha periódicamente.
 */
 void Robot::detenerMvtoRobot()
 {
-    if (timerMovimiento && timerMovimiento->isActive())
-        timerMovimiento->stop();
+    if (tareaMovimiento && tareaMovimiento->estaActiva())
+        tareaMovimiento->detener();
 
     modoMarcha = true;
     frameActual = 4;
     sprite->setPixmap(frames[frameActual]);
 
-    if (timerAnimacion && !timerAnimacion->isActive())
-        timerAnimacion->start(120);
+    if (tareaAnimacion && !tareaAnimacion->estaActiva())
+        tareaAnimacion->iniciar(120);
 }
 
 /**
@@ -330,7 +322,7 @@ void Robot::detenerMvtoRobot()
 
 @details
 
-Carga la hoja de sprites robot.png desde los recursos.
+Obtiene la hoja de sprites robot.png de la caché compartida.
 
 Valida que la imagen se haya cargado correctamente, lanzando una excepción si falla.
 
@@ -344,15 +336,11 @@ void Robot::cargarRobot2()
 {
     const int anchoFrame = 100, altoFrame = 150;
 
-    QPixmap sheet(":/images/robot.png");
-    if (sheet.isNull())
+    // Todos los frames que quepan en la hoja
+    framesRobot2 = SpriteCache::instancia()->frames(":/images/robot.png", anchoFrame, altoFrame, 0);
+    if (framesRobot2.isEmpty())
         throw std::runtime_error("Robot::cargarRobot2 - No se encontró robot.png.");
 
-    int numFrames = sheet.width() / anchoFrame;
-    framesRobot2.clear();
-    for (int i = 0; i < numFrames; ++i)
-        framesRobot2.append(sheet.copy(i * anchoFrame, 0, anchoFrame, altoFrame));
-
     if (!framesRobot2.isEmpty()) {
         sprite->setPixmap(framesRobot2[4]);
         frames = framesRobot2;
@@ -364,44 +352,53 @@ void Robot::cargarRobot2()
 
 @details
 
-Crea un temporizador que dispara periódicamente (cada 1000 ms) una animación de ataque mediante la secuencia de frames especificada.
+Registra una tarea en el bucle central que dispara periódicamente (cada 1000 ms) una animación de ataque mediante la secuencia de frames especificada.
 
 Cambia el frame del sprite en cada llamada para simular el ataque.
 
-Cada vez que la animación completa un ciclo, crea una nueva explosión en la posición del arma del robot.
+Cada vez que la animación completa un ciclo, lanza una explosión en la posición del arma del robot.
 
 Alterna el tipo de movimiento de la explosión entre parabólico y movimiento rectilíneo uniforme (MRU) en cada ataque.
 
-Añade la explosión a la lista interna para su posterior gestión y liberación.
+La posición en la animación (`frameDisparo`) es propia de cada robot y se reinicia en cada llamada, así que el
+momento de cada disparo no depende de otros robots ni de partidas anteriores del mismo proceso.
+
+La explosión se toma de la reserva del robot y vuelve a ella sola al terminar su vuelo.
 */
 void Robot::iniciarAtaques()
 {
-    timerAtaque = new QTimer(this);
-    connect(timerAtaque, &QTimer::timeout, this, [=]() {
+    // El nivel ya fijó la posición y la escala definitivas del sprite
+    MundoColisiones::instancia()->actualizar(cuerpo);
 
-        //qDebug() << "timer ataque de robot en robot llamado  "<<contador++;
-        static QVector<int> framesDisparo = {0, 1, 2, 3, 4};
-        static int indexFrame = 0;
+    if (!tareaAtaque) {
+        tareaAtaque = new TareaBucle(BucleJuego::FaseEnemigos, [this]() {
 
-        sprite->setPixmap(framesRobot2[framesDisparo[indexFrame]]);
-        indexFrame = (indexFrame + 1) % framesDisparo.size();
+            //qDebug() << "timer ataque de robot en robot llamado  "<<contador++;
+            static constexpr int framesDisparo[] = {0, 1, 2, 3, 4};
+            const int numFrames = static_cast<int>(std::size(framesDisparo));
 
-        if (indexFrame == 0) {
-            Explosion* explosion = new Explosion(scene, this);
-            ListaExplosiones.append(explosion);
-            explosion->setTipoMovimiento(usarParabolico ? Explosion::Parabolico : Explosion::MRU);
-            usarParabolico = !usarParabolico;
+            sprite->setPixmap(framesRobot2[framesDisparo[frameDisparo]]);
+            frameDisparo = (frameDisparo + 1) % numFrames;
 
-            QPointF posArma = sprite->scenePos()
-                              + QPointF(sprite->pixmap().width() * -0.35,
-                                        sprite->pixmap().height() * 0.9);
-            explosion->setPosicionInicial(posArma);
-            explosion->lanzar();
+            if (frameDisparo == 0) {
+                Explosion* explosion = tomarExplosion();
+                if (!explosion) return;
+                explosion->setTipoMovimiento(usarParabolico ? Explosion::Parabolico : Explosion::MRU);
+                usarParabolico = !usarParabolico;
 
-        }
-    });
+                QPointF posArma = sprite->scenePos()
+                                  + QPointF(sprite->pixmap().width() * -0.35,
+                                            sprite->pixmap().height() * 0.9);
+                explosion->setPosicionInicial(posArma);
+                explosion->lanzar();
 
-    timerAtaque->start(1000);
+            }
+        }, this, "disparar");
+    }
+
+    // Cada robot empieza su animación desde el primer frame, sin depender de otros robots ni partidas
+    frameDisparo = 0;
+    tareaAtaque->iniciar(1000);
 }
 
 /**
@@ -411,29 +408,29 @@ void Robot::iniciarAtaques()
 
 Verifica que haya al menos 5 frames disponibles para la animación.
 
-Cambia el sprite del robot a diferentes frames en intervalos de 200 ms usando temporizadores QTimer::singleShot.
+Cambia el sprite del robot a diferentes frames en intervalos de 200 ms con una `SecuenciaAcciones` que se arma la primera vez y se reutiliza en cada disparo.
 
-Al tercer temporizador, dispara una explosión con movimiento parabólico y cambia el sprite al frame final de la secuencia.
+Al final de la secuencia, dispara una explosión con movimiento parabólico y cambia el sprite al frame final.
 */
 void Robot::animarYDisparar()
 {
     if (framesRobot2.size() < 5) return;
 
-    sprite->setPixmap(framesRobot2[0]);
-    QTimer::singleShot(200, this, [this]() {
-
-        //qDebug() << "timer 1 single shot en robot llamado  "<<contador++;
-        sprite->setPixmap(framesRobot2[1]); });
-    QTimer::singleShot(400, this, [this]() {
-
-        //qDebug() << "timer 2 single shot en robot llamado  "<<contador++;
-        sprite->setPixmap(framesRobot2[2]); });
-    QTimer::singleShot(600, this, [this]() {
+    if (!secuenciaDisparo) {
+        secuenciaDisparo = new SecuenciaAcciones(this, BucleJuego::FaseEnemigos, "animarYDisparar");
+        secuenciaDisparo->hacer([this]() { sprite->setPixmap(framesRobot2[0]); })
+            .esperar(200)
+            .hacer([this]() { sprite->setPixmap(framesRobot2[1]); })
+            .esperar(200)
+            .hacer([this]() { sprite->setPixmap(framesRobot2[2]); })
+            .esperar(200)
+            .hacer([this]() {
+                dispararExplosion(true);
+                sprite->setPixmap(framesRobot2[4]);
+            });
+    }
 
-        //qDebug() << "timer 3 single shot en robot llamado  "<<contador++;
-        dispararExplosion(true);
-        sprite->setPixmap(framesRobot2[4]);
-    });
+    secuenciaDisparo->iniciar();
 }
 
 /**
@@ -443,7 +440,7 @@ void Robot::animarYDisparar()
 
 @details
 
-Instancia un objeto Explosion y lo añade a la lista interna para su gestión.
+Toma una explosión libre de la reserva del robot; si la reserva llegó a su límite, no dispara.
 
 Configura el tipo de movimiento según el parámetro parabolica.
 
@@ -453,8 +450,8 @@ Ejecuta el lanzamiento de la explosión.
 */
 void Robot::dispararExplosion(bool parabolica)
 {
-    Explosion* ex = new Explosion(scene, this);
-    ListaExplosiones.append(ex);  //agregar a la lista
+    Explosion* ex = tomarExplosion();
+    if (!ex) return;
     ex->setTipoMovimiento(parabolica ? Explosion::Parabolico : Explosion::MRU);
 
     QPointF pos = sprite->pos() + QPointF(sprite->boundingRect().width() / 2, 60);
@@ -462,6 +459,25 @@ void Robot::dispararExplosion(bool parabolica)
     ex->lanzar();
 }
 
+/**
+@brief Obtiene una explosión libre de la reserva del robot.
+
+@details
+
+La reserva se crea con el primer disparo, así los robots que nunca atacan no crean explosiones.
+
+Si la reserva está vacía crece por bloques hasta su capacidad máxima.
+
+@return Explosión detenida y oculta, o nullptr si la reserva alcanzó su límite.
+*/
+Explosion* Robot::tomarExplosion()
+{
+    if (!poolExplosiones)
+        poolExplosiones = new PoolExplosiones(scene, 4, 4, 32, this);
+
+    return poolExplosiones->adquirir();
+}
+
 /**
 @brief Carga los frames de animación correspondientes a la muerte del robot.
 
@@ -469,7 +485,7 @@ void Robot::dispararExplosion(bool parabolica)
 
 Verifica si los frames de muerte ya están cargados para evitar cargas duplicadas.
 
-Carga la hoja de sprites murioRobot.png desde los recursos, lanzando excepción si no se encuentra.
+Obtiene la hoja de sprites murioRobot.png de la caché compartida, lanzando excepción si no se encuentra.
 
 Extrae 7 frames individuales de tamaño 120x150 píxeles para la animación de muerte.
 
@@ -480,38 +496,28 @@ void Robot::cargarFramesMuerte()
     // Si ya están cargados, no repetir
     if (!framesMuerte.isEmpty()) return;
 
-    // Cargar hoja de sprites de muerte
-    QPixmap sheet(":/images/murioRobot.png");
-    if (sheet.isNull())
-        throw std::runtime_error("Robot::cargarFramesMuerte - No se encontró murioRobot.png.");
-
     const int numFrames = 7;
     const int ancho = 120;
     const int alto  = 150;
 
-    // Extraer los frames individuales del sprite sheet
-    for (int i = 0; i < numFrames; ++i)
-        framesMuerte.append(sheet.copy(i * ancho, 0, ancho, alto));
+    // Frames individuales de la hoja de muerte, compartidos entre robots
+    framesMuerte = SpriteCache::instancia()->frames(":/images/murioRobot.png", ancho, alto, numFrames);
+    if (framesMuerte.isEmpty())
+        throw std::runtime_error("Robot::cargarFramesMuerte - No se encontró murioRobot.png.");
 }
 
 /**
-@brief Detiene el temporizador de ataques automáticos del robot y libera su memoria de forma segura.
+@brief Detiene la tarea de ataques automáticos del robot.
 
 @details
 
-Detiene el temporizador si está activo para cesar el ciclo de ataques.
-
-Llama a deleteLater() para garantizar la eliminación segura en el ciclo de eventos de Qt.
-
-Asigna el puntero a nullptr para evitar referencias colgantes.
+Desactiva la tarea si existe para cesar el ciclo de ataques. La tarea se conserva para
+poder reanudar los ataques y se libera junto con el robot.
 */
 void Robot::detenerAtaques()
 {
-    if (timerAtaque) {
-        timerAtaque->stop();           // Detener ciclo
-        timerAtaque->deleteLater();    // Liberación segura en el ciclo de eventos
-        timerAtaque = nullptr;
-    }
+    if (tareaAtaque)
+        tareaAtaque->detener();        // Detener ciclo
 }
 
 /**
@@ -521,13 +527,13 @@ void Robot::detenerAtaques()
 
 Evita ejecutar la secuencia si el robot ya está marcado como muerto.
 
-Detiene todos los temporizadores relacionados con movimiento, animación y ataques.
+Detiene todas las tareas relacionadas con movimiento, animación y ataques.
 
 Carga los frames de animación de muerte si aún no están cargados.
 
 Inicializa la animación de muerte mostrando el primer frame.
 
-Crea un temporizador que avanza los frames de muerte periódicamente (cada 500 ms).
+Registra una tarea en el bucle central que avanza los frames de muerte periódicamente (cada 500 ms).
 
 Cuando la animación termina, emite la señal robotMurio() para notificar a otras partes del programa (por ejemplo, Nivel2).
 */
@@ -538,9 +544,9 @@ void Robot::murioRobot()
     estaMuerto = true;
 
     // Detener cualquier actividad visual o lógica del robot
-    if (timerMovimiento) timerMovimiento->stop();
-    if (timerAnimacion)  timerAnimacion->stop();
-    if (timerAtaque)     timerAtaque->stop();
+    if (tareaMovimiento) tareaMovimiento->detener();
+    if (tareaAnimacion)  tareaAnimacion->detener();
+    if (tareaAtaque)     tareaAtaque->detener();
 
     // Cargar frames de muerte (si no lo estaban)
     cargarFramesMuerte();
@@ -550,26 +556,25 @@ void Robot::murioRobot()
     if (framesMuerte.size() > 0)
         sprite->setPixmap(framesMuerte[frameMuerte]);
 
-    // Crear temporizador para avanzar frame por frame de muerte
-    if (!timerMuerte) {
-        timerMuerte = new QTimer(this);
-        connect(timerMuerte, &QTimer::timeout, this, [this]() {
+    // Crear tarea para avanzar frame por frame de muerte
+    if (!tareaMuerte) {
+        tareaMuerte = new TareaBucle(BucleJuego::FaseEnemigos, [this]() {
 
             //qDebug() << "timer muerte en robot llamado  "<<contador++;
             ++frameMuerte;
 
             // Si se alcanza el último frame, detener animación
             if (frameMuerte >= framesMuerte.size()) {
-                timerMuerte->stop();
+                tareaMuerte->detener();
                 emit robotMurio();  // Señal para que Nivel2 actúe
                 return;
             }
 
             // Actualizar el sprite al siguiente frame de muerte
             sprite->setPixmap(framesMuerte[frameMuerte]);
-        });
+        }, this, "animarMuerte");
     }
 
-    timerMuerte->start(500); // 1 segundo por frame
+    tareaMuerte->iniciar(500); // 1 segundo por frame
 }
 
@@ -4,14 +4,19 @@
 #include <QObject>
 #include <QGraphicsScene>
 #include <QGraphicsPixmapItem>
-#include <QTimer>
+#include "buclejuego.h"
+#include "mundocolisiones.h"
+#include "arenanivel.h"
+#include "secuenciaacciones.h"
 
 class Explosion;
+class PoolExplosiones;
 
 class Robot : public QObject
 {
     Q_OBJECT
 public:
+    ENTIDAD_DE_NIVEL   // Se reserva en la arena del nivel
     static int contador;
 
     explicit Robot(QGraphicsScene *scene, int velocidad, int numeroRobot, QObject *parent = nullptr);
@@ -42,11 +47,12 @@ private:
     void animarYDisparar();
     void dispararExplosion(bool parabolica);
     void cargarFramesMuerte();
-    void eliminarExplosiones();
+    Explosion* tomarExplosion();
 
 
     QGraphicsScene *scene = nullptr;
     QGraphicsPixmapItem *sprite = nullptr;
+    int cuerpo = -1;              // Cuerpo en el mundo de colisiones (tipo robot)
     QVector<QPixmap> frames;
     QVector<QPixmap> framesRobot2;
     QVector<QPixmap> framesMuerte;
@@ -58,14 +64,17 @@ private:
     bool usarParabolico = true;
     bool estaMuerto = false;
 
-    QTimer *timerMovimiento = nullptr;
-    QTimer *timerAnimacion = nullptr;
-    QTimer *timerAtaque = nullptr;
-    QTimer *timerMuerte = nullptr;
+    TareaBucle *tareaMovimiento = nullptr;
+    TareaBucle *tareaAnimacion = nullptr;
+    TareaBucle *tareaAtaque = nullptr;
+    TareaBucle *tareaMuerte = nullptr;
+    SecuenciaAcciones *secuenciaDespliegue = nullptr;   // Poses del despliegue (nivel 1)
+    SecuenciaAcciones *secuenciaDisparo = nullptr;      // Animación corta antes de disparar
     int frameMuerte = 0;
+    int frameDisparo = 0;         // Posición en la animación de ataque; propia de cada robot
 
-    //explosiones
-    QList<Explosion*> ListaExplosiones;
+    //explosiones reutilizables (se crea con el primer disparo)
+    PoolExplosiones *poolExplosiones = nullptr;
 
 };
 
@@ -0,0 +1,144 @@
+#include "secuenciaacciones.h"
+#include <QPointer>
+#include <stdexcept>  // Excepciones estándar
+
+/**
+@brief Constructor de la secuencia.
+
+Registra en el bucle una tarea inactiva que, mientras la secuencia corre, descuenta la espera en
+curso en cada paso de simulación.
+
+@param parent Objeto dueño de la secuencia; las acciones suelen usarlo. No puede ser nulo.
+@param fase Fase del bucle en la que se ejecutan las acciones.
+@param nombre Literal que identifica la secuencia en la traza de eventos.
+
+@throw std::invalid_argument Si `parent` es nulo.
+*/
+SecuenciaAcciones::SecuenciaAcciones(QObject* parent, BucleJuego::Fase fase, const char* nombre)
+    : QObject(parent)
+{
+    if (!parent)
+        throw std::invalid_argument("SecuenciaAcciones: el objeto dueño no puede ser nulo.");
+
+    tarea = new TareaBucle(fase, [this]() {
+        restanteMs -= BucleJuego::pasoMs;
+        if (restanteMs <= 0)
+            continuar();
+    }, this, nombre ? nombre : "secuencia");
+}
+
+/**
+@brief Destructor. Quita la tarea del bucle; los pasos pendientes no se ejecutan.
+*/
+SecuenciaAcciones::~SecuenciaAcciones()
+{
+    detener();
+}
+
+/**
+@brief Agrega un paso que ejecuta una acción sin esperar.
+
+@param accion Acción a ejecutar. Puede destruir al dueño de la secuencia.
+@return La misma secuencia, para encadenar pasos.
+*/
+SecuenciaAcciones& SecuenciaAcciones::hacer(std::function<void()> accion)
+{
+    pasos.push_back({std::move(accion), 0});
+    return *this;
+}
+
+/**
+@brief Agrega una pausa antes del paso siguiente.
+
+@param ms Duración en milisegundos simulados. No puede ser negativa.
+@return La misma secuencia, para encadenar pasos.
+
+@throw std::invalid_argument Si `ms` es negativo.
+*/
+SecuenciaAcciones& SecuenciaAcciones::esperar(int ms)
+{
+    if (ms < 0)
+        throw std::invalid_argument("SecuenciaAcciones: la espera no puede ser negativa.");
+
+    pasos.push_back({nullptr, ms});
+    return *this;
+}
+
+/**
+@brief Detiene la secuencia y borra todos sus pasos, para armarla de nuevo.
+*/
+void SecuenciaAcciones::limpiar()
+{
+    detener();
+    pasos.clear();
+}
+
+/**
+@brief Recorre la secuencia desde el primer paso.
+
+Los pasos hasta la primera espera se ejecutan en esta misma llamada, igual que el código que
+reemplaza; desde ahí avanza con el bucle. Si ya estaba corriendo, vuelve a empezar.
+*/
+void SecuenciaAcciones::iniciar()
+{
+    detener();
+    siguiente = 0;
+    restanteMs = 0;
+    continuar();
+}
+
+/**
+@brief Detiene la secuencia donde esté. Los pasos que faltan no se ejecutan.
+*/
+void SecuenciaAcciones::detener()
+{
+    ++recorrido;
+    if (tarea && tarea->estaActiva())
+        tarea->detener();
+}
+
+/**
+@brief Indica si la secuencia está esperando para ejecutar más pasos.
+
+@return `true` entre `iniciar()` y el último paso (o `detener()`).
+*/
+bool SecuenciaAcciones::estaActiva() const
+{
+    return tarea && tarea->estaActiva();
+}
+
+/**
+@brief Ejecuta pasos hasta encontrar una espera o llegar al final.
+
+El sobrante negativo de la espera anterior se descuenta de la siguiente, de modo que una
+secuencia de esperas suma exactamente lo mismo que una sola. Si una acción destruye la
+secuencia (por ejemplo, al eliminar a su dueño), o la detiene o reinicia, el recorrido se corta
+ahí.
+*/
+void SecuenciaAcciones::continuar()
+{
+    QPointer<SecuenciaAcciones> viva(this);
+    const int esteRecorrido = recorrido;
+
+    while (siguiente < static_cast<int>(pasos.size())) {
+        const Paso& paso = pasos[siguiente++];
+
+        if (!paso.accion) {
+            restanteMs += paso.esperaMs;
+            if (restanteMs > 0) {
+                if (!tarea->estaActiva())
+                    tarea->iniciar(BucleJuego::pasoMs);
+                return;
+            }
+            continue;
+        }
+
+        // Se copia la acción porque puede limpiar o destruir la secuencia
+        std::function<void()> accion = paso.accion;
+        accion();
+        if (!viva || recorrido != esteRecorrido) return;
+    }
+
+    detener();
+    emit terminada();
+}
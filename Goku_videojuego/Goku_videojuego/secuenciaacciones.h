@@ -0,0 +1,56 @@
+#ifndef SECUENCIAACCIONES_H
+#define SECUENCIAACCIONES_H
+
+#include <QObject>
+#include <functional>
+#include <vector>
+#include "buclejuego.h"
+
+/**
+ * Secuencia de acciones con esperas, ejecutada por el bucle central.
+ * Reemplaza las cadenas de `programar()`/`QTimer::singleShot` y las esperas bloqueantes:
+ * se arma una vez ("mostrar el frame 3, esperar 200 ms, mostrar el frame 4, ...") y cada
+ * `iniciar()` la recorre de nuevo desde el principio, avanzando en tiempo simulado.
+ * Si el objeto padre se destruye, la secuencia se detiene con él.
+ */
+class SecuenciaAcciones : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SecuenciaAcciones(QObject* parent, BucleJuego::Fase fase = BucleJuego::FaseNivel,
+                               const char* nombre = nullptr);   // nombre: literal para la traza
+    ~SecuenciaAcciones();
+
+    SecuenciaAcciones& hacer(std::function<void()> accion);   // Paso instantáneo
+    SecuenciaAcciones& esperar(int ms);                       // Pausa en tiempo simulado
+    void limpiar();                                           // Borra los pasos (detiene la secuencia)
+
+    void iniciar();                      // Recorre desde el primer paso; reinicia si ya corría
+    void detener();
+    bool estaActiva() const;
+    int cantidadPasos() const { return static_cast<int>(pasos.size()); }
+
+signals:
+    void terminada();                    // Se ejecutó el último paso
+
+private:
+    struct Paso {
+        std::function<void()> accion;    // Vacía en las esperas
+        int esperaMs = 0;
+    };
+
+    void continuar();                    // Ejecuta pasos hasta la próxima espera o el final
+
+    std::vector<Paso> pasos;
+    TareaBucle* tarea;
+    int siguiente = 0;                   // Índice del próximo paso
+    int restanteMs = 0;                  // Lo que falta de la espera en curso
+    int recorrido = 0;                   // Cambia al detener o reiniciar; corta el recorrido en curso
+
+    // Bloqueamos copia y asignación
+    SecuenciaAcciones(const SecuenciaAcciones&) = delete;
+    SecuenciaAcciones& operator=(const SecuenciaAcciones&) = delete;
+};
+
+#endif // SECUENCIAACCIONES_H
@@ -0,0 +1,134 @@
+#include "simulacion.h"
+#include "buclejuego.h"
+#include "registroentradas.h"
+#include "trazaeventos.h"
+#include "rastreomemoria.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QLoggingCategory>
+#include <QTextStream>
+#include <QDebug>
+#include <stdexcept>
+
+// Si es false se descartan los qDebug del juego, que en miles de partidas solo hacen ruido
+static bool mostrarDetalle = false;
+
+static void filtrarMensajes(QtMsgType tipo, const QMessageLogContext& contexto, const QString& mensaje)
+{
+    Q_UNUSED(contexto);
+    if (!mostrarDetalle && (tipo == QtDebugMsg || tipo == QtInfoMsg))
+        return;
+
+    QTextStream(stderr) << mensaje << Qt::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    // Sin pantalla: los widgets del HUD y los QPixmap funcionan igual con la plataforma offscreen
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QApplication app(argc, argv);
+    QApplication::setApplicationName("simulador");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Juega niveles de Goku Adventure sin ventana, tan rápido como permita la CPU.");
+    parser.addHelpOption();
+    parser.addOption({"nivel", "Nivel a simular (1 o 2).", "n", "1"});
+    parser.addOption({"corridas", "Cantidad de partidas.", "n", "1"});
+    parser.addOption({"pasos", "Límite de pasos simulados por partida (5 ms cada uno).", "n", "120000"});
+    parser.addOption({"guion", "Archivo con las teclas: 'paso tecla pulsar|soltar' por línea.", "ruta"});
+    parser.addOption({"semilla", "Semilla fija para generar el nivel.", "n"});
+    parser.addOption({"repetir", "Partida grabada por el juego con --grabar; usa su semilla y sus teclas.", "ruta"});
+    parser.addOption({"traza", "Guarda una traza para chrome://tracing o Perfetto.", "ruta"});
+    parser.addOption({"memoria", "Muestra el informe de memoria de cada partida."});
+    parser.addOption({"estres", "Modo estrés: 'aves=N,explosiones=N,pociones=N,robots=N[,etapas=N][,ms=N]'.", "cantidades"});
+    parser.addOption({"estres-csv", "Guarda las mediciones del modo estrés en un CSV.", "ruta"});
+    parser.addOption({"detalle", "Muestra los mensajes de depuración del juego."});
+    parser.process(app);
+
+    mostrarDetalle = parser.isSet("detalle");
+    if (mostrarDetalle)
+        QLoggingCategory::setFilterRules(QStringLiteral("goku.*.debug=true"));
+    qInstallMessageHandler(filtrarMensajes);
+
+    QTextStream salida(stdout);
+
+    try {
+        const int nivel = parser.value("nivel").toInt();
+        const int corridas = qMax(1, parser.value("corridas").toInt());
+        const qint64 maxPasos = qMax<qint64>(1, parser.value("pasos").toLongLong());
+
+        if (parser.isSet("traza"))
+            TrazaEventos::instancia()->iniciar(parser.value("traza"));
+
+        Simulacion simulacion(nivel);
+        if (parser.isSet("guion"))
+            simulacion.setGuion(Simulacion::cargarGuion(parser.value("guion")));
+        if (parser.isSet("semilla"))
+            simulacion.setSemilla(parser.value("semilla").toUInt());
+        if (parser.isSet("estres")) {
+            ConfigEstres estres = EstresNivel::leerConfig(parser.value("estres"));
+            estres.archivo = parser.value("estres-csv");
+            simulacion.setEstres(estres);
+            QObject::connect(&simulacion, &Simulacion::etapaEstres, [&salida](const QString& linea) {
+                salida << linea << Qt::endl;
+            });
+        }
+
+        if (parser.isSet("repetir")) {
+            // Primer bloque grabado del nivel pedido
+            const RegistroEntradas registro = RegistroEntradas::cargar(parser.value("repetir"));
+            bool encontrado = false;
+            for (const BloqueNivel& bloque : registro.getBloques()) {
+                if (bloque.nivel != nivel) continue;
+                simulacion.setSemilla(bloque.semilla);
+                simulacion.setGuion(RegistroEntradas::eventos(bloque));
+                encontrado = true;
+                break;
+            }
+            if (!encontrado)
+                throw std::runtime_error("la grabación no contiene el nivel pedido.");
+        }
+
+        int completadas = 0, muertes = 0, agotadas = 0;
+        qint64 pasosTotales = 0, msTotales = 0;
+
+        for (int i = 1; i <= corridas; ++i) {
+            const ResultadoSimulacion r = simulacion.ejecutar(maxPasos);
+
+            const char* fin = r.completado ? "completado" : (r.murioGoku ? "murio" : "limite");
+            salida << "corrida " << i << ": nivel " << r.nivel << " " << fin
+                   << " semilla=" << r.semilla
+                   << " pasos=" << r.pasos
+                   << " tiempo_juego=" << (r.pasos * BucleJuego::pasoMs) / 1000.0 << "s"
+                   << " vida=" << r.vidaFinal
+                   << " real=" << r.msReales << "ms" << Qt::endl;
+
+            if (parser.isSet("memoria"))
+                salida << RastreoMemoria::informe(QString("corrida %1").arg(i)) << Qt::endl;
+
+            if (r.completado) ++completadas;
+            else if (r.murioGoku) ++muertes;
+            else ++agotadas;
+            pasosTotales += r.pasos;
+            msTotales += r.msReales;
+        }
+
+        const double segundosJuego = (pasosTotales * BucleJuego::pasoMs) / 1000.0;
+        const double segundosReales = qMax<qint64>(msTotales, 1) / 1000.0;
+        salida << "resumen: " << corridas << " corridas, " << completadas << " completadas, "
+               << muertes << " muertes, " << agotadas << " sin terminar; "
+               << segundosJuego << "s de juego en " << segundosReales << "s reales (x"
+               << segundosJuego / segundosReales << ")" << Qt::endl;
+
+        TrazaEventos::instancia()->guardar();
+
+    } catch (const std::exception& e) {
+        qCritical() << "Error en la simulación:" << e.what();
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,218 @@
+#include "simulacion.h"
+#include "arenanivel.h"
+#include "azarjuego.h"
+#include "buclejuego.h"
+#include "rastreomemoria.h"
+#include "nivel1.h"
+#include "nivel2.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QGraphicsScene>
+#include <QKeySequence>
+#include <QTextStream>
+#include <QDebug>
+#include <algorithm>
+#include <stdexcept>  // Excepciones estándar
+
+/**
+@brief Constructor de una simulación de nivel.
+
+@param numeroNivel Nivel a simular (1 o 2).
+@param parent Objeto padre en la jerarquía de Qt.
+
+@throw std::invalid_argument Si el número de nivel no es 1 ni 2.
+*/
+Simulacion::Simulacion(int numeroNivel, QObject* parent)
+    : QObject(parent), numeroNivel(numeroNivel)
+{
+    if (numeroNivel != 1 && numeroNivel != 2)
+        throw std::invalid_argument("Simulacion: el nivel debe ser 1 o 2.");
+}
+
+/**
+@brief Define las entradas que recibirá Goku durante la simulación.
+
+@param eventos Teclas a pulsar y soltar; se ordenan por paso (los del mismo paso conservan su orden).
+*/
+void Simulacion::setGuion(const QVector<EventoTecla>& eventos)
+{
+    guion = eventos;
+    std::stable_sort(guion.begin(), guion.end(), [](const EventoTecla& a, const EventoTecla& b) {
+        return a.paso < b.paso;
+    });
+}
+
+/**
+@brief Fija la semilla con la que se generará el nivel en cada partida.
+
+Con la misma semilla y el mismo guion, todas las partidas son idénticas paso a paso.
+
+@param valor Semilla de `AzarJuego`.
+*/
+void Simulacion::setSemilla(quint32 valor)
+{
+    haySemilla = true;
+    semilla = valor;
+}
+
+/**
+@brief Activa el modo estrés en cada partida.
+
+Después de iniciar el nivel se le agrega un `EstresNivel`; cada etapa medida se emite con
+`etapaEstres()`. En el simulador la medición útil es el cociente de tiempo real: cuántas veces
+más rápido que el juego se simula con esa cantidad de entidades.
+
+@param config Cantidades finales, etapas y archivo; sin cantidades el modo queda apagado.
+*/
+void Simulacion::setEstres(const ConfigEstres& config)
+{
+    estres = config;
+}
+
+/**
+@brief Lee un guion de entradas desde un archivo de texto.
+
+Cada línea tiene el formato `paso tecla accion`, por ejemplo `200 W pulsar` o `260 W soltar`.
+La tecla es una letra, un dígito o un nombre que entienda `QKeySequence` (por ejemplo `Space`).
+Las líneas vacías y las que empiezan con `#` se ignoran.
+
+@param ruta Ruta del archivo del guion.
+@return Eventos leídos, en el orden del archivo.
+
+@throw std::runtime_error Si el archivo no se puede abrir o una línea no tiene el formato esperado.
+*/
+QVector<EventoTecla> Simulacion::cargarGuion(const QString& ruta)
+{
+    QFile archivo(ruta);
+    if (!archivo.open(QIODevice::ReadOnly | QIODevice::Text))
+        throw std::runtime_error(("Simulacion: no se pudo abrir el guion " + ruta).toStdString());
+
+    QVector<EventoTecla> eventos;
+    QTextStream entrada(&archivo);
+    int numeroLinea = 0;
+
+    while (!entrada.atEnd()) {
+        const QString linea = entrada.readLine().trimmed();
+        ++numeroLinea;
+        if (linea.isEmpty() || linea.startsWith('#')) continue;
+
+        const QStringList partes = linea.split(' ', Qt::SkipEmptyParts);
+        bool pasoValido = false;
+        EventoTecla evento;
+        evento.paso = partes.value(0).toLongLong(&pasoValido);
+
+        const QString tecla = partes.value(1).toUpper();
+        const QString accion = partes.value(2).toLower();
+
+        if (tecla.size() == 1 && tecla[0].isLetter())
+            evento.tecla = Qt::Key_A + (tecla[0].unicode() - 'A');
+        else if (tecla.size() == 1 && tecla[0].isDigit())
+            evento.tecla = Qt::Key_0 + (tecla[0].unicode() - '0');
+        else if (!tecla.isEmpty()) {
+            const QKeySequence secuencia = QKeySequence::fromString(partes.value(1));
+            if (secuencia.count() == 1)
+                evento.tecla = secuencia[0].key();
+        }
+
+        if (accion == "pulsar")
+            evento.presionada = true;
+        else if (accion == "soltar")
+            evento.presionada = false;
+        else
+            pasoValido = false;
+
+        if (partes.size() != 3 || !pasoValido || evento.paso < 0 || evento.tecla == 0) {
+            qCritical() << "Guion" << ruta << "línea" << numeroLinea << ":" << linea;
+            throw std::runtime_error("Simulacion: línea de guion no válida (se espera 'paso tecla pulsar|soltar').");
+        }
+
+        eventos.push_back(evento);
+    }
+
+    return eventos;
+}
+
+/**
+@brief Juega el nivel completo sin vista y devuelve cómo terminó.
+
+Crea una escena del mismo tamaño que usa el juego para el nivel, construye el nivel sin vista
+y avanza el bucle central de a un paso fijo, entregando a Goku las teclas del guion en el paso
+que les corresponde. La partida termina cuando el nivel emite `nivelCompletado()` o `gokuMurio()`,
+o al llegar a `maxPasos`. Al final destruye el nivel y la escena, así que cada llamada es una
+partida independiente.
+
+@param maxPasos Límite de pasos simulados (cada paso son `BucleJuego::pasoMs` ms de juego).
+@return Resultado de la partida.
+
+@note El reloj de frames del bucle debe estar detenido: la simulación no usa tiempo real.
+*/
+ResultadoSimulacion Simulacion::ejecutar(qint64 maxPasos)
+{
+    ResultadoSimulacion resultado;
+    resultado.nivel = numeroNivel;
+
+    BucleJuego* bucle = BucleJuego::instancia();
+    if (bucle->estaActivo())
+        bucle->detener();
+
+    // Mismo tamaño de escena que juego::cambiarNivel
+    QGraphicsScene escena;
+    escena.setSceneRect(0, 0, numeroNivel == 1 ? 1536 * 4 : 1536, 784);
+
+    resultado.semilla = haySemilla ? semilla : AzarJuego::semillaNueva();
+    AzarJuego::sembrar(resultado.semilla);
+
+    RastreoMemoria::iniciarPeriodo();
+    ETIQUETA_MEMORIA(MemoriaNivel);
+    ArenaNivel::abrir();
+
+    Nivel* nivel = nullptr;
+    if (numeroNivel == 1)
+        nivel = new Nivel1(&escena, nullptr);
+    else
+        nivel = new Nivel2(&escena, nullptr);
+
+    connect(nivel, &Nivel::nivelCompletado, this, [&resultado]() { resultado.completado = true; });
+    connect(nivel, &Nivel::gokuMurio, this, [&resultado]() { resultado.murioGoku = true; });
+
+    QElapsedTimer reloj;
+    reloj.start();
+
+    nivel->iniciarNivel();
+
+    if (estres.activo()) {
+        EstresNivel* modoEstres = new EstresNivel(nivel, estres);
+        connect(modoEstres, &EstresNivel::etapaMedida, this, &Simulacion::etapaEstres);
+    }
+
+    int siguiente = 0;
+    qint64 paso = 0;
+    while (paso < maxPasos && !resultado.completado && !resultado.murioGoku) {
+        // Entradas programadas para este paso
+        while (siguiente < guion.size() && guion[siguiente].paso <= paso) {
+            if (Goku* goku = nivel->getGoku())
+                goku->enviarTecla(guion[siguiente].tecla, guion[siguiente].presionada);
+            ++siguiente;
+        }
+
+        bucle->avanzar(1);
+        ++paso;
+
+        // Sin bucle de eventos, los deleteLater() se atienden a mano de vez en cuando
+        if ((paso & 255) == 0)
+            QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    }
+
+    resultado.pasos = paso;
+    if (Goku* goku = nivel->getGoku())
+        resultado.vidaFinal = goku->obtenerVida();
+
+    disconnect(nivel, nullptr, this, nullptr);
+    delete nivel;
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    ArenaNivel::cerrar();
+
+    resultado.msReales = reloj.elapsed();
+    return resultado;
+}
@@ -0,0 +1,53 @@
+#ifndef SIMULACION_H
+#define SIMULACION_H
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+#include "registroentradas.h"
+#include "estresnivel.h"
+
+// Resultado de una partida simulada
+struct ResultadoSimulacion {
+    int nivel = 0;
+    quint32 semilla = 0;         // Semilla con la que se generó el nivel
+    bool completado = false;     // El nivel emitió nivelCompletado()
+    bool murioGoku = false;      // El nivel emitió gokuMurio()
+    qint64 pasos = 0;            // Pasos fijos simulados
+    int vidaFinal = 0;
+    qint64 msReales = 0;         // Tiempo real que tardó la simulación
+};
+
+/**
+ * Ejecuta un nivel completo sin QGraphicsView.
+ * El nivel vive en una QGraphicsScene que nunca se pinta y se mueve con BucleJuego::avanzar(),
+ * paso a paso, tan rápido como permita la CPU. Las teclas las entrega un guion en lugar del teclado
+ * (escrito a mano o sacado de una grabación del juego).
+ */
+class Simulacion : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit Simulacion(int numeroNivel, QObject* parent = nullptr);
+
+    void setGuion(const QVector<EventoTecla>& eventos);
+    void setSemilla(quint32 valor);            // Sin semilla, cada partida usa una nueva
+    void setEstres(const ConfigEstres& config);   // Modo estrés en cada partida
+    static QVector<EventoTecla> cargarGuion(const QString& ruta);
+
+    ResultadoSimulacion ejecutar(qint64 maxPasos);
+
+signals:
+    void etapaEstres(const QString& linea);    // Medición de cada etapa del modo estrés
+
+private:
+    int numeroNivel;
+    QVector<EventoTecla> guion;     // Ordenado por paso
+    bool haySemilla = false;
+    quint32 semilla = 0;
+    ConfigEstres estres;            // Sin cantidades: modo estrés apagado
+};
+
+#endif // SIMULACION_H
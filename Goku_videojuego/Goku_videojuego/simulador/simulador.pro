@@ -0,0 +1,17 @@
+# Simulador sin vista: juega niveles completos con entradas programadas,
+# sin QGraphicsView y tan rápido como permita la CPU.
+
+TARGET = simulador
+TEMPLATE = app
+
+CONFIG += console
+CONFIG -= app_bundle
+
+include(../nucleo.pri)
+
+SOURCES += \
+    main.cpp \
+    simulacion.cpp
+
+HEADERS += \
+    simulacion.h
@@ -0,0 +1,338 @@
+#include "spritecache.h"
+#include "trazaeventos.h"
+#include "rastreomemoria.h"
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <QDebug>
+#include <stdexcept>  // Para lanzar excepciones estándar
+
+// Instancia única de la caché (se crea bajo demanda)
+SpriteCache* SpriteCache::unico = nullptr;
+
+/**
+@brief Constructor privado de la caché de sprites.
+
+La caché se vacía cuando la aplicación está por terminar, para que ningún `QPixmap` sobreviva
+a la aplicación gráfica que lo creó.
+
+@param parent Objeto padre en la jerarquía de Qt (normalmente la aplicación).
+*/
+SpriteCache::SpriteCache(QObject* parent)
+    : QObject(parent)
+{
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, [this]() {
+        hojas.clear();
+        secuencias.clear();
+        variantes.clear();
+    });
+}
+
+/**
+@brief Devuelve la instancia única de la caché, creándola la primera vez.
+
+@return Puntero a la caché de sprites del juego.
+
+@throw std::runtime_error Si se invoca antes de crear la aplicación de Qt.
+*/
+SpriteCache* SpriteCache::instancia()
+{
+    if (!unico) {
+        if (!QCoreApplication::instance())
+            throw std::runtime_error("SpriteCache: la aplicación de Qt no ha sido creada.");
+        unico = new SpriteCache(QCoreApplication::instance());
+    }
+    return unico;
+}
+
+/**
+@brief Devuelve la hoja de sprites completa, decodificándola solo la primera vez.
+
+Si la ruta de recursos no existe se intenta la copia local en `imagenes/`, igual que hacían
+los constructores de los personajes. Las hojas que no se pudieron cargar no se guardan, así
+que el error se sigue reportando en cada llamada.
+
+@param ruta Ruta del recurso (por ejemplo `:/images/robots1.png`).
+@return La hoja decodificada, o un `QPixmap` nulo si no se encontró.
+*/
+QPixmap SpriteCache::hoja(const QString& ruta)
+{
+    ETIQUETA_MEMORIA(MemoriaSprites);
+    auto it = hojas.constFind(ruta);
+    if (it != hojas.constEnd())
+        return it.value();
+
+    TRAZA_EVENTO("SpriteCache::decodificar", "recursos");
+    QPixmap imagen(ruta);
+    if (imagen.isNull())
+        imagen.load("imagenes/" + QFileInfo(ruta).fileName());
+
+    if (imagen.isNull()) {
+        qWarning() << "SpriteCache: no se pudo cargar" << ruta;
+        return imagen;
+    }
+
+    hojas.insert(ruta, imagen);
+    return imagen;
+}
+
+/**
+@brief Indica si la hoja ya está decodificada en la caché.
+
+@param ruta Ruta del recurso de la hoja.
+@return `true` si `hoja(ruta)` no necesita decodificar nada.
+*/
+bool SpriteCache::contiene(const QString& ruta) const
+{
+    return hojas.contains(ruta);
+}
+
+/**
+@brief Guarda una hoja decodificada fuera de la caché, normalmente por `PrecargaNivel`.
+
+Si la hoja ya estaba se conserva la existente, para no duplicar los datos de las entidades que
+la están usando.
+
+@param ruta Ruta del recurso de la hoja.
+@param imagen Hoja ya convertida a `QPixmap`; las nulas se ignoran.
+*/
+void SpriteCache::agregarHoja(const QString& ruta, const QPixmap& imagen)
+{
+    if (imagen.isNull() || hojas.contains(ruta)) return;
+    hojas.insert(ruta, imagen);
+}
+
+/**
+@brief Decodifica una hoja a `QImage` sin pasar por la caché.
+
+Usa el mismo respaldo que `hoja()` (la copia local en `imagenes/`). Como no crea `QPixmap` ni
+toca la caché, es seguro llamarlo desde un hilo de trabajo.
+
+@param ruta Ruta del recurso de la hoja.
+@return La imagen decodificada, o una imagen nula si no se encontró.
+*/
+QImage SpriteCache::leerImagen(const QString& ruta)
+{
+    QImage imagen(ruta);
+    if (imagen.isNull())
+        imagen.load("imagenes/" + QFileInfo(ruta).fileName());
+    return imagen;
+}
+
+/**
+@brief Devuelve una secuencia de frames de igual tamaño recortados en horizontal de una hoja.
+
+La secuencia se recorta una sola vez por combinación de ruta, rectángulo y cantidad; las
+llamadas siguientes devuelven el mismo vector compartido.
+
+@param ruta Ruta del recurso de la hoja.
+@param ancho Ancho de cada frame.
+@param alto Alto de cada frame.
+@param cantidad Cantidad de frames; si es menor o igual a cero se toman todos los que quepan en la hoja.
+@param primerFrame Índice (en frames) del primer frame a recortar.
+@param y Coordenada vertical de la fila de frames dentro de la hoja.
+@return Los frames recortados, o un vector vacío si la hoja no se pudo cargar.
+
+@throw std::invalid_argument Si el tamaño del frame no es positivo.
+*/
+QVector<QPixmap> SpriteCache::frames(const QString& ruta, int ancho, int alto, int cantidad,
+                                     int primerFrame, int y)
+{
+    ETIQUETA_MEMORIA(MemoriaSprites);
+    if (ancho <= 0 || alto <= 0)
+        throw std::invalid_argument("SpriteCache::frames - el tamaño del frame debe ser positivo.");
+
+    const QString clave = claveFrames(ruta, QRect(primerFrame * ancho, y, ancho, alto), cantidad);
+    auto it = secuencias.constFind(clave);
+    if (it != secuencias.constEnd())
+        return it.value();
+
+    QPixmap origen = hoja(ruta);
+    if (origen.isNull())
+        return {};
+
+    if (cantidad <= 0)
+        cantidad = origen.width() / ancho - primerFrame;
+
+    QVector<QPixmap> resultado;
+    resultado.reserve(cantidad);
+    for (int i = 0; i < cantidad; ++i)
+        resultado.append(origen.copy((primerFrame + i) * ancho, y, ancho, alto));
+
+    secuencias.insert(clave, resultado);
+    return resultado;
+}
+
+/**
+@brief Devuelve un único recorte de una hoja, guardándolo para las siguientes llamadas.
+
+@param ruta Ruta del recurso de la hoja.
+@param rect Rectángulo a recortar dentro de la hoja.
+@return El recorte, o un `QPixmap` nulo si la hoja no se pudo cargar.
+*/
+QPixmap SpriteCache::frame(const QString& ruta, const QRect& rect)
+{
+    ETIQUETA_MEMORIA(MemoriaSprites);
+    const QString clave = claveFrames(ruta, rect, 1);
+    auto it = secuencias.constFind(clave);
+    if (it != secuencias.constEnd())
+        return it.value().first();
+
+    QPixmap origen = hoja(ruta);
+    if (origen.isNull())
+        return origen;
+
+    QPixmap recorte = origen.copy(rect);
+    secuencias.insert(clave, QVector<QPixmap>{recorte});
+    return recorte;
+}
+
+/**
+@brief Devuelve una versión escalada y suavizada de una imagen, conservando su proporción.
+
+El resultado se indexa por la identidad de los datos de `origen` (`QPixmap::cacheKey()`) y el
+tamaño pedido, de modo que las entidades que piden la misma variante la comparten.
+
+@param origen Imagen a escalar (normalmente obtenida de esta misma caché).
+@param ancho Ancho máximo del resultado.
+@param alto Alto máximo del resultado.
+@return La imagen escalada.
+*/
+QPixmap SpriteCache::escalado(const QPixmap& origen, int ancho, int alto)
+{
+    ETIQUETA_MEMORIA(MemoriaSprites);
+    if (origen.isNull()) return origen;
+
+    const QString clave = claveEscalado(origen, ancho, alto);
+    auto it = variantes.constFind(clave);
+    if (it != variantes.constEnd())
+        return it.value();
+
+    QPixmap resultado = origen.scaled(ancho, alto, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    variantes.insert(clave, resultado);
+    return resultado;
+}
+
+/**
+@brief Devuelve una versión suavizada de una imagen escalada a la altura indicada.
+
+@param origen Imagen a escalar.
+@param alto Altura deseada; el ancho se ajusta para conservar la proporción.
+@return La imagen escalada.
+*/
+QPixmap SpriteCache::escaladoAlto(const QPixmap& origen, int alto)
+{
+    ETIQUETA_MEMORIA(MemoriaSprites);
+    if (origen.isNull()) return origen;
+
+    const QString clave = claveEscalado(origen, -1, alto);
+    auto it = variantes.constFind(clave);
+    if (it != variantes.constEnd())
+        return it.value();
+
+    QPixmap resultado = origen.scaledToHeight(alto, Qt::SmoothTransformation);
+    variantes.insert(clave, resultado);
+    return resultado;
+}
+
+/**
+@brief Escala todos los frames de una secuencia por el mismo factor.
+
+@param origen Frames originales.
+@param factor Factor de escala (por ejemplo `0.8` para el 80%).
+@return Los frames escalados, compartidos entre todas las entidades que los pidan.
+*/
+QVector<QPixmap> SpriteCache::escalados(const QVector<QPixmap>& origen, qreal factor)
+{
+    ETIQUETA_MEMORIA(MemoriaSprites);
+    QVector<QPixmap> resultado;
+    resultado.reserve(origen.size());
+    for (const QPixmap& original : origen)
+        resultado.append(escalado(original, original.width() * factor, original.height() * factor));
+    return resultado;
+}
+
+/**
+@brief Devuelve una copia volteada horizontalmente de una imagen.
+
+Sirve para tener listas de antemano las vistas hacia la izquierda de un personaje y evitar
+reconstruir una `QTransform` cada vez que cambia de dirección.
+
+@param origen Imagen a voltear.
+@return La imagen volteada, compartida entre todos los que la pidan.
+*/
+QPixmap SpriteCache::espejado(const QPixmap& origen)
+{
+    ETIQUETA_MEMORIA(MemoriaSprites);
+    if (origen.isNull()) return origen;
+
+    const QString clave = claveEscalado(origen, 0, 0) + "|espejo";
+    auto it = variantes.constFind(clave);
+    if (it != variantes.constEnd())
+        return it.value();
+
+    QPixmap resultado = QPixmap::fromImage(origen.toImage().mirrored(true, false));
+    variantes.insert(clave, resultado);
+    return resultado;
+}
+
+/**
+@brief Voltea horizontalmente todos los frames de una secuencia.
+
+@param origen Frames originales.
+@return Los frames volteados, en el mismo orden.
+*/
+QVector<QPixmap> SpriteCache::espejados(const QVector<QPixmap>& origen)
+{
+    ETIQUETA_MEMORIA(MemoriaSprites);
+    QVector<QPixmap> resultado;
+    resultado.reserve(origen.size());
+    for (const QPixmap& original : origen)
+        resultado.append(espejado(original));
+    return resultado;
+}
+
+/**
+@brief Libera las imágenes que ninguna entidad tiene en uso.
+
+Una entrada se descarta cuando la caché es el único dueño de sus datos; lo que sigue en pantalla
+se conserva. Se usa al volver al menú para no retener los sprites de una partida terminada.
+*/
+void SpriteCache::purgar()
+{
+    for (auto it = secuencias.begin(); it != secuencias.end(); ) {
+        const QVector<QPixmap>& secuencia = it.value();
+        bool libre = secuencia.isDetached();
+        for (const QPixmap& frame : secuencia)
+            libre = libre && frame.isDetached();
+
+        if (libre) it = secuencias.erase(it);
+        else ++it;
+    }
+
+    for (auto it = variantes.begin(); it != variantes.end(); ) {
+        if (it.value().isDetached()) it = variantes.erase(it);
+        else ++it;
+    }
+
+    for (auto it = hojas.begin(); it != hojas.end(); ) {
+        if (it.value().isDetached()) it = hojas.erase(it);
+        else ++it;
+    }
+}
+
+/**
+@brief Construye la clave de una secuencia de frames.
+*/
+QString SpriteCache::claveFrames(const QString& ruta, const QRect& rect, int cantidad)
+{
+    return QString("%1|%2,%3,%4,%5|%6").arg(ruta).arg(rect.x()).arg(rect.y())
+        .arg(rect.width()).arg(rect.height()).arg(cantidad);
+}
+
+/**
+@brief Construye la clave de una variante escalada a partir de la identidad de la imagen original.
+*/
+QString SpriteCache::claveEscalado(const QPixmap& origen, int ancho, int alto)
+{
+    return QString("%1|%2x%3").arg(origen.cacheKey()).arg(ancho).arg(alto);
+}
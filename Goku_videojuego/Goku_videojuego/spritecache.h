@@ -0,0 +1,68 @@
+#ifndef SPRITECACHE_H
+#define SPRITECACHE_H
+
+#include <QObject>
+#include <QHash>
+#include <QImage>
+#include <QPixmap>
+#include <QRect>
+#include <QString>
+#include <QVector>
+
+/**
+ * Caché de imágenes compartida por todo el juego.
+ * Cada hoja de sprites se decodifica una sola vez y cada secuencia de frames se recorta una
+ * sola vez; las entidades reciben copias de QPixmap que comparten los datos (implicit sharing),
+ * por lo que crear una entidad ya no implica leer ni recortar imágenes.
+ */
+class SpriteCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    static SpriteCache* instancia();
+
+    // Hoja completa (null si no se encuentra)
+    QPixmap hoja(const QString& ruta);
+    bool contiene(const QString& ruta) const;
+    void agregarHoja(const QString& ruta, const QPixmap& imagen);   // Hoja decodificada en otro lado (PrecargaNivel)
+
+    // Decodifica sin tocar la caché; se puede llamar desde cualquier hilo
+    static QImage leerImagen(const QString& ruta);
+
+    // Frames de tamaño fijo dispuestos en horizontal; cantidad <= 0 toma todos los que quepan
+    QVector<QPixmap> frames(const QString& ruta, int ancho, int alto, int cantidad,
+                            int primerFrame = 0, int y = 0);
+
+    // Un recorte arbitrario de la hoja
+    QPixmap frame(const QString& ruta, const QRect& rect);
+
+    // Variantes escaladas (suavizadas) de una imagen ya cargada
+    QPixmap escalado(const QPixmap& origen, int ancho, int alto);   // Mantiene la proporción
+    QPixmap escaladoAlto(const QPixmap& origen, int alto);
+    QVector<QPixmap> escalados(const QVector<QPixmap>& origen, qreal factor);
+
+    // Variantes volteadas horizontalmente (personajes que miran a la izquierda)
+    QPixmap espejado(const QPixmap& origen);
+    QVector<QPixmap> espejados(const QVector<QPixmap>& origen);
+
+    void purgar();   // Libera lo que ninguna entidad está usando
+
+private:
+    explicit SpriteCache(QObject* parent = nullptr);
+
+    static QString claveFrames(const QString& ruta, const QRect& rect, int cantidad);
+    static QString claveEscalado(const QPixmap& origen, int ancho, int alto);
+
+    static SpriteCache* unico;
+
+    QHash<QString, QPixmap> hojas;
+    QHash<QString, QVector<QPixmap>> secuencias;
+    QHash<QString, QPixmap> variantes;
+
+    // Bloqueamos copia y asignación
+    SpriteCache(const SpriteCache&) = delete;
+    SpriteCache& operator=(const SpriteCache&) = delete;
+};
+
+#endif // SPRITECACHE_H
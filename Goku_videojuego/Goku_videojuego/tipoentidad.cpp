@@ -0,0 +1,54 @@
+#include "tipoentidad.h"
+#include <QStringList>
+
+// Nombres de depuración, en el mismo orden que los bits de TipoEntidad
+static const char* const nombresEntidad[NumTiposEntidad] = {
+    "jugador",
+    "obstaculo",
+    "carro",
+    "explosion",
+    "pocion",
+    "robot",
+    "robot_nivel2"
+};
+
+/**
+@brief Devuelve el nombre de depuración de un tipo de entidad.
+
+Si la máscara tiene varios bits activos se usa el de menor valor.
+
+@param tipo Tipo de entidad (uno o más bits de `TipoEntidad`).
+@return Nombre del tipo, `"ninguna"` si no hay bits activos o `"desconocida"` si el bit no está en la tabla.
+*/
+const char* nombreEntidad(quint32 tipo)
+{
+    if (tipo == EntidadNinguna)
+        return "ninguna";
+
+    for (int bit = 0; bit < NumTiposEntidad; ++bit) {
+        if (tipo & (1u << bit))
+            return nombresEntidad[bit];
+    }
+    return "desconocida";
+}
+
+/**
+@brief Describe todos los tipos presentes en una máscara, separados por `|`.
+
+Reserva memoria para el texto, así que está pensado solo para mensajes de depuración.
+
+@param mascara Combinación de bits de `TipoEntidad`.
+@return Texto legible, por ejemplo `"obstaculo|carro"`.
+*/
+QString describirEntidades(quint32 mascara)
+{
+    if (mascara == EntidadNinguna)
+        return nombreEntidad(mascara);
+
+    QStringList nombres;
+    for (int bit = 0; bit < NumTiposEntidad; ++bit) {
+        if (mascara & (1u << bit))
+            nombres << nombresEntidad[bit];
+    }
+    return nombres.join('|');
+}
@@ -0,0 +1,28 @@
+#ifndef TIPOENTIDAD_H
+#define TIPOENTIDAD_H
+
+#include <QString>
+#include <QtGlobal>
+
+/**
+ * Tipo de cada entidad del juego como bit de una máscara de 32 bits.
+ * Cada cuerpo del mundo de colisiones guarda su categoría (un bit) y la máscara de
+ * categorías que le interesan; saber si un cuerpo entra en una consulta es un solo AND.
+ */
+enum TipoEntidad : quint32 {
+    EntidadNinguna     = 0,
+    EntidadJugador     = 1u << 0,
+    EntidadObstaculo   = 1u << 1,
+    EntidadCarro       = 1u << 2,
+    EntidadExplosion   = 1u << 3,
+    EntidadPocion      = 1u << 4,
+    EntidadRobot       = 1u << 5,
+    EntidadRobotNivel2 = 1u << 6
+};
+
+const int NumTiposEntidad = 7;
+
+const char* nombreEntidad(quint32 tipo);       // Nombre del tipo (primer bit activo)
+QString describirEntidades(quint32 mascara);   // "obstaculo|carro", solo para logs
+
+#endif // TIPOENTIDAD_H
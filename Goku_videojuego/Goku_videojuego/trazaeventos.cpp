@@ -0,0 +1,231 @@
+#include "trazaeventos.h"
+#include <QFile>
+#include <QTextStream>
+#include <QThread>
+#include <QCoreApplication>
+#include <QDebug>
+#include <stdexcept>  // Excepciones estándar
+
+/**
+@brief Constructor privado. Empieza a medir el tiempo de la traza.
+*/
+TrazaEventos::TrazaEventos()
+{
+    reloj.start();
+}
+
+/**
+@brief Devuelve la instancia única de la traza.
+
+@return Puntero a la traza; existe aunque no se haya iniciado.
+*/
+TrazaEventos* TrazaEventos::instancia()
+{
+    static TrazaEventos unica;
+    return &unica;
+}
+
+/**
+@brief Empieza a registrar eventos.
+
+@param rutaArchivo Archivo JSON donde `guardar()` escribirá la traza.
+
+@throw std::invalid_argument Si la ruta está vacía.
+*/
+void TrazaEventos::iniciar(const QString& rutaArchivo)
+{
+    if (rutaArchivo.isEmpty())
+        throw std::invalid_argument("TrazaEventos: la ruta de la traza no puede estar vacía.");
+
+    ruta = rutaArchivo;
+    activa.store(true, std::memory_order_relaxed);
+    qDebug() << "Traza de eventos activa, se guardará en" << ruta;
+}
+
+/**
+@brief Registra el comienzo de un evento en el hilo actual.
+
+@param nombre Nombre del evento.
+@param categoria Categoría (por ejemplo `tarea`, `nivel`, `recursos`).
+@param clase Clase a anteponer al nombre, o `nullptr`.
+*/
+void TrazaEventos::comenzar(const char* nombre, const char* categoria, const char* clase)
+{
+    registrar('B', nombre, categoria, clase);
+}
+
+/**
+@brief Registra el fin de un evento en el hilo actual. Debe coincidir con el último `comenzar`.
+
+@param nombre Nombre del evento.
+@param categoria Categoría del evento.
+@param clase Clase a anteponer al nombre, o `nullptr`.
+*/
+void TrazaEventos::terminar(const char* nombre, const char* categoria, const char* clase)
+{
+    registrar('E', nombre, categoria, clase);
+}
+
+/**
+@brief Registra un evento instantáneo (una marca en la línea de tiempo).
+
+@param nombre Nombre del evento.
+@param categoria Categoría del evento.
+*/
+void TrazaEventos::instante(const char* nombre, const char* categoria)
+{
+    registrar('i', nombre, categoria, nullptr);
+}
+
+/**
+@brief Escribe un evento en el buffer circular del hilo actual.
+
+Solo el hilo dueño escribe en su buffer, así que basta con publicar el contador con orden
+*release* para que `guardar()` vea eventos completos.
+*/
+void TrazaEventos::registrar(char fase, const char* nombre, const char* categoria, const char* clase)
+{
+    if (!estaActiva()) return;
+
+    BufferHilo* buffer = bufferPropio();
+    const quint64 indice = buffer->escritos.load(std::memory_order_relaxed);
+
+    Evento& evento = buffer->eventos[indice & (buffer->capacidad - 1)];
+    evento.nombre = nombre;
+    evento.clase = clase;
+    evento.categoria = categoria;
+    evento.ns = reloj.nsecsElapsed();
+    evento.fase = fase;
+
+    buffer->escritos.store(indice + 1, std::memory_order_release);
+}
+
+/**
+@brief Devuelve el buffer del hilo actual, asignándolo la primera vez.
+
+Los buffers pertenecen a la traza y sobreviven a sus hilos, para poder volcarlos al final. El hilo
+principal recibe `capacidadPrincipal` eventos; los demás, `capacidadSecundario`, y reutilizan el
+buffer de un hilo que ya terminó si hay alguno. Sus eventos siguen en la misma línea de tiempo,
+sin solaparse, porque el hilo anterior ya no escribe.
+
+@return Buffer del hilo que llama.
+*/
+TrazaEventos::BufferHilo* TrazaEventos::bufferPropio()
+{
+    thread_local DuenoBuffer propio;
+    if (propio.buffer) return propio.buffer;
+
+    QThread* hilo = QThread::currentThread();
+    QCoreApplication* aplicacion = QCoreApplication::instance();
+    const bool principal = aplicacion && hilo == aplicacion->thread();
+
+    std::lock_guard<std::mutex> bloqueo(mutexHilos);
+    if (!principal && !libres.empty()) {
+        propio.buffer = libres.back();
+        libres.pop_back();
+        return propio.buffer;
+    }
+
+    auto buffer = std::make_unique<BufferHilo>();
+    buffer->capacidad = principal ? capacidadPrincipal : capacidadSecundario;
+    buffer->eventos.reset(new Evento[buffer->capacidad]);
+    buffer->id = static_cast<int>(hilos.size()) + 1;
+    buffer->nombreHilo = hilo && !hilo->objectName().isEmpty() ? hilo->objectName() : QString();
+    if (buffer->nombreHilo.isEmpty())
+        buffer->nombreHilo = principal ? QStringLiteral("principal") : QString("hilo %1").arg(buffer->id);
+
+    propio.buffer = buffer.get();
+    hilos.push_back(std::move(buffer));
+    return propio.buffer;
+}
+
+/**
+@brief Deja libre el buffer de un hilo que terminó, para que lo use el próximo hilo nuevo.
+
+El buffer del hilo principal no se reutiliza: su capacidad es la grande.
+
+@param buffer Buffer del hilo que termina.
+*/
+void TrazaEventos::liberar(BufferHilo* buffer)
+{
+    std::lock_guard<std::mutex> bloqueo(mutexHilos);
+    if (buffer->capacidad == capacidadSecundario)
+        libres.push_back(buffer);
+}
+
+/**
+@brief Al terminar el hilo dueño, devuelve su buffer a la traza.
+*/
+TrazaEventos::DuenoBuffer::~DuenoBuffer()
+{
+    if (buffer) TrazaEventos::instancia()->liberar(buffer);
+}
+
+/**
+@brief Escribe la traza en formato JSON (Trace Event Format) y la detiene.
+
+Se llama al salir de la aplicación, cuando los demás hilos ya no registran eventos. Por cada hilo
+se escriben sus eventos en orden; si el buffer dio la vuelta, los fines cuyo comienzo se perdió
+se descartan para que la línea de tiempo quede bien anidada.
+
+@throw std::runtime_error Si el archivo no se puede escribir.
+*/
+void TrazaEventos::guardar()
+{
+    if (!activa.exchange(false)) return;
+
+    QFile archivo(ruta);
+    if (!archivo.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate))
+        throw std::runtime_error(("TrazaEventos: no se pudo abrir " + ruta).toStdString());
+
+    QTextStream salida(&archivo);
+    salida << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    std::lock_guard<std::mutex> bloqueo(mutexHilos);
+    bool primero = true;
+    qint64 total = 0;
+
+    auto separar = [&]() {
+        if (!primero) salida << ",\n";
+        primero = false;
+    };
+
+    for (const auto& buffer : hilos) {
+        separar();
+        salida << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->id
+               << ",\"args\":{\"name\":\"" << buffer->nombreHilo << "\"}}";
+
+        const quint64 escritos = buffer->escritos.load(std::memory_order_acquire);
+        const quint64 desde = escritos > buffer->capacidad ? escritos - buffer->capacidad : 0;
+        int profundidad = 0;
+
+        for (quint64 i = desde; i < escritos; ++i) {
+            const Evento& evento = buffer->eventos[i & (buffer->capacidad - 1)];
+
+            if (evento.fase == 'B') ++profundidad;
+            else if (evento.fase == 'E') {
+                if (profundidad == 0) continue;   // Su comienzo ya se sobrescribió
+                --profundidad;
+            }
+
+            separar();
+            salida << "{\"name\":\"";
+            if (evento.clase) salida << evento.clase << "::";
+            salida << evento.nombre << "\",\"cat\":\"" << evento.categoria
+                   << "\",\"ph\":\"" << evento.fase << "\",\"ts\":"
+                   << QString::number(evento.ns / 1000.0, 'f', 3)
+                   << ",\"pid\":1,\"tid\":" << buffer->id;
+            if (evento.fase == 'i') salida << ",\"s\":\"t\"";
+            salida << "}";
+            ++total;
+        }
+    }
+
+    salida << "\n]}\n";
+    salida.flush();
+
+    if (archivo.error() != QFileDevice::NoError)
+        throw std::runtime_error(("TrazaEventos: no se pudo escribir " + ruta).toStdString());
+
+    qDebug() << "Traza guardada en" << ruta << "con" << total << "eventos";
+}
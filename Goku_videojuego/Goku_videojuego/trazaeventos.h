@@ -0,0 +1,111 @@
+#ifndef TRAZAEVENTOS_H
+#define TRAZAEVENTOS_H
+
+#include <QElapsedTimer>
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * Traza de eventos de una sesión de juego en el formato JSON de chrome://tracing y Perfetto.
+ * Cada hilo escribe sus eventos en su propio buffer circular sin bloqueos (un solo escritor por
+ * buffer); al salir se vuelcan todos a un archivo. Si el buffer se llena se conservan los
+ * eventos más recientes. Cuando un hilo termina, su buffer queda libre para el próximo hilo
+ * nuevo, así que los hilos de corta vida (como los de la precarga) no acumulan memoria.
+ * Mientras la traza no se inicia, registrar un evento cuesta una lectura atómica.
+ */
+class TrazaEventos
+{
+public:
+    static constexpr int capacidadPrincipal = 1 << 20;   // Eventos del hilo principal (~40 MB, unos 80 s de juego)
+    static constexpr int capacidadSecundario = 1 << 14;  // Eventos de cada otro hilo (~640 KB)
+
+    static TrazaEventos* instancia();
+
+    void iniciar(const QString& ruta);
+    bool estaActiva() const { return activa.load(std::memory_order_relaxed); }
+
+    // Los textos deben ser literales (o tener vida estática): se guardan como punteros.
+    // Si se indica `clase`, el evento se llama "clase::nombre".
+    void comenzar(const char* nombre, const char* categoria, const char* clase = nullptr);
+    void terminar(const char* nombre, const char* categoria, const char* clase = nullptr);
+    void instante(const char* nombre, const char* categoria);
+
+    void guardar();   // Vuelca la traza al archivo y la detiene
+
+private:
+    TrazaEventos();
+
+    struct Evento {
+        const char* nombre;
+        const char* clase;
+        const char* categoria;
+        qint64 ns;
+        char fase;              // 'B', 'E' o 'i', como en el formato de Chrome
+    };
+
+    struct BufferHilo {
+        int id = 0;
+        QString nombreHilo;
+        quint64 capacidad = 0;                      // Potencia de dos
+        std::unique_ptr<Evento[]> eventos;
+        std::atomic<quint64> escritos{0};
+    };
+
+    // Devuelve el buffer a la traza cuando su hilo termina
+    struct DuenoBuffer {
+        BufferHilo* buffer = nullptr;
+        ~DuenoBuffer();
+    };
+
+    void registrar(char fase, const char* nombre, const char* categoria, const char* clase);
+    BufferHilo* bufferPropio();
+    void liberar(BufferHilo* buffer);
+
+    QElapsedTimer reloj;
+    std::atomic<bool> activa{false};
+    QString ruta;
+
+    std::mutex mutexHilos;                          // Solo al registrar un hilo nuevo y al guardar
+    std::vector<std::unique_ptr<BufferHilo>> hilos;
+    std::vector<BufferHilo*> libres;                // Buffers secundarios de hilos que ya terminaron
+
+    // Bloqueamos copia y asignación
+    TrazaEventos(const TrazaEventos&) = delete;
+    TrazaEventos& operator=(const TrazaEventos&) = delete;
+};
+
+/**
+ * Evento con comienzo y fin: registra el comienzo al construirse y el fin al destruirse.
+ * No se usa directamente sino a través de TRAZA_EVENTO.
+ */
+class EventoTrazado
+{
+public:
+    EventoTrazado(const char* nombre, const char* categoria)
+        : nombre(nombre), categoria(categoria), activo(TrazaEventos::instancia()->estaActiva())
+    {
+        if (activo) TrazaEventos::instancia()->comenzar(nombre, categoria);
+    }
+    ~EventoTrazado()
+    {
+        if (activo) TrazaEventos::instancia()->terminar(nombre, categoria);
+    }
+
+private:
+    const char* nombre;
+    const char* categoria;
+    bool activo;
+};
+
+#define TRAZA_EVENTO_UNIR_(a, b) a##b
+#define TRAZA_EVENTO_UNIR(a, b) TRAZA_EVENTO_UNIR_(a, b)
+
+// Traza el resto del bloque actual como un evento con comienzo y fin
+#define TRAZA_EVENTO(nombre, categoria) \
+    EventoTrazado TRAZA_EVENTO_UNIR(eventoTrazado_, __LINE__)(nombre, categoria)
+
+#endif // TRAZAEVENTOS_H
@@ -1,95 +1,40 @@
 #include "vida.h"
-#include <QGraphicsDropShadowEffect>  // Para aplicar sombra al texto y barra
+#include "rastreomemoria.h"
 #include <QFont>
-#include <QHBoxLayout>
+#include <QFontMetrics>
+#include <QImage>
 #include <QDebug>
 #include <stdexcept>
 
 /**
 @brief Constructor de la clase Vida.
 
-Inicializa un widget que muestra el estado de vida con una etiqueta y una barra gráfica.
+Crea el indicador de vida del HUD: la etiqueta "HEALTH" y la barra de vida, dibujados por la capa del nivel.
 
-@param parent Puntero al widget padre.
+@param capa Capa del HUD donde se dibuja la vida. No puede ser nula.
 
 @details
 
-Crea y configura una etiqueta con el texto "HEALTH" en fuente Arial, tamaño 20 y negrita, con color rojo brillante.
+La etiqueta usa Arial 20 en negrita, en rojo brillante; la barra mide 100 x 14 con borde negro y fondo gris.
 
-Aplica una sombra negra al texto para mejorar el contraste visual.
+Ambos llevan una sombra negra que se calcula al generar la imagen, no en cada frame.
 
-Crea una barra de progreso que representa la vida, con rango de 0 a 100 y valor inicial al máximo.
-
-Configura la barra para que no muestre el porcentaje numérico y le aplica un estilo visual con borde negro, fondo gris y barra verde.
-
-Añade una sombra negra también a la barra de vida.
-
-Organiza horizontalmente el texto y la barra dentro del widget sin márgenes y con separación entre ellos.
-
-Establece el fondo del widget como transparente.
-
-Lanza una excepción si no se puede crear la barra.
+Lanza una excepción si la capa es nula.
 */
-Vida::Vida(QWidget *parent)
-    : QWidget(parent), vidaActual(vidaMaxima) // Se inicia con la vida completa
+Vida::Vida(CapaHud *capa)
+    : ElementoHud(capa), vidaActual(vidaMaxima) // Se inicia con la vida completa
 {
-    texto = new QLabel("HEALTH", this);       // Crear y configurar la etiqueta "HEALTH"
-    QFont fuente("Arial", 20, QFont::Bold);   // Fuente grande y en negrita
-    texto->setFont(fuente);
-    texto->setStyleSheet("color: #FF3333;");  // Color rojo brillante para destacar sobre fondo azul
-
-    // Sombra negra debajo del texto para mejorar contraste
-    auto *sombraTexto = new QGraphicsDropShadowEffect(this);
-    sombraTexto->setOffset(2, 2);              // Desplazamiento de la sombra
-    sombraTexto->setColor(Qt::black);          // Color negro
-    sombraTexto->setBlurRadius(4);             // Difuminado de la sombra
-    texto->setGraphicsEffect(sombraTexto);     // Aplicar sombra al texto
-
-    // Crear y configurar la barra de vida
-    barra = new QProgressBar(this);
-    if (!barra)
-        throw std::runtime_error("Vida: no se pudo crear la barra de vida.");
-
-    barra->setRange(0, vidaMaxima);            // Rango: 0 a 100
-    barra->setValue(vidaActual);               // Valor inicial: vida completa
-    barra->setTextVisible(false);              // Oculta el porcentaje numérico
-    barra->setFixedSize(100, 14);              // Tamaño fijo de la barra
-    actualizarColor();                         // Aplicar color inicial a la barra
-
-    // Estilo visual de la barra (borde negro, fondo gris y chunk verde)
-    barra->setStyleSheet(
-        "QProgressBar {"
-        "  background-color: gray;"
-        "  border: 2px solid black;"           // Borde negro visible
-        "  border-radius: 3px;"                // Bordes redondeados
-        "  padding: 1px;"
-        "}"
-        "QProgressBar::chunk {"
-        "  background-color: #00cc66;"         // Color inicial: verde
-        "}");
-
-    // Sombra negra sobre la barra de vida
-    auto *sombraBarra = new QGraphicsDropShadowEffect(this);
-    sombraBarra->setOffset(2, 2);              // Sombra desplazada
-    sombraBarra->setColor(Qt::black);
-    sombraBarra->setBlurRadius(5);
-    barra->setGraphicsEffect(sombraBarra);     // Aplicar sombra a la barra
-
-    // Disposición horizontal de los elementos
-    QHBoxLayout* layout = new QHBoxLayout(this);
-    layout->setContentsMargins(0, 0, 0, 0);      // Sin márgenes
-    layout->setSpacing(8);                       // Separación entre texto y barra
-    layout->addWidget(texto);                    // Agregar texto al layout
-    layout->addWidget(barra);                    // Agregar barra al layout
-    setLayout(layout);                           // Establecer el layout principal
-    setAttribute(Qt::WA_TranslucentBackground);  // Hace que el fondo del widget sea transparente
+    ETIQUETA_MEMORIA(MemoriaHud);
+    if (!capa)
+        throw std::invalid_argument("Vida: la capa del HUD no puede ser nula.");
+
+    capa->agregar(this);
 }
 
 /**
 @brief Destructor de la clase Vida.
 
-Gestiona la destrucción del widget y sus componentes hijos.
-No requiere acciones explícitas adicionales ya que Qt libera automáticamente los objetos hijos.
+No requiere acciones explícitas: la capa del HUD deja de dibujar la vida sola cuando se destruye.
 */
 Vida::~Vida() {
     //qDebug() << "Destructor de vida llamado";
@@ -106,21 +51,20 @@ Lanza una excepción si se intenta restar una cantidad negativa.
 
 Actualiza el valor interno de vida, asegurando que no sea menor que cero.
 
-Refleja el nuevo valor en la barra gráfica.
-
-Cambia el color de la barra según el nivel de vida actual para indicar estados críticos.
+Si la vida cambió, marca la imagen del HUD para regenerarla en el próximo frame (con el color según el nivel de vida).
 */
 void Vida::restar(int cantidad)
 {
     if (cantidad < 0)
         throw std::invalid_argument("Vida::restar - cantidad negativa no permitida.");
 
+    const int anterior = vidaActual;
     vidaActual -= cantidad;                    // Resta vida
     if (vidaActual < 0)
         vidaActual = 0;                        // Evita valores negativos
 
-    barra->setValue(vidaActual);              // Actualiza visualmente la barra
-    actualizarColor();                        // Cambia color según el nivel de vida
+    if (vidaActual != anterior)
+        invalidar();                           // La barra se vuelve a dibujar en el próximo frame
 }
 
 /**
@@ -130,15 +74,12 @@ void Vida::restar(int cantidad)
 
 Restaura el valor interno de vida a su máximo permitido.
 
-Actualiza visualmente la barra para reflejar la vida completa.
-
-Actualiza el color de la barra para indicar estado saludable.
+Marca la imagen del HUD para regenerarla con la barra llena y verde.
 */
 void Vida::reiniciar()
 {
     vidaActual = vidaMaxima;                  // Restaura vida completa
-    barra->setValue(vidaActual);              // Actualiza visual
-    actualizarColor();                        // Restablece el color verde
+    invalidar();
 }
 
 /**
@@ -152,39 +93,71 @@ int Vida::obtenerVida() const
 }
 
 /**
-@brief Actualiza el color de la barra de vida según el nivel actual de vida.
+@brief Devuelve el color de la barra de vida según el nivel actual de vida.
 
 @details
 
-Si la vida es menor a 40, el color cambia a rojo intenso (indica peligro).
+Si la vida es menor a 40, el color es rojo intenso (indica peligro).
 
-Si la vida está entre 40 y 70, el color cambia a amarillo (advertencia).
+Si la vida está entre 40 y 70, el color es amarillo (advertencia).
 
 Si la vida es mayor o igual a 70, el color es verde (estado saludable).
-
-Aplica el estilo visual correspondiente al widget de la barra con el color dinámico.
 */
-void Vida::actualizarColor()
+QColor Vida::colorBarra() const
 {
-    QString color;
-
     // Determina el color de la barra según el nivel de vida
     if (vidaActual < 40)
-        color = "#ff4c4c"; // Rojo intenso (peligro)
-    else if (vidaActual < 70)
-        color = "#ffd700"; // Amarillo (advertencia)
-    else
-        color = "#00cc66"; // Verde (saludable)
-
-    // Aplica nuevo estilo con el color dinámico
-    barra->setStyleSheet(QString(
-                             "QProgressBar {"
-                             "  background-color: gray;"
-                             "  border: 2px solid black;"
-                             "  border-radius: 3px;"
-                             "  padding: 1px;"
-                             "}"
-                             "QProgressBar::chunk {"
-                             "  background-color: %1;"
-                             "}").arg(color));            // %1 se reemplaza con el color definido arriba
+        return QColor("#ff4c4c"); // Rojo intenso (peligro)
+    if (vidaActual < 70)
+        return QColor("#ffd700"); // Amarillo (advertencia)
+    return QColor("#00cc66");     // Verde (saludable)
+}
+
+/**
+@brief Genera la imagen del indicador de vida.
+
+Se llama solo cuando la vida cambió. Dibuja la etiqueta "HEALTH" y, 8 píxeles a la derecha, la
+barra (fondo gris, relleno del color de `colorBarra()` y borde negro de 2 píxeles), centradas en
+vertical; luego les agrega la sombra que antes ponía `QGraphicsDropShadowEffect` en cada frame.
+
+@return Imagen lista para copiar a la vista.
+*/
+QPixmap Vida::renderizar() const
+{
+    const QFont fuente("Arial", 20, QFont::Bold);   // Fuente grande y en negrita
+    const QFontMetrics metricas(fuente);
+    const QString texto = "HEALTH";
+
+    const int anchoTexto = metricas.horizontalAdvance(texto);
+    const int separacion = 8;
+    const QSize barra(100, 14);
+    const int alto = qMax(metricas.height(), barra.height());
+
+    QImage contenido(anchoTexto + separacion + barra.width(), alto, QImage::Format_ARGB32_Premultiplied);
+    contenido.fill(Qt::transparent);
+
+    QPainter painter(&contenido);
+    painter.setRenderHint(QPainter::Antialiasing, true);
+
+    // Etiqueta en rojo brillante para destacar sobre el cielo
+    painter.setFont(fuente);
+    painter.setPen(QColor("#FF3333"));
+    painter.drawText(QRect(0, 0, anchoTexto, alto), Qt::AlignVCenter | Qt::AlignLeft, texto);
+
+    // Barra: borde negro, fondo gris y relleno proporcional a la vida
+    const QRectF marco(anchoTexto + separacion + 1, (alto - barra.height()) / 2 + 1,
+                       barra.width() - 2, barra.height() - 2);
+    painter.setPen(QPen(Qt::black, 2));
+    painter.setBrush(Qt::gray);
+    painter.drawRoundedRect(marco, 3, 3);
+
+    const qreal anchoRelleno = (marco.width() - 4) * vidaActual / vidaMaxima;
+    if (anchoRelleno > 0) {
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(colorBarra());
+        painter.drawRect(QRectF(marco.left() + 2, marco.top() + 2, anchoRelleno, marco.height() - 4));
+    }
+    painter.end();
+
+    return QPixmap::fromImage(conSombra(contenido, QPoint(2, 2), 2));
 }
@@ -1,29 +1,29 @@
 #ifndef VIDA_H
 #define VIDA_H
 
-#include <QWidget>
-#include <QProgressBar>
-#include <QLabel>
+#include <QColor>
+#include "capahud.h"
 
-class Vida : public QWidget
+class Vida : public ElementoHud
 {
     Q_OBJECT
 
 public:
-    explicit Vida(QWidget *parent = nullptr);
+    explicit Vida(CapaHud *capa);
     virtual ~Vida();
 
     void restar(int cantidad);
     void reiniciar();
     int obtenerVida() const;
 
+protected:
+    QPixmap renderizar() const override;   // Texto "HEALTH" y barra, con sombra
+
 private:
     const int vidaMaxima = 100;
     int vidaActual = 100;
-    QLabel* texto;
-    QProgressBar* barra;
 
-    void actualizarColor();
+    QColor colorBarra() const;
 };
 
 #endif // VIDA_H
@@ -0,0 +1,301 @@
+#include "vistajuego.h"
+#include "perfilador.h"
+#include "trazaeventos.h"
+#include "rastreomemoria.h"
+#include "fondoparalaje.h"
+#include "capahud.h"
+#include "buclejuego.h"
+#include <QFontDatabase>
+#include <QFontMetrics>
+#include <QPolygonF>
+#include <QStringList>
+#include <stdexcept>  // Excepciones estándar
+
+/**
+@brief Constructor de la vista del juego.
+
+@param parent Widget padre opcional.
+*/
+VistaJuego::VistaJuego(QWidget *parent)
+    : QGraphicsView(parent)
+{
+    // En los modos parciales nadie más pide repintar el panel del perfilador
+    connect(BucleJuego::instancia(), &BucleJuego::frameTerminado, this, [this]() {
+        if (mostrarPerfil && modo != RenderCompleto)
+            viewport()->update(zonaPerfil);
+    });
+}
+
+/**
+@brief Configura cómo se repinta la vista.
+
+- `RenderCompleto`: `NoViewportUpdate` (el bucle repinta toda la ventana en cada frame), con
+  antialiasing y suavizado global y sin caché de fondo.
+- `RenderParches`: `MinimalViewportUpdate`, solo las regiones sucias. Al desplazarse la cámara la
+  vista mueve los píxeles ya pintados y dibuja solo la franja que entra; el fondo se guarda en
+  caché (`CacheBackground`). Sin antialiasing global: los items que se escalan piden su propio
+  suavizado con `setTransformationMode`.
+- `RenderRectangulo`: como `RenderParches`, pero repinta el rectángulo que envuelve lo sucio.
+
+En los modos parciales el pintor no guarda su estado entre items (`DontSavePainterState`) ni se
+agranda cada zona sucia por el antialiasing (`DontAdjustForAntialiasing`).
+
+@param modo Modo de repintado.
+*/
+void VistaJuego::setModoRender(ModoRender modo)
+{
+    this->modo = modo;
+
+    if (modo == RenderCompleto) {
+        setViewportUpdateMode(QGraphicsView::NoViewportUpdate);
+        setRenderHints(QPainter::Antialiasing);
+        setCacheMode(QGraphicsView::CacheNone);
+        setOptimizationFlags(QGraphicsView::OptimizationFlags());
+    } else {
+        setViewportUpdateMode(modo == RenderParches ? QGraphicsView::MinimalViewportUpdate
+                                                    : QGraphicsView::BoundingRectViewportUpdate);
+        setRenderHints(QPainter::RenderHints());
+        setCacheMode(QGraphicsView::CacheBackground);
+        setOptimizationFlags(QGraphicsView::DontSavePainterState | QGraphicsView::DontAdjustForAntialiasing);
+    }
+
+    resetCachedContent();
+    viewport()->update();
+}
+
+/**
+@brief Convierte el nombre de un modo (como llega de `--render`) en su valor.
+
+@param nombre "completo", "parches" o "rectangulo" (sin distinguir mayúsculas).
+@return El modo correspondiente.
+
+@throw std::invalid_argument Si el nombre no corresponde a ningún modo.
+*/
+VistaJuego::ModoRender VistaJuego::modoRender(const QString& nombre)
+{
+    const QString n = nombre.trimmed().toLower();
+    if (n == "completo")   return RenderCompleto;
+    if (n == "parches")    return RenderParches;
+    if (n == "rectangulo") return RenderRectangulo;
+
+    throw std::invalid_argument("VistaJuego: modo de render desconocido (completo, parches o rectangulo).");
+}
+
+/**
+@brief Muestra u oculta el panel del perfilador y repinta la vista.
+
+@param visible `true` para mostrar el panel.
+*/
+void VistaJuego::setPerfilVisible(bool visible)
+{
+    mostrarPerfil = visible;
+    viewport()->update();
+}
+
+/**
+@brief Atiende F3 (panel del perfilador) y deja pasar el resto de las teclas a la escena.
+
+@param event Evento de teclado.
+*/
+void VistaJuego::keyPressEvent(QKeyEvent *event)
+{
+    if (event->key() == Qt::Key_F3 && !event->isAutoRepeat()) {
+        setPerfilVisible(!mostrarPerfil);
+        return;
+    }
+
+    QGraphicsView::keyPressEvent(event);
+}
+
+/**
+@brief Pinta la escena midiendo el tiempo en la zona `pintarEscena` del perfilador.
+
+También cuenta los píxeles de la región repintada (promedio móvil), que el panel de F3 muestra
+para comparar los modos de render.
+
+@param event Evento de pintura.
+*/
+void VistaJuego::paintEvent(QPaintEvent *event)
+{
+    ZONA_PERFIL("pintarEscena");
+    TRAZA_EVENTO("VistaJuego::paintEvent", "pintado");
+
+    qint64 pixeles = 0;
+    for (const QRect& r : event->region())
+        pixeles += static_cast<qint64>(r.width()) * r.height();
+    pixelesPorFrame = 0.9 * pixelesPorFrame + 0.1 * pixeles;
+
+    QGraphicsView::paintEvent(event);
+}
+
+/**
+@brief Desplaza el contenido y repara lo que no puede desplazarse.
+
+En los modos parciales, Qt mueve los píxeles ya pintados y solo dibuja la franja que entra.
+Eso deja mal tres cosas, que aquí se marcan para repintar:
+
+- Las franjas del fondo que avanzan a otro ritmo que el mundo (`FondoParalaje::zonasMoviles`),
+  invalidadas también en la caché del fondo.
+- El HUD y el panel del perfilador, que están fijos en la ventana.
+
+@param dx Desplazamiento horizontal en píxeles.
+@param dy Desplazamiento vertical en píxeles.
+*/
+void VistaJuego::scrollContentsBy(int dx, int dy)
+{
+    QGraphicsView::scrollContentsBy(dx, dy);
+
+    // Con NoViewportUpdate la ventana se repinta entera de todos modos
+    if (viewportUpdateMode() == QGraphicsView::NoViewportUpdate) return;
+
+    const QRectF visible = mapToScene(viewport()->rect()).boundingRect();
+    if (FondoParalaje* fondo = FondoParalaje::deEscena(scene())) {
+        for (const QRectF& zona : fondo->zonasMoviles(visible))
+            invalidateScene(zona, QGraphicsScene::BackgroundLayer);
+    }
+
+    if (CapaHud* hud = CapaHud::deEscena(scene()))
+        viewport()->update(hud->zona());
+
+    if (mostrarPerfil)
+        viewport()->update(zonaPerfil);
+}
+
+/**
+@brief Dibuja el fondo por capas del nivel, si la escena tiene uno.
+
+Sin `FondoParalaje` se usa el fondo normal de la escena (el del Nivel 2 sigue siendo un item).
+
+@param painter Pintor de la vista, en coordenadas de escena.
+@param rect Zona expuesta en coordenadas de escena.
+*/
+void VistaJuego::drawBackground(QPainter *painter, const QRectF &rect)
+{
+    if (FondoParalaje* fondo = FondoParalaje::deEscena(scene())) {
+        fondo->dibujar(painter, rect);
+        return;
+    }
+
+    QGraphicsView::drawBackground(painter, rect);
+}
+
+/**
+@brief Dibuja el HUD del nivel y, si está activo, el panel del perfilador encima de la escena.
+
+Ambos quedan fijos en la ventana: se dibujan en coordenadas del viewport. El HUD copia las
+imágenes ya generadas de la vida y el progreso; solo las regenera cuando cambian sus valores.
+
+@param painter Pintor de la vista, en coordenadas de escena.
+@param rect Zona expuesta (no se usa: el HUD y el panel se dibujan siempre completos).
+*/
+void VistaJuego::drawForeground(QPainter *painter, const QRectF &rect)
+{
+    QGraphicsView::drawForeground(painter, rect);
+
+    CapaHud* hud = CapaHud::deEscena(scene());
+    if (!hud && !mostrarPerfil) return;
+
+    painter->save();
+    painter->resetTransform();   // El HUD y el panel quedan fijos en la ventana
+
+    if (hud) hud->dibujar(painter);
+    if (mostrarPerfil) dibujarPerfil(painter);
+
+    painter->restore();
+}
+
+/**
+@brief Dibuja el panel del perfilador en la esquina superior derecha de la vista.
+
+Muestra la duración del último frame y el promedio, los percentiles 50, 95 y 99 de la ventana,
+un gráfico de la duración de cada frame (la línea marca 16.7 ms), las reservas de memoria por
+frame y el promedio por frame de cada zona. Las zonas son inclusivas: una zona que llama a otra también cuenta su tiempo.
+
+@param painter Pintor en coordenadas del viewport.
+*/
+void VistaJuego::dibujarPerfil(QPainter *painter)
+{
+    const Perfilador* perfilador = Perfilador::instancia();
+    const Perfilador::Estadisticas e = perfilador->estadisticas();
+
+    QStringList lineas;
+    lineas << QString("frame %1 ms  prom %2 ms (%3 fps)")
+                  .arg(e.ultimo, 0, 'f', 1)
+                  .arg(e.promedio, 0, 'f', 1)
+                  .arg(e.promedio > 0 ? 1000.0 / e.promedio : 0.0, 0, 'f', 0);
+    lineas << QString("p50 %1  p95 %2  p99 %3  max %4 ms")
+                  .arg(e.p50, 0, 'f', 1)
+                  .arg(e.p95, 0, 'f', 1)
+                  .arg(e.p99, 0, 'f', 1)
+                  .arg(e.maximo, 0, 'f', 1);
+
+    const double pixelesVentana = qMax(1, viewport()->width() * viewport()->height());
+    lineas << QString("render %1: %2 kpx/frame (%3%)")
+                  .arg(modo == RenderCompleto ? "completo" : modo == RenderParches ? "parches" : "rectangulo")
+                  .arg(pixelesPorFrame / 1000.0, 0, 'f', 0)
+                  .arg(100.0 * pixelesPorFrame / pixelesVentana, 0, 'f', 0);
+
+    lineas << QString("memoria %1 KB vivos  %2 reservas/frame (max %3)")
+                  .arg(RastreoMemoria::bytesVivos() / 1024)
+                  .arg(RastreoMemoria::ultimoFrame())
+                  .arg(RastreoMemoria::maximoPorFrame());
+
+#ifdef PERFILADOR_ACTIVO
+    for (int i = 0; i < perfilador->numZonas(); ++i) {
+        lineas << QString("%1 %2 ms")
+                      .arg(QString::fromLatin1(perfilador->nombreZona(i)), -18)
+                      .arg(perfilador->msZona(i), 6, 'f', 3);
+    }
+#else
+    lineas << QString("zonas desactivadas (release)");
+#endif
+
+    const QFont fuente = QFontDatabase::systemFont(QFontDatabase::FixedFont);
+    const QFontMetrics metricas(fuente);
+    const int margen = 8;
+    const int altoLinea = metricas.height();
+    const int altoGrafico = 60;
+
+    int ancho = Perfilador::ventanaFrames;
+    for (const QString& linea : lineas)
+        ancho = qMax(ancho, metricas.horizontalAdvance(linea));
+
+    const QRect panel(viewport()->width() - ancho - 3 * margen, margen,
+                      ancho + 2 * margen, lineas.size() * altoLinea + altoGrafico + 3 * margen);
+
+    zonaPerfil = panel;
+
+    painter->setRenderHint(QPainter::Antialiasing, false);
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(QColor(0, 0, 0, 170));
+    painter->drawRect(panel);
+
+    painter->setFont(fuente);
+    painter->setPen(Qt::white);
+    int y = panel.top() + margen + metricas.ascent();
+    for (const QString& linea : lineas) {
+        painter->drawText(panel.left() + margen, y, linea);
+        y += altoLinea;
+    }
+
+    // Gráfico de la ventana: un punto por frame, 33 ms llenan el alto
+    const QRect grafico(panel.left() + margen, panel.bottom() - margen - altoGrafico,
+                        Perfilador::ventanaFrames, altoGrafico);
+    const double escala = altoGrafico / 33.3;
+
+    painter->setPen(QColor(255, 255, 255, 80));
+    const int yObjetivo = grafico.bottom() - static_cast<int>(16.7 * escala);
+    painter->drawLine(grafico.left(), yObjetivo, grafico.right(), yObjetivo);
+
+    float historial[Perfilador::ventanaFrames];
+    const int cantidad = perfilador->historial(historial, Perfilador::ventanaFrames);
+    QPolygonF curva;
+    curva.reserve(cantidad);
+    for (int i = 0; i < cantidad; ++i) {
+        const double alto = qMin<double>(historial[i] * escala, altoGrafico);
+        curva << QPointF(grafico.left() + i, grafico.bottom() - alto);
+    }
+
+    painter->setPen(QColor(120, 255, 120));
+    painter->drawPolyline(curva);
+}
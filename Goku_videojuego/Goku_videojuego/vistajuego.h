@@ -0,0 +1,52 @@
+#ifndef VISTAJUEGO_H
+#define VISTAJUEGO_H
+
+#include <QGraphicsView>
+#include <QKeyEvent>
+#include <QPaintEvent>
+#include <QPainter>
+
+/**
+ * Vista del juego.
+ * Es un QGraphicsView que mide cuánto tarda en pintar la escena y que, con F3, dibuja encima
+ * el panel del Perfilador: duración de los frames, percentiles y milisegundos por zona.
+ * Debajo de los items pinta el FondoParalaje del nivel y encima su CapaHud, si la escena los tiene.
+ */
+class VistaJuego : public QGraphicsView
+{
+    Q_OBJECT
+
+public:
+    // Cómo se repinta la ventana en cada frame
+    enum ModoRender {
+        RenderCompleto,     // Toda la ventana por frame, con antialiasing (el modo original)
+        RenderParches,      // Solo lo sucio; el scroll desplaza los píxeles y pinta la franja nueva
+        RenderRectangulo    // Un único rectángulo que envuelve todo lo sucio
+    };
+
+    explicit VistaJuego(QWidget *parent = nullptr);
+
+    void setModoRender(ModoRender modo);
+    ModoRender getModoRender() const { return modo; }
+    static ModoRender modoRender(const QString& nombre);   // "completo", "parches" o "rectangulo"
+
+    void setPerfilVisible(bool visible);
+    bool perfilVisible() const { return mostrarPerfil; }
+
+protected:
+    void keyPressEvent(QKeyEvent *event) override;       // F3 muestra u oculta el perfilador
+    void paintEvent(QPaintEvent *event) override;
+    void scrollContentsBy(int dx, int dy) override;      // Repara lo que no puede desplazarse
+    void drawBackground(QPainter *painter, const QRectF &rect) override;   // Fondo por capas del nivel
+    void drawForeground(QPainter *painter, const QRectF &rect) override;
+
+private:
+    void dibujarPerfil(QPainter *painter);
+
+    bool mostrarPerfil = false;
+    ModoRender modo = RenderCompleto;
+    QRect zonaPerfil;                  // Último rectángulo del panel, en el viewport
+    double pixelesPorFrame = 0;        // Promedio móvil de píxeles repintados
+};
+
+#endif // VISTAJUEGO_H